@@ -13968,277 +13968,6 @@ extern "C" {
 }
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
-pub struct VertexBuffer {
-    pub elementsCount: ::std::os::raw::c_int,
-    pub vCounter: ::std::os::raw::c_int,
-    pub tcCounter: ::std::os::raw::c_int,
-    pub cCounter: ::std::os::raw::c_int,
-    pub vertices: *mut f32,
-    pub texcoords: *mut f32,
-    pub colors: *mut ::std::os::raw::c_uchar,
-    pub indices: *mut ::std::os::raw::c_uint,
-    pub vaoId: ::std::os::raw::c_uint,
-    pub vboId: [::std::os::raw::c_uint; 4usize],
-}
-#[test]
-fn bindgen_test_layout_VertexBuffer() {
-    assert_eq!(
-        ::std::mem::size_of::<VertexBuffer>(),
-        72usize,
-        concat!("Size of: ", stringify!(VertexBuffer))
-    );
-    assert_eq!(
-        ::std::mem::align_of::<VertexBuffer>(),
-        8usize,
-        concat!("Alignment of ", stringify!(VertexBuffer))
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).elementsCount as *const _ as usize },
-        0usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(elementsCount)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).vCounter as *const _ as usize },
-        4usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(vCounter)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).tcCounter as *const _ as usize },
-        8usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(tcCounter)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).cCounter as *const _ as usize },
-        12usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(cCounter)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).vertices as *const _ as usize },
-        16usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(vertices)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).texcoords as *const _ as usize },
-        24usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(texcoords)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).colors as *const _ as usize },
-        32usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(colors)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).indices as *const _ as usize },
-        40usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(indices)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).vaoId as *const _ as usize },
-        48usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(vaoId)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<VertexBuffer>())).vboId as *const _ as usize },
-        52usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(VertexBuffer),
-            "::",
-            stringify!(vboId)
-        )
-    );
-}
-#[repr(C)]
-#[derive(Debug, Copy, Clone)]
-pub struct DrawCall {
-    pub mode: ::std::os::raw::c_int,
-    pub vertexCount: ::std::os::raw::c_int,
-    pub vertexAlignment: ::std::os::raw::c_int,
-    pub textureId: ::std::os::raw::c_uint,
-}
-#[test]
-fn bindgen_test_layout_DrawCall() {
-    assert_eq!(
-        ::std::mem::size_of::<DrawCall>(),
-        16usize,
-        concat!("Size of: ", stringify!(DrawCall))
-    );
-    assert_eq!(
-        ::std::mem::align_of::<DrawCall>(),
-        4usize,
-        concat!("Alignment of ", stringify!(DrawCall))
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<DrawCall>())).mode as *const _ as usize },
-        0usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(DrawCall),
-            "::",
-            stringify!(mode)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<DrawCall>())).vertexCount as *const _ as usize },
-        4usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(DrawCall),
-            "::",
-            stringify!(vertexCount)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<DrawCall>())).vertexAlignment as *const _ as usize },
-        8usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(DrawCall),
-            "::",
-            stringify!(vertexAlignment)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<DrawCall>())).textureId as *const _ as usize },
-        12usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(DrawCall),
-            "::",
-            stringify!(textureId)
-        )
-    );
-}
-#[repr(C)]
-#[derive(Debug, Copy, Clone)]
-pub struct RenderBatch {
-    pub buffersCount: ::std::os::raw::c_int,
-    pub currentBuffer: ::std::os::raw::c_int,
-    pub vertexBuffer: *mut VertexBuffer,
-    pub draws: *mut DrawCall,
-    pub drawsCounter: ::std::os::raw::c_int,
-    pub currentDepth: f32,
-}
-#[test]
-fn bindgen_test_layout_RenderBatch() {
-    assert_eq!(
-        ::std::mem::size_of::<RenderBatch>(),
-        32usize,
-        concat!("Size of: ", stringify!(RenderBatch))
-    );
-    assert_eq!(
-        ::std::mem::align_of::<RenderBatch>(),
-        8usize,
-        concat!("Alignment of ", stringify!(RenderBatch))
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).buffersCount as *const _ as usize },
-        0usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(buffersCount)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).currentBuffer as *const _ as usize },
-        4usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(currentBuffer)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).vertexBuffer as *const _ as usize },
-        8usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(vertexBuffer)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).draws as *const _ as usize },
-        16usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(draws)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).drawsCounter as *const _ as usize },
-        24usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(drawsCounter)
-        )
-    );
-    assert_eq!(
-        unsafe { &(*(::std::ptr::null::<RenderBatch>())).currentDepth as *const _ as usize },
-        28usize,
-        concat!(
-            "Offset of field: ",
-            stringify!(RenderBatch),
-            "::",
-            stringify!(currentDepth)
-        )
-    );
-}
-#[repr(C)]
-#[derive(Debug, Copy, Clone)]
 pub struct VrStereoConfig {
     pub distortionShader: Shader,
     pub eyesProjection: [Matrix; 2usize],
@@ -72,6 +72,10 @@ fn build_with_cmake(src_path: &str) {
     // This seems redundant, but I felt it was needed incase raylib changes it's default
     #[cfg(not(feature = "wayland"))]
     builder.define("USE_WAYLAND", "OFF");
+
+    // rlgl records OpenGL calls instead of issuing them, see rlgl.h RLGL_NULL_BACKEND
+    #[cfg(feature = "null_backend")]
+    builder.cflag("-DRLGL_NULL_BACKEND");
     
     // Scope implementing flags for forcing OpenGL version
     // See all possible flags at https://github.com/raysan5/raylib/wiki/CMake-Build-Options
@@ -274,6 +278,10 @@ fn cp_raylib() -> String {
         &out.to_string_lossy()
     ));
 
+    // rlgl.h carries raylib-rs changes (render batch upload modes), overlay it on the raylib source
+    fs::copy("rlgl.h", out.join("raylib").join("src").join("rlgl.h"))
+        .expect("failed to overlay rlgl.h on raylib source");
+
     out.join("raylib").to_string_lossy().to_string()
 }
 
@@ -126,6 +126,11 @@
     #define GRAPHICS_API_OPENGL_33
 #endif
 
+// Null backend replaces GLAD loaded OpenGL functions, no other API is supported
+#if defined(RLGL_NULL_BACKEND) && (!defined(GRAPHICS_API_OPENGL_33) || defined(__APPLE__))
+    #error "RLGL_NULL_BACKEND requires GRAPHICS_API_OPENGL_33 (GLAD functions loading)"
+#endif
+
 #define SUPPORT_RENDER_TEXTURES_HINT
 
 //----------------------------------------------------------------------------------
@@ -155,6 +160,16 @@
     #define MAX_BATCH_ACTIVE_TEXTURES        4      // Maximum number of additional textures that can be activated on batch drawing (SetShaderValueTexture())
 #endif
 
+// GL state cache
+#ifndef MAX_STATE_CACHE_TEXTURE_SLOTS
+    #define MAX_STATE_CACHE_TEXTURE_SLOTS   16      // Maximum texture slots tracked by GL state cache (binds on other slots are always issued)
+#endif
+
+// Screen captures
+#ifndef MAX_SCREEN_CAPTURE_BUFFERS
+    #define MAX_SCREEN_CAPTURE_BUFFERS       4      // Maximum pixel buffer objects kept for reuse by released screen captures
+#endif
+
 // Internal Matrix stack
 #ifndef MAX_MATRIX_STACK_SIZE
     #define MAX_MATRIX_STACK_SIZE           32      // Maximum size of Matrix stack
@@ -243,6 +258,13 @@ typedef enum {
     RL_ATTACHMENT_RENDERBUFFER = 200,
 } FramebufferAttachTextureType;
 
+// Interleaved batch vertex (position + texcoord + color), 24 bytes
+typedef struct BatchVertex {
+    float x, y, z;              // Vertex position (shader-location = 0)
+    float u, v;                 // Vertex texture coordinates (shader-location = 1)
+    unsigned char r, g, b, a;   // Vertex color (shader-location = 3)
+} BatchVertex;
+
 // Dynamic vertex buffers (position + texcoords + colors + indices arrays)
 typedef struct VertexBuffer {
     int elementsCount;          // Number of elements in the buffer (QUADS)
@@ -254,6 +276,7 @@ typedef struct VertexBuffer {
     float *vertices;            // Vertex position (XYZ - 3 components per vertex) (shader-location = 0)
     float *texcoords;           // Vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
     unsigned char *colors;      // Vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
+    BatchVertex *interleaved;   // Vertex data interleaved, replaces vertices, texcoords and colors (RL_BATCH_LAYOUT_INTERLEAVED)
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
     unsigned int *indices;      // Vertex indices (in case vertex data comes indexed) (6 indices per quad)
 #endif
@@ -262,6 +285,7 @@ typedef struct VertexBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[4];      // OpenGL Vertex Buffer Objects id (4 types of vertex data)
+    void *syncFence;            // OpenGL sync object, signaled once GPU is done reading this buffer (RL_BATCH_UPLOAD_PERSISTENT)
 } VertexBuffer;
 
 // Draw call type
@@ -275,11 +299,25 @@ typedef struct DrawCall {
     //unsigned int vaoId;       // Vertex array id to be used on the draw -> Using RLGL.currentBatch->vertexBuffer.vaoId
     //unsigned int shaderId;    // Shader id to be used on the draw -> Using RLGL.currentShader.id
     unsigned int textureId;     // Texture id to be used on the draw -> Use to create new draw call if changes
+    int layer;                  // Draw layer, lower layers first when batch is sorted -> Use to create new draw call if changes
 
     //Matrix projection;        // Projection matrix for this draw -> Using RLGL.projection by default
     //Matrix modelview;         // Modelview matrix for this draw -> Using RLGL.modelview by default
 } DrawCall;
 
+// Render batch vertex data upload modes
+typedef enum {
+    RL_BATCH_UPLOAD_SUBDATA = 0,    // Copy CPU arrays into VBOs with glBufferSubData() on every draw (default)
+    RL_BATCH_UPLOAD_ORPHAN,         // Orphan VBOs storage with glBufferData(NULL) before copying, avoids waiting on GPU
+    RL_BATCH_UPLOAD_PERSISTENT      // Write vertex data directly into persistently mapped VBOs, fenced per buffer (GL_ARB_buffer_storage)
+} RenderBatchUploadMode;
+
+// Render batch vertex data layouts
+typedef enum {
+    RL_BATCH_LAYOUT_SEPARATE = 0,   // One array, counter and VBO per vertex attribute (default)
+    RL_BATCH_LAYOUT_INTERLEAVED     // One BatchVertex array, counter and VBO for all vertex attributes
+} RenderBatchLayout;
+
 // RenderBatch type
 typedef struct RenderBatch {
     int buffersCount;           // Number of vertex buffers (multi-buffering support)
@@ -289,8 +327,73 @@ typedef struct RenderBatch {
     DrawCall *draws;            // Draw calls array, depends on textureId
     int drawsCounter;           // Draw calls counter
     float currentDepth;         // Current depth value for next draw
+    int uploadMode;             // Vertex data upload mode (RenderBatchUploadMode)
+    int layout;                 // Vertex data layout (RenderBatchLayout)
 } RenderBatch;
 
+// Render statistics, accumulated since last rlResetRenderStats() (usually one frame)
+typedef struct RenderStats {
+    unsigned int flushes;               // Render batch draws with vertex data (rlDrawRenderBatch())
+    unsigned int overflowFlushes;       // Render batch draws forced by full vertex buffer or draw calls limit
+    unsigned int drawCalls;             // Draw calls issued (render batches, vertex arrays, instanced)
+    unsigned int vertices;              // Vertex drawn (instances included)
+    unsigned int bytesUploaded;         // Vertex and instance data uploaded to GPU buffers (bytes)
+    unsigned int stateCallsIssued;      // GL state calls issued
+    unsigned int stateCallsElided;      // GL state calls skipped by state cache
+} RenderStats;
+
+// Sprite instance data (instanced sprites drawing), 48 bytes
+// NOTE: Same parameters as DrawTexturePro(), source rectangle is defined in pixels
+typedef struct SpriteInstance {
+    float dest[4];              // Destination rectangle: x, y, width, height
+    float source[4];            // Source rectangle: x, y, width, height (negative width/height to flip)
+    float origin[2];            // Rotation origin, relative to destination rectangle
+    float rotation;             // Rotation in degrees
+    unsigned char color[4];     // Tint color
+} SpriteInstance;
+
+// Command list type, render batch draw calls recorded once to be drawn many times
+// NOTE: QUADS are recorded as TRIANGLES, all vertex data is drawn from a single static VBO
+typedef struct CommandList {
+    int vertexCount;            // Number of vertex recorded
+    int drawsCount;             // Number of draw calls recorded
+    DrawCall *draws;            // Draw calls, vertex data of each one follows the previous one
+    unsigned int vaoId;         // OpenGL Vertex Array Object id
+    unsigned int vboId;         // OpenGL Vertex Buffer Object id (interleaved BatchVertex data)
+} CommandList;
+
+// Screen capture type, screen pixels read asynchronously into a pixel buffer object
+// NOTE: Without pixel buffer objects support (OpenGL 1.1, ES2), pixels are read on capture
+typedef struct ScreenCapture {
+    unsigned int pboId;         // OpenGL Pixel Buffer Object id (GL_PIXEL_PACK_BUFFER), 0 if pixels read on capture
+    void *fence;                // Sync object signaled once pixels are copied into the pixel buffer
+    unsigned char *pixels;      // Pixels read on capture (no pixel buffer objects support)
+    int width;                  // Captured width
+    int height;                 // Captured height
+} ScreenCapture;
+
+#if defined(RLGL_NULL_BACKEND)
+// Null backend recorded command types
+typedef enum {
+    RL_NULL_COMMAND_FLUSH = 0,          // Render batch draw with vertex data (rlDrawRenderBatch())
+    RL_NULL_COMMAND_DRAW,               // glDrawArrays(), glDrawElements()
+    RL_NULL_COMMAND_DRAW_INSTANCED,     // glDrawArraysInstanced(), glDrawElementsInstanced()
+    RL_NULL_COMMAND_BUFFER_UPLOAD,      // glBufferData() with data, glBufferSubData()
+    RL_NULL_COMMAND_TEXTURE_UPLOAD,     // glTexImage2D() with data, glTexSubImage2D(), glCompressedTexImage2D()
+    RL_NULL_COMMAND_CLEAR               // glClear()
+} NullCommandType;
+
+// Null backend recorded command, 24 bytes
+typedef struct NullCommand {
+    int type;                   // Command type (NullCommandType)
+    unsigned int mode;          // Primitive mode (draws), buffer/texture target (uploads), buffers mask (clear)
+    unsigned int id;            // Texture bound to slot 0 (draws), buffer or texture id (uploads)
+    int count;                  // Vertex or index count (draws, flushes), pixels count (texture uploads)
+    int instances;              // Instances count (draws)
+    int size;                   // Data size in bytes (uploads)
+} NullCommand;
+#endif
+
 // Shader attribute data types
 typedef enum {
     SHADER_ATTRIB_FLOAT = 0,
@@ -475,6 +578,7 @@ RLAPI void rlNormal3f(float x, float y, float z);     // Define one vertex (norm
 RLAPI void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a);  // Define one vertex (color) - 4 byte
 RLAPI void rlColor3f(float x, float y, float z);          // Define one vertex (color) - 3 float
 RLAPI void rlColor4f(float x, float y, float z, float w); // Define one vertex (color) - 4 float
+RLAPI void rlVertexBatch(const BatchVertex *vertices, int count);    // Define multiple vertex at once (position, texcoord, color), i.e. a full quad
 
 //------------------------------------------------------------------------------------
 // Functions Declaration - OpenGL style functions (common to 1.1, 3.3+, ES2)
@@ -549,6 +653,14 @@ RLAPI int rlGetVersion(void);                         // Returns current OpenGL
 RLAPI int rlGetFramebufferWidth(void);                // Get default framebuffer width
 RLAPI int rlGetFramebufferHeight(void);               // Get default framebuffer height
 
+#if defined(RLGL_NULL_BACKEND)
+// Null backend: OpenGL calls are recorded into a commands log, no GPU or display required
+// NOTE: rlLoadExtensions() ignores provided loader and loads null backend functions
+RLAPI void *rlNullGetProcAddress(const char *name);                 // Get null backend OpenGL function by name
+RLAPI const NullCommand *rlNullGetCommands(int *count);             // Get commands recorded since last clear
+RLAPI void rlNullClearCommands(void);                               // Clear recorded commands
+#endif
+
 RLAPI Shader rlGetShaderDefault(void);                // Get default shader
 RLAPI Texture2D rlGetTextureDefault(void);            // Get default texture
 
@@ -556,11 +668,28 @@ RLAPI Texture2D rlGetTextureDefault(void);            // Get default texture
 // NOTE: rlgl provides a default render batch to behave like OpenGL 1.1 immediate mode
 // but this render batch API is exposed in case of custom batches are required
 RLAPI RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements);  // Load a render batch system
+RLAPI RenderBatch rlLoadRenderBatchEx(int numBuffers, int bufferElements, int uploadMode, int layout);   // Load a render batch system with upload mode (RenderBatchUploadMode) and layout (RenderBatchLayout)
 RLAPI void rlUnloadRenderBatch(RenderBatch batch);                        // Unload render batch system
 RLAPI void rlDrawRenderBatch(RenderBatch *batch);                         // Draw render batch data (Update->Draw->Reset)
 RLAPI void rlSetRenderBatchActive(RenderBatch *batch);                    // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);                                 // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);                           // Check internal buffer overflow for a given number of vertex
+RLAPI int rlGetRenderBatchElements(void);                                 // Get active render batch elements (quads) per vertex buffer
+RLAPI float rlGetRenderBatchDepth(void);                                  // Get active render batch depth for next draw
+RLAPI void rlEnableSortedBatch(void);                                     // Enable render batch draw calls sorting by layer, texture and mode
+RLAPI void rlDisableSortedBatch(void);                                    // Disable render batch draw calls sorting
+RLAPI void rlSetDrawLayer(int layer);                                     // Set draw layer for next draws (sorted batch)
+RLAPI unsigned int rlGetDrawCallsCount(void);                             // Get number of draw calls issued since rlglInit()
+RLAPI unsigned int rlGetStateCallsIssued(void);        // Get number of GL state calls issued (textures, shaders, capabilities, blending)
+RLAPI unsigned int rlGetStateCallsElided(void);        // Get number of redundant GL state calls skipped by state cache
+RLAPI void rlResetStateCache(void);                    // Reset GL state cache, required after changing GL state outside rlgl
+RLAPI RenderStats rlGetRenderStats(void);              // Get render statistics since last reset (current frame)
+RLAPI RenderStats rlGetRenderStatsPrevious(void);      // Get render statistics before last reset (previous frame)
+RLAPI void rlResetRenderStats(void);                   // Reset render statistics, current ones kept as previous (call on frame start)
+RLAPI void rlBeginCommandList(void);                   // Begin recording render batch draw calls, nothing is drawn until list is drawn
+RLAPI void rlEndCommandList(CommandList *list);        // End recording, recorded draw calls replace list content (uploaded once)
+RLAPI void rlDrawCommandList(CommandList list, Matrix transform);  // Draw command list with an additional transform, no vertex data uploaded
+RLAPI void rlUnloadCommandList(CommandList list);      // Unload command list from CPU and GPU memory
 RLAPI void rlSetTexture(unsigned int id);           // Set current texture for render batch and check buffers limits
 
 //------------------------------------------------------------------------------------------------------------------------
@@ -579,6 +708,10 @@ RLAPI void rlDrawVertexArray(int offset, int count);
 RLAPI void rlDrawVertexArrayElements(int offset, int count, void *buffer);
 RLAPI void rlDrawVertexArrayInstanced(int offset, int count, int instances);
 RLAPI void rlDrawVertexArrayElementsInstanced(int offset, int count, void *buffer, int instances);
+RLAPI bool rlDrawSpritesInstanced(unsigned int textureId, int textureWidth, int textureHeight, const SpriteInstance *sprites, int count); // Draw sprites with a single instanced draw call
+#if !defined(RLGL_STANDALONE)
+RLAPI void rlDrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, int instances); // Draw mesh instances, reusing internal instance buffer
+#endif
 
 // Textures management
 RLAPI unsigned int rlLoadTexture(void *data, int width, int height, int format, int mipmapCount); // Load texture in GPU
@@ -590,6 +723,10 @@ RLAPI void rlUnloadTexture(unsigned int id);                              // Unl
 RLAPI void rlGenerateMipmaps(Texture2D *texture);                         // Generate mipmap data for selected texture
 RLAPI void *rlReadTexturePixels(Texture2D texture);                       // Read texture pixel data
 RLAPI unsigned char *rlReadScreenPixels(int width, int height);           // Read screen pixel data (color buffer)
+RLAPI ScreenCapture rlReadScreenPixelsAsync(int width, int height);       // Start reading screen pixel data, without waiting for the GPU
+RLAPI bool rlIsScreenCaptureReady(ScreenCapture capture);                 // Check if screen capture pixels are available, does not wait
+RLAPI unsigned char *rlGetScreenCapturePixels(ScreenCapture *capture);    // Get screen capture pixel data, waits if not ready (capture is released)
+RLAPI void rlUnloadScreenCapture(ScreenCapture capture);                  // Release screen capture without reading its pixels
 
 // Framebuffer management (fbo)
 RLAPI unsigned int rlLoadFramebuffer(int width, int height);              // Load an empty framebuffer
@@ -802,6 +939,8 @@ typedef struct rlglData {
         Matrix projection;                  // Default projection matrix
         Matrix transform;                   // Transform matrix to be used with rlTranslate, rlRotate, rlScale
         bool transformRequired;             // Require transform matrix application to current draw-call vertex (if required)
+        float texcoordx, texcoordy;         // Current vertex texture coordinates (RL_BATCH_LAYOUT_INTERLEAVED)
+        unsigned char colorr, colorg, colorb, colora;   // Current vertex color (RL_BATCH_LAYOUT_INTERLEAVED)
         Matrix stack[MAX_MATRIX_STACK_SIZE];// Matrix stack for push/pop
         int stackCounter;                   // Matrix stack counter
 
@@ -824,7 +963,53 @@ typedef struct rlglData {
         int framebufferWidth;               // Default framebuffer width
         int framebufferHeight;              // Default framebuffer height
 
+        bool sortedBatch;                   // Sort render batch draw calls on flush (content declared order-independent)
+        int drawLayer;                      // Draw layer for next draw calls
+        BatchVertex *sortBuffer;            // Vertex scratch buffer for draw calls sorting
+        int sortBufferSize;                 // Vertex scratch buffer size (number of vertex)
+        unsigned int drawCallsCounter;      // Draw calls issued (render batches, vertex arrays, instanced)
+
+        unsigned int instanceVboId;         // Instance data buffer, shared by instanced draws and orphaned on every upload
+        int instanceBufferSize;             // Instance data buffer size (bytes)
+        float *instanceTransforms;          // Instance transforms conversion buffer (column-major matrices)
+        int instanceTransformsCount;        // Instance transforms conversion buffer size (number of matrices)
+        unsigned int spriteShaderId;        // Instanced sprites shader program (default fragment shader)
+        int spriteShaderLocs[9];            // Instanced sprites shader locations (see rlLoadShaderSprites())
+        unsigned int spriteVaoId;           // Instanced sprites vertex array
+        unsigned int spriteVboId;           // Instanced sprites quad corners buffer
+
+        RenderStats renderStats;            // Render statistics since last reset
+        RenderStats renderStatsPrevious;    // Render statistics before last reset
+        unsigned int statsDrawCallsBase;    // Draw calls issued on last render statistics reset
+        unsigned int statsIssuedBase;       // GL state calls issued on last render statistics reset
+        unsigned int statsElidedBase;       // GL state calls elided on last render statistics reset
+
+        bool recordingList;                 // Render batch draw calls recorded into command list instead of drawn
+        BatchVertex *listVertices;          // Command list vertex data being recorded
+        int listVertexCount;                // Command list vertex data count
+        int listVertexCapacity;             // Command list vertex data allocated count
+        DrawCall *listDraws;                // Command list draw calls being recorded
+        int listDrawsCount;                 // Command list draw calls count
+        int listDrawsCapacity;              // Command list draw calls allocated count
+
+        unsigned int capturePboIds[MAX_SCREEN_CAPTURE_BUFFERS];     // Released screen captures pixel buffers, kept for reuse
+        int capturePboSizes[MAX_SCREEN_CAPTURE_BUFFERS];            // Released screen captures pixel buffers size (bytes)
+        int capturePboCount;                // Released screen captures pixel buffers count
+
     } State;            // Renderer state
+    struct {
+        int program;                        // Shader program in use (-1 if unknown)
+        int activeSlot;                     // Active texture slot (-1 if unknown)
+        int texture2D[MAX_STATE_CACHE_TEXTURE_SLOTS];       // Texture bound to GL_TEXTURE_2D, per slot (-1 if unknown)
+        int textureCubemap[MAX_STATE_CACHE_TEXTURE_SLOTS];  // Texture bound to GL_TEXTURE_CUBE_MAP, per slot (-1 if unknown)
+        int depthTest;                      // GL_DEPTH_TEST enabled (-1 if unknown)
+        int blend;                          // GL_BLEND enabled (-1 if unknown)
+        int cullFace;                       // GL_CULL_FACE enabled (-1 if unknown)
+        int scissorTest;                    // GL_SCISSOR_TEST enabled (-1 if unknown)
+
+        unsigned int issuedCalls;           // GL state calls issued
+        unsigned int elidedCalls;           // GL state calls skipped (state already set)
+    } GLState;          // GL state shadow cache, mirrors the GL context state set through rlgl
     struct {
         bool vao;                           // VAO support (OpenGL ES2 could not support VAO extension) (GL_ARB_vertex_array_object)
         bool instancing;                    // Instancing supported (GL_ANGLE_instanced_arrays, GL_EXT_draw_instanced + GL_EXT_instanced_arrays)
@@ -838,6 +1023,8 @@ typedef struct rlglData {
         bool texCompASTC;                   // ASTC texture compression support (GL_KHR_texture_compression_astc_hdr, GL_KHR_texture_compression_astc_ldr)
         bool texMirrorClamp;                // Clamp mirror wrap mode supported (GL_EXT_texture_mirror_clamp)
         bool texAnisoFilter;                // Anisotropic texture filtering support (GL_EXT_texture_filter_anisotropic)
+        bool bufferStorage;                 // Persistent mapped buffers support (GL_ARB_buffer_storage + sync objects)
+        bool pixelBuffer;                   // Asynchronous pixels readback support (GL_PIXEL_PACK_BUFFER + glMapBufferRange + sync objects)
 
         float maxAnisotropyLevel;          // Maximum anisotropy level supported (minimum is 2.0f)
         int maxDepthBits;                   // Maximum bits for depth component
@@ -853,6 +1040,24 @@ typedef struct rlglData {
 static rlglData RLGL = { 0 };
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
+#if defined(RLGL_NULL_BACKEND)
+// Null backend state: commands log and emulated OpenGL objects bindings
+static struct {
+    NullCommand *commands;              // Recorded commands log
+    int commandsCount;                  // Recorded commands count
+    int commandsCapacity;               // Allocated commands count
+
+    unsigned int nextId;                // Next object id, shared by all object types (textures, buffers, shaders...)
+    unsigned int activeSlot;            // Active texture slot
+    unsigned int texture2D[32];         // Texture bound to every slot (GL_TEXTURE_2D)
+    unsigned int arrayBuffer;           // Bound GL_ARRAY_BUFFER
+    unsigned int elementBuffer;         // Bound GL_ELEMENT_ARRAY_BUFFER
+    float lineWidth;                    // Line width (glLineWidth())
+    unsigned char *mapped;              // Mapped buffers memory (glMapBufferRange()), zeroed on every map
+    int mappedSize;                     // Mapped buffers memory size
+} RLNULL = { 0 };
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_ES2)
 // NOTE: VAO functionality is exposed through extensions (OES)
 static PFNGLGENVERTEXARRAYSOESPROC glGenVertexArrays = NULL;
@@ -871,15 +1076,42 @@ static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader (RLGL.State.defaultShader)
 static void rlUnloadShaderDefault(void);    // Unload default shader (RLGL.State.defaultShader)
+static bool rlLoadBatchBufferStorage(void **data, int size, int uploadMode);  // Load render batch vertex data into bound VBO
+static int rlSortRenderBatch(RenderBatch *batch, int drawsCount);  // Sort and merge render batch draw calls, reordering vertex data
+static int rlGetDrawCallAlignment(const DrawCall *draw);            // Get number of vertex required to align next draw call
+static void rlRecordRenderBatch(RenderBatch *batch);                // Record render batch vertex data and draw calls into command list
+static void rlLoadInstanceData(const void *data, int size);         // Load instance data into internal instance buffer (bound as GL_ARRAY_BUFFER)
+static void rlLoadShaderSprites(void);      // Load instanced sprites shader and quad buffers
+#if !defined(RLGL_STANDALONE)
+static void rlEnableMaterial(Material material);                    // Enable material shader and send material data (colors, matrices, texture maps)
+static void rlDisableMaterial(void);                                // Unbind material texture maps and disable shader
+static void rlEnableMeshBuffers(Mesh mesh, Shader shader);          // Bind mesh vertex data (VAO or VBOs) to shader attributes
+static void rlDisableMeshBuffers(void);                             // Unbind mesh vertex data
+static void rlDrawMeshBuffers(Mesh mesh, Shader shader, Matrix matModelView, int instances);   // Draw bound mesh instances for every eye (stereo rendering)
+#endif
+static void rlCompleteVertexData(void);     // Fill missing colors and texcoords of current vertex buffer up to vertex count
+static void rlDrawRenderBatchOverflow(void);    // Draw current render batch before it overflows, counted as overflow flush
 #if defined(SUPPORT_GL_DETAILS_INFO)
 static char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // SUPPORT_GL_DETAILS_INFO
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
+#if defined(RLGL_NULL_BACKEND)
+static void rlNullRecord(int type, unsigned int mode, unsigned int id, int count, int instances, int size);   // Record command into null backend log
+#endif
 #if defined(GRAPHICS_API_OPENGL_11)
 static int rlGenerateMipmapsData(unsigned char *data, int baseWidth, int baseHeight);   // Generate mipmaps data on CPU side
 static Color *rlGenNextMipmapData(Color *srcData, int srcWidth, int srcHeight);         // Generate next mipmap level on CPU side
 #endif
 static int rlGetPixelDataSize(int width, int height, int format);   // Get pixel data size in bytes (image or texture)
+static void rlSetPixelsOpaque(unsigned char *pixels, int count);    // Set alpha of RGBA pixels to 255
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+static void rlStateUseProgram(unsigned int id);                     // Use shader program (cached)
+static void rlStateActiveTexture(int slot);                         // Select active texture slot (cached)
+#endif
+static void rlStateBindTexture(unsigned int target, unsigned int id);   // Bind texture to active slot (cached), GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP
+static void rlStateDeleteTexture(unsigned int id);                  // Delete texture, bindings removed from cache
+static void rlStateSetCapability(unsigned int cap, bool enabled);   // Enable/disable GL capability (cached): depth test, blend, cull face, scissor test
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Matrix operations
@@ -980,7 +1212,7 @@ void rlRotatef(float angleDeg, float x, float y, float z)
 {
     Matrix matRotation = MatrixIdentity();
 
-    Vector3 axis = Vector3{ x, y, z };
+    Vector3 axis = (Vector3){ x, y, z };
     matRotation = MatrixRotate(Vector3Normalize(axis), angleDeg*DEG2RAD);
 
     // NOTE: We transpose matrix with multiplication order
@@ -1059,6 +1291,15 @@ void rlNormal3f(float x, float y, float z) { glNormal3f(x, y, z); }
 void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { glColor4ub(r, g, b, a); }
 void rlColor3f(float x, float y, float z) { glColor3f(x, y, z); }
 void rlColor4f(float x, float y, float z, float w) { glColor4f(x, y, z, w); }
+void rlVertexBatch(const BatchVertex *vertices, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        glColor4ub(vertices[i].r, vertices[i].g, vertices[i].b, vertices[i].a);
+        glTexCoord2f(vertices[i].u, vertices[i].v);
+        glVertex3f(vertices[i].x, vertices[i].y, vertices[i].z);
+    }
+}
 #endif
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 // Initialize drawing mode (how to organize vertex)
@@ -1066,7 +1307,8 @@ void rlBegin(int mode)
 {
     // Draw mode can be RL_LINES, RL_TRIANGLES and RL_QUADS
     // NOTE: In all three cases, vertex are accumulated over default internal vertex buffer
-    if (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].mode != mode)
+    if ((RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].mode != mode) ||
+        (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].layer != RLGL.State.drawLayer))
     {
         if (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount > 0)
         {
@@ -1089,22 +1331,29 @@ void rlBegin(int mode)
             }
         }
 
-        if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS)
+        {
+            // NOTE: Sorted batch merges its draw calls first, only drawn if that does not free enough of them
+            if (RLGL.State.sortedBatch) RLGL.currentBatch->drawsCounter = rlSortRenderBatch(RLGL.currentBatch, RLGL.currentBatch->drawsCounter - 1) + 1;
+            if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS/2) rlDrawRenderBatchOverflow();
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount = 0;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].textureId = RLGL.State.defaultTextureId;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].layer = RLGL.State.drawLayer;
     }
 }
 
-// Finish vertex providing
-void rlEnd(void)
+// Fill missing colors and texcoords of current vertex buffer, so their counts match vertex count
+// NOTE: In OpenGL 1.1, one glColor call can be made for all the subsequent glVertex calls
+// NOTE: Interleaved layout writes full vertex on rlVertex3f(), there is only one counter to care about
+static void rlCompleteVertexData(void)
 {
-    // Make sure vertexCount is the same for vertices, texcoords, colors and normals
-    // NOTE: In OpenGL 1.1, one glColor call can be made for all the subsequent glVertex calls
+    bool separate = (RLGL.currentBatch->layout == RL_BATCH_LAYOUT_SEPARATE);
 
     // Make sure colors count match vertex count
-    if (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter != RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter)
+    if (separate && (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter != RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter))
     {
         int addColors = RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter - RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter;
 
@@ -1119,7 +1368,7 @@ void rlEnd(void)
     }
 
     // Make sure texcoords count match vertex count
-    if (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter != RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter)
+    if (separate && (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter != RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter))
     {
         int addTexCoords = RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter - RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter;
 
@@ -1130,6 +1379,13 @@ void rlEnd(void)
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter++;
         }
     }
+}
+
+// Finish vertex providing
+void rlEnd(void)
+{
+    // Make sure vertexCount is the same for vertices, texcoords, colors and normals
+    rlCompleteVertexData();
 
     // TODO: Make sure normals count match vertex count... if normals support is added in a future... :P
 
@@ -1147,7 +1403,7 @@ void rlEnd(void)
         // we need to call rlPopMatrix() before to recover *RLGL.State.currentMatrix (RLGL.State.modelview) for the next forced draw call!
         // If we have multiple matrix pushed, it will require "RLGL.State.stackCounter" pops before launching the draw
         for (int i = RLGL.State.stackCounter; i >= 0; i--) rlPopMatrix();
-        rlDrawRenderBatch(RLGL.currentBatch);
+        rlDrawRenderBatchOverflow();
     }
 }
 
@@ -1163,9 +1419,32 @@ void rlVertex3f(float x, float y, float z)
     // Verify that current vertex buffer elements limit has not been reached
     if (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter < (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementsCount*4))
     {
-        RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter] = vec.x;
-        RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter + 1] = vec.y;
-        RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter + 2] = vec.z;
+        if (RLGL.currentBatch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+        {
+            BatchVertex *vertex = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].interleaved[RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter];
+
+            vertex->x = vec.x;
+            vertex->y = vec.y;
+            vertex->z = vec.z;
+            vertex->u = RLGL.State.texcoordx;
+            vertex->v = RLGL.State.texcoordy;
+            vertex->r = RLGL.State.colorr;
+            vertex->g = RLGL.State.colorg;
+            vertex->b = RLGL.State.colorb;
+            vertex->a = RLGL.State.colora;
+
+            // NOTE: Color is kept for next vertex but texcoords are not,
+            // missing texcoords are 0.0f, same as on separate layout
+            RLGL.State.texcoordx = 0.0f;
+            RLGL.State.texcoordy = 0.0f;
+        }
+        else
+        {
+            RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter] = vec.x;
+            RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter + 1] = vec.y;
+            RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter + 2] = vec.z;
+        }
+
         RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter++;
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount++;
@@ -1189,6 +1468,13 @@ void rlVertex2i(int x, int y)
 // NOTE: Texture coordinates are limited to QUADS only
 void rlTexCoord2f(float x, float y)
 {
+    if (RLGL.currentBatch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+    {
+        RLGL.State.texcoordx = x;
+        RLGL.State.texcoordy = y;
+        return;
+    }
+
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter] = x;
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].texcoords[2*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter + 1] = y;
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].tcCounter++;
@@ -1204,6 +1490,15 @@ void rlNormal3f(float x, float y, float z)
 // Define one vertex (color)
 void rlColor4ub(unsigned char x, unsigned char y, unsigned char z, unsigned char w)
 {
+    if (RLGL.currentBatch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+    {
+        RLGL.State.colorr = x;
+        RLGL.State.colorg = y;
+        RLGL.State.colorb = z;
+        RLGL.State.colora = w;
+        return;
+    }
+
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].colors[4*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter] = x;
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].colors[4*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter + 1] = y;
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].colors[4*RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].cCounter + 2] = z;
@@ -1223,6 +1518,79 @@ void rlColor3f(float x, float y, float z)
     rlColor4ub((unsigned char)(x*255), (unsigned char)(y*255), (unsigned char)(z*255), 255);
 }
 
+// Define multiple vertex at once (position, texcoord, color), i.e. a full quad
+// NOTE: Provided depth (z) is used as is, vertex are transformed if required. Call it after rlCheckRenderBatchLimit()
+// and between rlBegin()/rlEnd(), it can be mixed with rlVertex3f() calls, like a sequence of complete vertex
+void rlVertexBatch(const BatchVertex *vertices, int count)
+{
+    VertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+
+    if ((buffer->vCounter + count) > (buffer->elementsCount*4))
+    {
+        TRACELOG(LOG_ERROR, "RLGL: Batch elements overflow");
+        return;
+    }
+
+    if (RLGL.currentBatch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+    {
+        // Texcoords provided for next vertex are consumed, like rlVertex3f() does, and last color
+        // is kept for next vertex, like missing colors are filled on separate layout
+        RLGL.State.texcoordx = 0.0f;
+        RLGL.State.texcoordy = 0.0f;
+        if (count > 0)
+        {
+            RLGL.State.colorr = vertices[count - 1].r;
+            RLGL.State.colorg = vertices[count - 1].g;
+            RLGL.State.colorb = vertices[count - 1].b;
+            RLGL.State.colora = vertices[count - 1].a;
+        }
+
+        BatchVertex *dest = buffer->interleaved + buffer->vCounter;
+        memcpy(dest, vertices, count*sizeof(BatchVertex));
+
+        if (RLGL.State.transformRequired)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                Vector3 vec = { dest[i].x, dest[i].y, dest[i].z };
+                vec = Vector3Transform(vec, RLGL.State.transform);
+
+                dest[i].x = vec.x;
+                dest[i].y = vec.y;
+                dest[i].z = vec.z;
+            }
+        }
+    }
+    else
+    {
+        // Previous vertex (provided with rlVertex3f()) get their missing texcoords and colors,
+        // vertex data arrays must be in sync before writing complete vertex at vCounter
+        rlCompleteVertexData();
+
+        for (int i = 0, k = buffer->vCounter; i < count; i++, k++)
+        {
+            Vector3 vec = { vertices[i].x, vertices[i].y, vertices[i].z };
+            if (RLGL.State.transformRequired) vec = Vector3Transform(vec, RLGL.State.transform);
+
+            buffer->vertices[3*k] = vec.x;
+            buffer->vertices[3*k + 1] = vec.y;
+            buffer->vertices[3*k + 2] = vec.z;
+            buffer->texcoords[2*k] = vertices[i].u;
+            buffer->texcoords[2*k + 1] = vertices[i].v;
+            buffer->colors[4*k] = vertices[i].r;
+            buffer->colors[4*k + 1] = vertices[i].g;
+            buffer->colors[4*k + 2] = vertices[i].b;
+            buffer->colors[4*k + 3] = vertices[i].a;
+        }
+
+        buffer->tcCounter = buffer->vCounter + count;
+        buffer->cCounter = buffer->vCounter + count;
+    }
+
+    buffer->vCounter += count;
+    RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount += count;
+}
+
 #endif
 
 //--------------------------------------------------------------------------------------
@@ -1241,7 +1609,7 @@ void rlSetTexture(unsigned int id)
         if (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vCounter >=
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementsCount*4)
         {
-            rlDrawRenderBatch(RLGL.currentBatch);
+            rlDrawRenderBatchOverflow();
         }
 #endif
     }
@@ -1250,7 +1618,8 @@ void rlSetTexture(unsigned int id)
 #if defined(GRAPHICS_API_OPENGL_11)
         rlEnableTexture(id);
 #else
-        if (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].textureId != id)
+        if ((RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].textureId != id) ||
+            (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].layer != RLGL.State.drawLayer))
         {
             if (RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount > 0)
             {
@@ -1273,10 +1642,16 @@ void rlSetTexture(unsigned int id)
                 }
             }
 
-            if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS)
+            {
+                // NOTE: Sorted batch merges its draw calls first, only drawn if that does not free enough of them
+                if (RLGL.State.sortedBatch) RLGL.currentBatch->drawsCounter = rlSortRenderBatch(RLGL.currentBatch, RLGL.currentBatch->drawsCounter - 1) + 1;
+                if (RLGL.currentBatch->drawsCounter >= DEFAULT_BATCH_DRAWCALLS/2) rlDrawRenderBatchOverflow();
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].vertexCount = 0;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawsCounter - 1].layer = RLGL.State.drawLayer;
         }
 #endif
     }
@@ -1286,7 +1661,7 @@ void rlSetTexture(unsigned int id)
 void rlActiveTextureSlot(int slot)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glActiveTexture(GL_TEXTURE0 + slot);
+    rlStateActiveTexture(slot);
 #endif
 }
 
@@ -1296,7 +1671,7 @@ void rlEnableTexture(unsigned int id)
 #if defined(GRAPHICS_API_OPENGL_11)
     glEnable(GL_TEXTURE_2D);
 #endif
-    glBindTexture(GL_TEXTURE_2D, id);
+    rlStateBindTexture(GL_TEXTURE_2D, id);
 }
 
 // Disable texture
@@ -1305,7 +1680,7 @@ void rlDisableTexture(void)
 #if defined(GRAPHICS_API_OPENGL_11)
     glDisable(GL_TEXTURE_2D);
 #endif
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 }
 
 // Enable texture cubemap
@@ -1313,7 +1688,7 @@ void rlEnableTextureCubemap(unsigned int id)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glEnable(GL_TEXTURE_CUBE_MAP);   // Core in OpenGL 1.4
-    glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+    rlStateBindTexture(GL_TEXTURE_CUBE_MAP, id);
 #endif
 }
 
@@ -1322,14 +1697,14 @@ void rlDisableTextureCubemap(void)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     glDisable(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    rlStateBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 #endif
 }
 
 // Set texture parameters (wrap mode/filter mode)
 void rlTextureParameters(unsigned int id, int param, int value)
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    rlStateBindTexture(GL_TEXTURE_2D, id);
 
     switch (param)
     {
@@ -1363,14 +1738,14 @@ void rlTextureParameters(unsigned int id, int param, int value)
         default: break;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 }
 
 // Enable shader program
 void rlEnableShader(unsigned int id)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2))
-    glUseProgram(id);
+    rlStateUseProgram(id);
 #endif
 }
 
@@ -1378,7 +1753,7 @@ void rlEnableShader(unsigned int id)
 void rlDisableShader(void)
 {
 #if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2))
-    glUseProgram(0);
+    rlStateUseProgram(0);
 #endif
 }
 
@@ -1399,10 +1774,10 @@ void rlDisableFramebuffer(void)
 }
 
 // Enable depth test
-void rlEnableDepthTest(void) { glEnable(GL_DEPTH_TEST); }
+void rlEnableDepthTest(void) { rlStateSetCapability(GL_DEPTH_TEST, true); }
 
 // Disable depth test
-void rlDisableDepthTest(void) { glDisable(GL_DEPTH_TEST); }
+void rlDisableDepthTest(void) { rlStateSetCapability(GL_DEPTH_TEST, false); }
 
 // Enable depth write
 void rlEnableDepthMask(void) { glDepthMask(GL_TRUE); }
@@ -1411,16 +1786,16 @@ void rlEnableDepthMask(void) { glDepthMask(GL_TRUE); }
 void rlDisableDepthMask(void) { glDepthMask(GL_FALSE); }
 
 // Enable backface culling
-void rlEnableBackfaceCulling(void) { glEnable(GL_CULL_FACE); }
+void rlEnableBackfaceCulling(void) { rlStateSetCapability(GL_CULL_FACE, true); }
 
 // Disable backface culling
-void rlDisableBackfaceCulling(void) { glDisable(GL_CULL_FACE); }
+void rlDisableBackfaceCulling(void) { rlStateSetCapability(GL_CULL_FACE, false); }
 
 // Enable scissor test
-void rlEnableScissorTest(void) { glEnable(GL_SCISSOR_TEST); }
+void rlEnableScissorTest(void) { rlStateSetCapability(GL_SCISSOR_TEST, true); }
 
 // Disable scissor test
-void rlDisableScissorTest(void) { glDisable(GL_SCISSOR_TEST); }
+void rlDisableScissorTest(void) { rlStateSetCapability(GL_SCISSOR_TEST, false); }
 
 // Scissor test
 void rlScissor(int x, int y, int width, int height) { glScissor(x, y, width, height); }
@@ -1561,7 +1936,9 @@ void rlSetBlendMode(int mode)
         }
 
         RLGL.State.currentBlendMode = mode;
+        RLGL.GLState.issuedCalls += 2;
     }
+    else RLGL.GLState.elidedCalls += 2;
 #endif
 }
 
@@ -1610,19 +1987,21 @@ void rlglInit(int width, int height)
 
     // Initialize OpenGL default states
     //----------------------------------------------------------
+    rlResetStateCache();                                    // Context state unknown, next state calls always issued
+
     // Init state: Depth test
     glDepthFunc(GL_LEQUAL);                                 // Type of depth testing to apply
-    glDisable(GL_DEPTH_TEST);                               // Disable depth testing for 2D (only used for 3D)
+    rlStateSetCapability(GL_DEPTH_TEST, false);             // Disable depth testing for 2D (only used for 3D)
 
     // Init state: Blending mode
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);      // Color blending function (how colors are mixed)
-    glEnable(GL_BLEND);                                     // Enable color blending (required to work with transparencies)
+    rlStateSetCapability(GL_BLEND, true);                   // Enable color blending (required to work with transparencies)
 
     // Init state: Culling
     // NOTE: All shapes/models triangles are drawn CCW
     glCullFace(GL_BACK);                                    // Cull the back face (default)
     glFrontFace(GL_CCW);                                    // Front face are defined counter clockwise (default)
-    glEnable(GL_CULL_FACE);                                 // Enable backface culling
+    rlStateSetCapability(GL_CULL_FACE, true);               // Enable backface culling
 
     // Init state: Cubemap seamless
 #if defined(GRAPHICS_API_OPENGL_33)
@@ -1658,8 +2037,48 @@ void rlglClose(void)
 
     rlUnloadShaderDefault();          // Unload default shader
 
-    glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
+    rlStateDeleteTexture(RLGL.State.defaultTextureId);  // Unload default texture
     TRACELOG(LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
+
+    RL_FREE(RLGL.State.sortBuffer);     // Unload draw calls sorting scratch buffer
+    RLGL.State.sortBuffer = NULL;
+    RLGL.State.sortBufferSize = 0;
+
+    // Unload instanced drawing data
+    if (RLGL.State.instanceVboId != 0) glDeleteBuffers(1, &RLGL.State.instanceVboId);
+    RL_FREE(RLGL.State.instanceTransforms);
+    if (RLGL.State.spriteShaderId != 0)
+    {
+        glDeleteProgram(RLGL.State.spriteShaderId);
+        glDeleteBuffers(1, &RLGL.State.spriteVboId);
+        if (RLGL.ExtSupported.vao) glDeleteVertexArrays(1, &RLGL.State.spriteVaoId);
+    }
+    RLGL.State.instanceVboId = 0;
+    RLGL.State.instanceBufferSize = 0;
+    RLGL.State.instanceTransforms = NULL;
+    RLGL.State.instanceTransformsCount = 0;
+    RLGL.State.spriteShaderId = 0;
+
+    // Unload command list recording buffers
+    RL_FREE(RLGL.State.listVertices);
+    RL_FREE(RLGL.State.listDraws);
+    RLGL.State.listVertices = NULL;
+    RLGL.State.listDraws = NULL;
+    RLGL.State.listVertexCapacity = 0;
+    RLGL.State.listDrawsCapacity = 0;
+
+    // Unload screen captures pixel buffers kept for reuse
+    if (RLGL.State.capturePboCount > 0) glDeleteBuffers(RLGL.State.capturePboCount, RLGL.State.capturePboIds);
+    RLGL.State.capturePboCount = 0;
+#endif
+#if defined(RLGL_NULL_BACKEND)
+    RL_FREE(RLNULL.commands);
+    RLNULL.commands = NULL;
+    RLNULL.commandsCount = 0;
+    RLNULL.commandsCapacity = 0;
+    RL_FREE(RLNULL.mapped);
+    RLNULL.mapped = NULL;
+    RLNULL.mappedSize = 0;
 #endif
 }
 
@@ -1669,6 +2088,9 @@ void rlLoadExtensions(void *loader)
 {
 #if defined(GRAPHICS_API_OPENGL_33)     // Also defined for GRAPHICS_API_OPENGL_21
     // NOTE: glad is generated and contains only required OpenGL 3.3 Core extensions (and lower versions)
+    #if defined(RLGL_NULL_BACKEND)
+        loader = (void *)rlNullGetProcAddress;      // Null backend functions replace platform ones
+    #endif
     #if !defined(__APPLE__)
         if (!gladLoadGLLoader((GLADloadproc)loader)) TRACELOG(LOG_WARNING, "GLAD: Cannot load OpenGL extensions");
         else TRACELOG(LOG_INFO, "GLAD: OpenGL extensions loaded successfully");
@@ -1706,6 +2128,8 @@ void rlLoadExtensions(void *loader)
     // NOTE: With GLAD, we can check if an extension is supported using the GLAD_GL_xxx booleans
     if (GLAD_GL_EXT_texture_compression_s3tc) RLGL.ExtSupported.texCompDXT = true;  // Texture compression: DXT
     if (GLAD_GL_ARB_ES3_compatibility) RLGL.ExtSupported.texCompETC2 = true;        // Texture compression: ETC2/EAC
+    if (GLAD_GL_ARB_buffer_storage && (glFenceSync != NULL)) RLGL.ExtSupported.bufferStorage = true;   // Persistent mapped buffers
+    if ((glMapBufferRange != NULL) && (glFenceSync != NULL)) RLGL.ExtSupported.pixelBuffer = true;      // Asynchronous pixels readback
     #endif
 #endif  // GRAPHICS_API_OPENGL_33
 
@@ -1957,21 +2381,54 @@ Texture2D rlGetTextureDefault(void)
 //------------------------------------------------------------------------------------------------
 // Load render batch
 RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
+{
+    return rlLoadRenderBatchEx(numBuffers, bufferElements, RL_BATCH_UPLOAD_SUBDATA, RL_BATCH_LAYOUT_SEPARATE);
+}
+
+// Load render batch with a vertex data upload mode and layout
+// NOTE: RL_BATCH_UPLOAD_PERSISTENT falls back to RL_BATCH_UPLOAD_ORPHAN if GL_ARB_buffer_storage is not supported,
+// it is recommended to use it with 3 buffers, so CPU can fill one buffer while GPU still reads the previous ones
+RenderBatch rlLoadRenderBatchEx(int numBuffers, int bufferElements, int uploadMode, int layout)
 {
     RenderBatch batch = { 0 };
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((uploadMode == RL_BATCH_UPLOAD_PERSISTENT) && !RLGL.ExtSupported.bufferStorage)
+    {
+        TRACELOG(LOG_WARNING, "RLGL: Persistent mapped buffers not supported, render batch using buffers orphaning");
+        uploadMode = RL_BATCH_UPLOAD_ORPHAN;
+    }
+
+    batch.uploadMode = uploadMode;
+    batch.layout = layout;
+
     // Initialize CPU (RAM) vertex buffers (position, texcoord, color data and indexes)
     //--------------------------------------------------------------------------------------------
-    batch.vertexBuffer = (VertexBuffer *)RL_MALLOC(sizeof(VertexBuffer)*numBuffers);
+    // NOTE: Zero initialized, VBO/VAO ids not generated yet are 0 if loading is aborted
+    batch.vertexBuffer = (VertexBuffer *)RL_CALLOC(numBuffers, sizeof(VertexBuffer));
 
     for (int i = 0; i < numBuffers; i++)
     {
         batch.vertexBuffer[i].elementsCount = bufferElements;
 
-        batch.vertexBuffer[i].vertices = (float *)RL_MALLOC(bufferElements*3*4*sizeof(float));        // 3 float by vertex, 4 vertex by quad
-        batch.vertexBuffer[i].texcoords = (float *)RL_MALLOC(bufferElements*2*4*sizeof(float));       // 2 float by texcoord, 4 texcoord by quad
-        batch.vertexBuffer[i].colors = (unsigned char *)RL_MALLOC(bufferElements*4*4*sizeof(unsigned char));   // 4 float by color, 4 colors by quad
+        if (layout == RL_BATCH_LAYOUT_INTERLEAVED)
+        {
+            batch.vertexBuffer[i].interleaved = (BatchVertex *)RL_CALLOC(bufferElements*4, sizeof(BatchVertex));  // 4 vertex by quad
+            batch.vertexBuffer[i].vertices = NULL;
+            batch.vertexBuffer[i].texcoords = NULL;
+            batch.vertexBuffer[i].colors = NULL;
+        }
+        else
+        {
+            batch.vertexBuffer[i].vertices = (float *)RL_MALLOC(bufferElements*3*4*sizeof(float));        // 3 float by vertex, 4 vertex by quad
+            batch.vertexBuffer[i].texcoords = (float *)RL_MALLOC(bufferElements*2*4*sizeof(float));       // 2 float by texcoord, 4 texcoord by quad
+            batch.vertexBuffer[i].colors = (unsigned char *)RL_MALLOC(bufferElements*4*4*sizeof(unsigned char));   // 4 float by color, 4 colors by quad
+            batch.vertexBuffer[i].interleaved = NULL;
+
+            for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
+            for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0.0f;
+            for (int j = 0; j < (4*4*bufferElements); j++) batch.vertexBuffer[i].colors[j] = 0;
+        }
 #if defined(GRAPHICS_API_OPENGL_33)
         batch.vertexBuffer[i].indices = (unsigned int *)RL_MALLOC(bufferElements*6*sizeof(unsigned int));      // 6 int by quad (indices)
 #endif
@@ -1979,10 +2436,6 @@ RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         batch.vertexBuffer[i].indices = (unsigned short *)RL_MALLOC(bufferElements*6*sizeof(unsigned short));  // 6 int by quad (indices)
 #endif
 
-        for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
-        for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0.0f;
-        for (int j = 0; j < (4*4*bufferElements); j++) batch.vertexBuffer[i].colors[j] = 0;
-
         int k = 0;
 
         // Indices can be initialized right now
@@ -2001,6 +2454,8 @@ RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         batch.vertexBuffer[i].vCounter = 0;
         batch.vertexBuffer[i].tcCounter = 0;
         batch.vertexBuffer[i].cCounter = 0;
+
+        batch.vertexBuffer[i].syncFence = NULL;
     }
 
     TRACELOG(LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in RAM (CPU)");
@@ -2008,7 +2463,10 @@ RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 
     // Upload to GPU (VRAM) vertex data and initialize VAOs/VBOs
     //--------------------------------------------------------------------------------------------
-    for (int i = 0; i < numBuffers; i++)
+    int mappedCount = 0;            // Vertex arrays replaced by mapped buffers (RL_BATCH_UPLOAD_PERSISTENT)
+    bool mappingFailed = false;
+
+    for (int i = 0; (i < numBuffers) && !mappingFailed; i++)
     {
         if (RLGL.ExtSupported.vao)
         {
@@ -2017,27 +2475,48 @@ RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
             glBindVertexArray(batch.vertexBuffer[i].vaoId);
         }
 
-        // Quads - Vertex buffers binding and attributes enable
-        // Vertex position buffer (shader-location = 0)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
-        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-        // Vertex texcoord buffer (shader-location = 1)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
-        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-
-        // Vertex color buffer (shader-location = 3)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
-        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+        if (batch.layout == RL_BATCH_LAYOUT_INTERLEAVED)
+        {
+            // Quads - Interleaved vertex buffer binding and attributes enable
+            // Vertex position, texcoord and color buffer (shader-location = 0, 1, 3)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            if (rlLoadBatchBufferStorage((void **)&batch.vertexBuffer[i].interleaved, bufferElements*4*sizeof(BatchVertex), batch.uploadMode)) mappedCount++;
+            else mappingFailed = true;
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, sizeof(BatchVertex), (void *)0);
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, sizeof(BatchVertex), (void *)(3*sizeof(float)));
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex), (void *)(5*sizeof(float)));
+        }
+        else
+        {
+            // Quads - Vertex buffers binding and attributes enable
+            // Vertex position buffer (shader-location = 0)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            if (!mappingFailed && rlLoadBatchBufferStorage((void **)&batch.vertexBuffer[i].vertices, bufferElements*3*4*sizeof(float), batch.uploadMode)) mappedCount++;
+            else mappingFailed = true;
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+
+            // Vertex texcoord buffer (shader-location = 1)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
+            if (!mappingFailed && rlLoadBatchBufferStorage((void **)&batch.vertexBuffer[i].texcoords, bufferElements*2*4*sizeof(float), batch.uploadMode)) mappedCount++;
+            else mappingFailed = true;
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+
+            // Vertex color buffer (shader-location = 3)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
+            if (!mappingFailed && rlLoadBatchBufferStorage((void **)&batch.vertexBuffer[i].colors, bufferElements*4*4*sizeof(unsigned char), batch.uploadMode)) mappedCount++;
+            else mappingFailed = true;
+            glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+            glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+        }
 
         // Fill index buffer
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[3]);
@@ -2050,7 +2529,31 @@ RenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 #endif
     }
 
-    TRACELOG(LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
+    if (mappingFailed)
+    {
+        // Immutable buffers storage can't be orphaned, everything is loaded again with new buffers
+        // NOTE: Deleting a mapped buffer unmaps it, mapped arrays are not freed (loaded in buffers order)
+        TRACELOG(LOG_WARNING, "RLGL: Failed to map render batch vertex buffers, using buffers orphaning");
+        for (int i = 0, k = 0; (i < numBuffers) && (k < mappedCount); i++)
+        {
+            if (batch.layout == RL_BATCH_LAYOUT_INTERLEAVED) { batch.vertexBuffer[i].interleaved = NULL; k++; }
+            else
+            {
+                if (k++ < mappedCount) batch.vertexBuffer[i].vertices = NULL;
+                if (k++ < mappedCount) batch.vertexBuffer[i].texcoords = NULL;
+                if (k++ < mappedCount) batch.vertexBuffer[i].colors = NULL;
+            }
+        }
+
+        batch.uploadMode = RL_BATCH_UPLOAD_ORPHAN;
+        batch.buffersCount = numBuffers;
+        rlUnloadRenderBatch(batch);
+
+        return rlLoadRenderBatchEx(numBuffers, bufferElements, RL_BATCH_UPLOAD_ORPHAN, layout);
+    }
+
+    if (batch.uploadMode == RL_BATCH_UPLOAD_PERSISTENT) TRACELOG(LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU) [persistent mapped]");
+    else TRACELOG(LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
 
     // Unbind the current VAO
     if (RLGL.ExtSupported.vao) glBindVertexArray(0);
@@ -2097,6 +2600,27 @@ void rlUnloadRenderBatch(RenderBatch batch)
     // Unload all vertex buffers data
     for (int i = 0; i < batch.buffersCount; i++)
     {
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+        if (batch.uploadMode == RL_BATCH_UPLOAD_PERSISTENT)
+        {
+            // Persistent mapped buffers must be unmapped before deletion,
+            // vertex arrays point to GPU mapped memory, so they are not freed
+            if (batch.vertexBuffer[i].syncFence != NULL) glDeleteSync((GLsync)batch.vertexBuffer[i].syncFence);
+
+            int mappedCount = (batch.layout == RL_BATCH_LAYOUT_INTERLEAVED)? 1 : 3;
+            for (int k = 0; k < mappedCount; k++)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[k]);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            batch.vertexBuffer[i].vertices = NULL;
+            batch.vertexBuffer[i].texcoords = NULL;
+            batch.vertexBuffer[i].colors = NULL;
+            batch.vertexBuffer[i].interleaved = NULL;
+        }
+#endif
         // Delete VBOs from GPU (VRAM)
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
         glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
@@ -2110,6 +2634,7 @@ void rlUnloadRenderBatch(RenderBatch batch)
         RL_FREE(batch.vertexBuffer[i].vertices);
         RL_FREE(batch.vertexBuffer[i].texcoords);
         RL_FREE(batch.vertexBuffer[i].colors);
+        RL_FREE(batch.vertexBuffer[i].interleaved);
         RL_FREE(batch.vertexBuffer[i].indices);
     }
 
@@ -2124,29 +2649,72 @@ void rlUnloadRenderBatch(RenderBatch batch)
 void rlDrawRenderBatch(RenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Sort draw calls when content has been declared order-independent
+    // NOTE: Current draw call is complete at this point, all of them are sorted
+    if (RLGL.State.sortedBatch && (batch->vertexBuffer[batch->currentBuffer].vCounter > 0))
+    {
+        batch->drawsCounter = rlSortRenderBatch(batch, batch->drawsCounter);
+        if (batch->drawsCounter == 0) batch->drawsCounter = 1;
+    }
+
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (change flag required)
-    if (batch->vertexBuffer[batch->currentBuffer].vCounter > 0)
+    if (RLGL.State.recordingList)
+    {
+        // Recording a command list: vertex data is kept on CPU side, nothing is uploaded or drawn
+        if (batch->vertexBuffer[batch->currentBuffer].vCounter > 0) rlRecordRenderBatch(batch);
+    }
+    else if (batch->vertexBuffer[batch->currentBuffer].vCounter > 0)
     {
+        RLGL.State.renderStats.flushes++;
+#if defined(RLGL_NULL_BACKEND)
+        rlNullRecord(RL_NULL_COMMAND_FLUSH, 0, 0, batch->vertexBuffer[batch->currentBuffer].vCounter, 1, 0);
+#endif
+
         // Activate elements VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
 
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
+        // NOTE: Persistent mapped buffers already contain the vertex data written by CPU (GL_MAP_COHERENT_BIT),
+        // no upload is required, GPU reads them directly
+        if (batch->uploadMode != RL_BATCH_UPLOAD_PERSISTENT)
+        {
+            // NOTE: Both layouts use 24 bytes per vertex (position, texcoord, color)
+            RLGL.State.renderStats.bytesUploaded += batch->vertexBuffer[batch->currentBuffer].vCounter*sizeof(BatchVertex);
+
+            // NOTE: Orphaning: glBufferData() with NULL pointer gives us a new storage for the buffer
+            // while GPU could still be reading the previous one, so glBufferSubData() does not need to wait
+            bool orphan = (batch->uploadMode == RL_BATCH_UPLOAD_ORPHAN);
+
+            if (batch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+            {
+                // Interleaved vertex buffer, one upload for all vertex attributes
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                if (orphan) glBufferData(GL_ARRAY_BUFFER, sizeof(BatchVertex)*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, NULL, GL_DYNAMIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*sizeof(BatchVertex), batch->vertexBuffer[batch->currentBuffer].interleaved);
+            }
+            else
+            {
+                // Vertex positions buffer
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                if (orphan) glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, NULL, GL_DYNAMIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
+                //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
 
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
+                // Texture coordinates buffer
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+                if (orphan) glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, NULL, GL_DYNAMIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
+                //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
 
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
+                // Colors buffer
+                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+                if (orphan) glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, NULL, GL_DYNAMIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, batch->vertexBuffer[batch->currentBuffer].vCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
+                //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementsCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
+            }
+        }
 
         // NOTE: glMapBuffer() causes sync issue.
         // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
@@ -2190,10 +2758,10 @@ void rlDrawRenderBatch(RenderBatch *batch)
         }
 
         // Draw buffers
-        if (batch->vertexBuffer[batch->currentBuffer].vCounter > 0)
+        if ((batch->vertexBuffer[batch->currentBuffer].vCounter > 0) && !RLGL.State.recordingList)
         {
             // Set current shader and upload current MVP matrix
-            glUseProgram(RLGL.State.currentShader.id);
+            rlStateUseProgram(RLGL.State.currentShader.id);
 
             // Create modelview-projection matrix and upload to shader
             Matrix matMVP = MatrixMultiply(RLGL.State.modelview, RLGL.State.projection);
@@ -2202,20 +2770,34 @@ void rlDrawRenderBatch(RenderBatch *batch)
             if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
             else
             {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-                glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: texcoord (shader-location = 1)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-                glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-                glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+                if (batch->layout == RL_BATCH_LAYOUT_INTERLEAVED)
+                {
+                    // Bind vertex attribs: position, texcoord and color (shader-location = 0, 1, 3)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, sizeof(BatchVertex), (void *)0);
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, sizeof(BatchVertex), (void *)(3*sizeof(float)));
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex), (void *)(5*sizeof(float)));
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+                }
+                else
+                {
+                    // Bind vertex attrib: position (shader-location = 0)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+
+                    // Bind vertex attrib: texcoord (shader-location = 1)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+
+                    // Bind vertex attrib: color (shader-location = 3)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+                    glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+                }
 
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
             }
@@ -2230,19 +2812,19 @@ void rlDrawRenderBatch(RenderBatch *batch)
             {
                 if (RLGL.State.activeTextureId[i] > 0)
                 {
-                    glActiveTexture(GL_TEXTURE0 + 1 + i);
-                    glBindTexture(GL_TEXTURE_2D, RLGL.State.activeTextureId[i]);
+                    rlStateActiveTexture(1 + i);
+                    rlStateBindTexture(GL_TEXTURE_2D, RLGL.State.activeTextureId[i]);
                 }
             }
 
             // Activate default sampler2D texture0 (one texture is always active for default batch shader)
             // NOTE: Batch system accumulates calls by texture0 changes, additional textures are enabled for all the draw calls
-            glActiveTexture(GL_TEXTURE0);
+            rlStateActiveTexture(0);
 
             for (int i = 0, vertexOffset = 0; i < batch->drawsCounter; i++)
             {
                 // Bind current draw call texture, activated as GL_TEXTURE0 and binded to sampler2D texture0 by default
-                glBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
+                rlStateBindTexture(GL_TEXTURE_2D, batch->draws[i].textureId);
 
                 if ((batch->draws[i].mode == RL_LINES) || (batch->draws[i].mode == RL_TRIANGLES)) glDrawArrays(batch->draws[i].mode, vertexOffset, batch->draws[i].vertexCount);
                 else
@@ -2259,6 +2841,8 @@ void rlDrawRenderBatch(RenderBatch *batch)
                 }
 
                 vertexOffset += (batch->draws[i].vertexCount + batch->draws[i].vertexAlignment);
+                RLGL.State.drawCallsCounter++;
+                RLGL.State.renderStats.vertices += batch->draws[i].vertexCount;
             }
 
             if (!RLGL.ExtSupported.vao)
@@ -2267,12 +2851,12 @@ void rlDrawRenderBatch(RenderBatch *batch)
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
             }
 
-            glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
+            // NOTE: Texture is kept bound, state cache skips binding it again on next flush if it did not change
         }
 
         if (RLGL.ExtSupported.vao) glBindVertexArray(0); // Unbind VAO
 
-        glUseProgram(0);    // Unbind shader program
+        rlStateUseProgram(0);    // Unbind shader program
     }
     //------------------------------------------------------------------------------------------------------------
 
@@ -2296,6 +2880,7 @@ void rlDrawRenderBatch(RenderBatch *batch)
         batch->draws[i].mode = RL_QUADS;
         batch->draws[i].vertexCount = 0;
         batch->draws[i].textureId = RLGL.State.defaultTextureId;
+        batch->draws[i].layer = RLGL.State.drawLayer;
     }
 
     // Reset active texture units for next batch
@@ -2305,9 +2890,36 @@ void rlDrawRenderBatch(RenderBatch *batch)
     batch->drawsCounter = 1;
     //------------------------------------------------------------------------------------------------------------
 
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    if (batch->uploadMode == RL_BATCH_UPLOAD_PERSISTENT)
+    {
+        // Fence current buffer, it can not be written again until GPU is done reading it
+        if (batch->vertexBuffer[batch->currentBuffer].syncFence != NULL) glDeleteSync((GLsync)batch->vertexBuffer[batch->currentBuffer].syncFence);
+        batch->vertexBuffer[batch->currentBuffer].syncFence = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+
     // Change to next buffer in the list (in case of multi-buffering)
     batch->currentBuffer++;
     if (batch->currentBuffer >= batch->buffersCount) batch->currentBuffer = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    // Wait for GPU to release next buffer before CPU starts writing on it
+    // NOTE: With enough buffers (3 recommended) the fence is usually already signaled
+    if ((batch->uploadMode == RL_BATCH_UPLOAD_PERSISTENT) && (batch->vertexBuffer[batch->currentBuffer].syncFence != NULL))
+    {
+        GLsync fence = (GLsync)batch->vertexBuffer[batch->currentBuffer].syncFence;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        while ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED) && (result != GL_WAIT_FAILED))
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);   // Wait 1 ms steps
+        }
+
+        glDeleteSync(fence);
+        batch->vertexBuffer[batch->currentBuffer].syncFence = NULL;
+    }
+#endif
 #endif
 }
 
@@ -2330,6 +2942,19 @@ void rlDrawRenderBatchActive(void)
 #endif
 }
 
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// Draw current render batch before it overflows (vertex buffer or draw calls limit)
+// NOTE: Only counted as overflow flush if vertex data was actually drawn, not on command list recording
+static void rlDrawRenderBatchOverflow(void)
+{
+    unsigned int flushes = RLGL.State.renderStats.flushes;
+
+    rlDrawRenderBatch(RLGL.currentBatch);
+
+    if (RLGL.State.renderStats.flushes != flushes) RLGL.State.renderStats.overflowFlushes++;
+}
+#endif
+
 // Check internal buffer overflow for a given number of vertex
 // and force a RenderBatch draw call if required
 bool rlCheckRenderBatchLimit(int vCount)
@@ -2341,79 +2966,382 @@ bool rlCheckRenderBatchLimit(int vCount)
         (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementsCount*4))
     {
         overflow = true;
-        rlDrawRenderBatch(RLGL.currentBatch);    // NOTE: Stereo rendering is checked inside
+        rlDrawRenderBatchOverflow();    // NOTE: Stereo rendering is checked inside
     }
 #endif
 
     return overflow;
 }
 
-// Textures data management
-//-----------------------------------------------------------------------------------------
-// Convert image data to OpenGL texture (returns OpenGL valid Id)
-unsigned int rlLoadTexture(void *data, int width, int height, int format, int mipmapCount)
+// Get active render batch elements (quads) per vertex buffer
+// NOTE: Useful to split bulk vertex submission (rlVertexBatch()) in chunks that fit a single buffer
+int rlGetRenderBatchElements(void)
 {
-    glBindTexture(GL_TEXTURE_2D, 0);    // Free any old binding
+    int elements = DEFAULT_BATCH_BUFFER_ELEMENTS;
 
-    unsigned int id = 0;
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    elements = RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementsCount;
+#endif
+
+    return elements;
+}
+
+// Get active render batch depth for next draw
+// NOTE: rlVertex2f() uses it as z, it is increased on every rlEnd()
+float rlGetRenderBatchDepth(void)
+{
+    float depth = 0.0f;
 
-    // Check texture format support by OpenGL 1.1 (compressed textures not supported)
-#if defined(GRAPHICS_API_OPENGL_11)
-    if (format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
-    {
-        TRACELOG(LOG_WARNING, "GL: OpenGL 1.1 does not support GPU compressed texture formats");
-        return id;
-    }
-#else
-    if ((!RLGL.ExtSupported.texCompDXT) && ((format == PIXELFORMAT_COMPRESSED_DXT1_RGB) || (format == PIXELFORMAT_COMPRESSED_DXT1_RGBA) ||
-        (format == PIXELFORMAT_COMPRESSED_DXT3_RGBA) || (format == PIXELFORMAT_COMPRESSED_DXT5_RGBA)))
-    {
-        TRACELOG(LOG_WARNING, "GL: DXT compressed texture format not supported");
-        return id;
-    }
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    if ((!RLGL.ExtSupported.texCompETC1) && (format == PIXELFORMAT_COMPRESSED_ETC1_RGB))
-    {
-        TRACELOG(LOG_WARNING, "GL: ETC1 compressed texture format not supported");
-        return id;
-    }
+    depth = RLGL.currentBatch->currentDepth;
+#endif
 
-    if ((!RLGL.ExtSupported.texCompETC2) && ((format == PIXELFORMAT_COMPRESSED_ETC2_RGB) || (format == PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA)))
-    {
-        TRACELOG(LOG_WARNING, "GL: ETC2 compressed texture format not supported");
-        return id;
-    }
+    return depth;
+}
 
-    if ((!RLGL.ExtSupported.texCompPVRT) && ((format == PIXELFORMAT_COMPRESSED_PVRT_RGB) || (format == PIXELFORMAT_COMPRESSED_PVRT_RGBA)))
+// Enable render batch draw calls sorting by layer, texture and mode
+// NOTE: Draw calls are stably reordered and merged when batch is drawn, it reduces texture switches
+// and draw calls but drawing order changes, only use it for order-independent content (opaque/depth-tested)
+void rlEnableSortedBatch(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.State.sortedBatch)
     {
-        TRACELOG(LOG_WARNING, "GL: PVRT compressed texture format not supported");
-        return id;
+        rlDrawRenderBatch(RLGL.currentBatch);   // Previous content keeps submission order
+        RLGL.State.sortedBatch = true;
     }
+#endif
+}
 
-    if ((!RLGL.ExtSupported.texCompASTC) && ((format == PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA) || (format == PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA)))
+// Disable render batch draw calls sorting
+void rlDisableSortedBatch(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.State.sortedBatch)
     {
-        TRACELOG(LOG_WARNING, "GL: ASTC compressed texture format not supported");
-        return id;
+        rlDrawRenderBatch(RLGL.currentBatch);   // Draw sorted content
+        RLGL.State.sortedBatch = false;
+        RLGL.State.drawLayer = 0;
     }
 #endif
-#endif  // GRAPHICS_API_OPENGL_11
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+}
 
-    glGenTextures(1, &id);              // Generate texture id
+// Set draw layer for next draws
+// NOTE: Only used by sorted batch, lower layers are drawn first
+void rlSetDrawLayer(int layer)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.drawLayer = layer;
+#endif
+}
 
-    glBindTexture(GL_TEXTURE_2D, id);
+// Get number of draw calls issued since rlglInit() (render batches, vertex arrays, instanced)
+unsigned int rlGetDrawCallsCount(void)
+{
+    unsigned int count = 0;
 
-    int mipWidth = width;
-    int mipHeight = height;
-    int mipOffset = 0;          // Mipmap data offset
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    count = RLGL.State.drawCallsCounter;
+#endif
 
-    // Load the different mipmap levels
-    for (int i = 0; i < mipmapCount; i++)
-    {
-        unsigned int mipSize = rlGetPixelDataSize(mipWidth, mipHeight, format);
+    return count;
+}
 
-        unsigned int glInternalFormat, glFormat, glType;
+// Get number of GL state calls issued (textures, shaders, capabilities, blending)
+unsigned int rlGetStateCallsIssued(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    return RLGL.GLState.issuedCalls;
+#else
+    return 0;
+#endif
+}
+
+// Get number of redundant GL state calls skipped by state cache
+unsigned int rlGetStateCallsElided(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    return RLGL.GLState.elidedCalls;
+#else
+    return 0;
+#endif
+}
+
+// Reset GL state cache
+// NOTE: State cache mirrors the state set through rlgl, it must be reset if GL state is changed directly
+// (textures, shader program, capabilities), next state calls are always issued
+void rlResetStateCache(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.GLState.program = -1;
+    RLGL.GLState.activeSlot = -1;
+    for (int i = 0; i < MAX_STATE_CACHE_TEXTURE_SLOTS; i++)
+    {
+        RLGL.GLState.texture2D[i] = -1;
+        RLGL.GLState.textureCubemap[i] = -1;
+    }
+    RLGL.GLState.depthTest = -1;
+    RLGL.GLState.blend = -1;
+    RLGL.GLState.cullFace = -1;
+    RLGL.GLState.scissorTest = -1;
+#endif
+}
+
+// Get render statistics since last reset (current frame)
+RenderStats rlGetRenderStats(void)
+{
+    RenderStats stats = { 0 };
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stats = RLGL.State.renderStats;
+    stats.drawCalls = RLGL.State.drawCallsCounter - RLGL.State.statsDrawCallsBase;
+    stats.stateCallsIssued = RLGL.GLState.issuedCalls - RLGL.State.statsIssuedBase;
+    stats.stateCallsElided = RLGL.GLState.elidedCalls - RLGL.State.statsElidedBase;
+#endif
+
+    return stats;
+}
+
+// Get render statistics before last reset (previous frame)
+RenderStats rlGetRenderStatsPrevious(void)
+{
+    RenderStats stats = { 0 };
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    stats = RLGL.State.renderStatsPrevious;
+#endif
+
+    return stats;
+}
+
+// Reset render statistics, current ones are kept as previous
+// NOTE: Call it on frame start (before BeginDrawing()), previous statistics are then the full last frame
+void rlResetRenderStats(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.renderStatsPrevious = rlGetRenderStats();
+    memset(&RLGL.State.renderStats, 0, sizeof(RenderStats));
+    RLGL.State.statsDrawCallsBase = RLGL.State.drawCallsCounter;
+    RLGL.State.statsIssuedBase = RLGL.GLState.issuedCalls;
+    RLGL.State.statsElidedBase = RLGL.GLState.elidedCalls;
+#endif
+}
+
+// Begin recording render batch draw calls into a command list
+// NOTE: Current batch is drawn first, following flushes are recorded instead of drawn until rlEndCommandList()
+void rlBeginCommandList(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (RLGL.State.recordingList)
+    {
+        TRACELOG(LOG_WARNING, "RLGL: Command list already being recorded");
+        return;
+    }
+
+    rlDrawRenderBatch(RLGL.currentBatch);
+
+    RLGL.State.recordingList = true;
+    RLGL.State.listVertexCount = 0;
+    RLGL.State.listDrawsCount = 0;
+#endif
+}
+
+// End recording render batch draw calls, recorded data replaces list content
+// NOTE: Vertex data is uploaded once into a static VBO owned by the list
+void rlEndCommandList(CommandList *list)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.State.recordingList) return;
+
+    rlDrawRenderBatch(RLGL.currentBatch);
+    RLGL.State.recordingList = false;
+
+    rlUnloadCommandList(*list);
+    memset(list, 0, sizeof(CommandList));
+
+    if (RLGL.State.listVertexCount == 0) return;
+
+    list->vertexCount = RLGL.State.listVertexCount;
+    list->drawsCount = RLGL.State.listDrawsCount;
+    list->draws = (DrawCall *)RL_MALLOC(list->drawsCount*sizeof(DrawCall));
+    memcpy(list->draws, RLGL.State.listDraws, list->drawsCount*sizeof(DrawCall));
+
+    if (RLGL.ExtSupported.vao)
+    {
+        glGenVertexArrays(1, &list->vaoId);
+        glBindVertexArray(list->vaoId);
+    }
+
+    glGenBuffers(1, &list->vboId);
+    glBindBuffer(GL_ARRAY_BUFFER, list->vboId);
+    glBufferData(GL_ARRAY_BUFFER, list->vertexCount*sizeof(BatchVertex), RLGL.State.listVertices, GL_STATIC_DRAW);
+    RLGL.State.renderStats.bytesUploaded += list->vertexCount*sizeof(BatchVertex);
+
+    if (RLGL.ExtSupported.vao)
+    {
+        // Vertex attribs: position, texcoord and color (shader-location = 0, 1, 3)
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, sizeof(BatchVertex), (void *)0);
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, sizeof(BatchVertex), (void *)(3*sizeof(float)));
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex), (void *)(5*sizeof(float)));
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+
+        glBindVertexArray(0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    TRACELOG(LOG_DEBUG, "RLGL: Command list recorded (%i vertex, %i draw calls)", list->vertexCount, list->drawsCount);
+#endif
+}
+
+// Draw command list, current shader and modelview/projection matrices are used
+// NOTE: Current batch is drawn first to keep drawing order, transform is applied before modelview
+void rlDrawCommandList(CommandList list, Matrix transform)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((list.vboId == 0) || (list.drawsCount == 0)) return;
+    if (RLGL.State.recordingList)
+    {
+        TRACELOG(LOG_WARNING, "RLGL: Command list can not be drawn while recording another one");
+        return;
+    }
+
+    rlDrawRenderBatch(RLGL.currentBatch);
+
+    rlStateUseProgram(RLGL.State.currentShader.id);
+    glUniform4f(RLGL.State.currentShader.locs[SHADER_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
+    glUniform1i(RLGL.State.currentShader.locs[SHADER_LOC_MAP_DIFFUSE], 0);
+
+    if (RLGL.ExtSupported.vao) glBindVertexArray(list.vaoId);
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, list.vboId);
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, sizeof(BatchVertex), (void *)0);
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_POSITION]);
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, sizeof(BatchVertex), (void *)(3*sizeof(float)));
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+        glVertexAttribPointer(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex), (void *)(5*sizeof(float)));
+        glEnableVertexAttribArray(RLGL.State.currentShader.locs[SHADER_LOC_VERTEX_COLOR]);
+    }
+
+    rlStateActiveTexture(0);
+
+    // NOTE: Like batch vertices, list vertices are transformed by the internal transform matrix before modelview
+    Matrix matModelView = RLGL.State.modelview;
+    if (RLGL.State.transformRequired) matModelView = MatrixMultiply(RLGL.State.transform, matModelView);
+    matModelView = MatrixMultiply(transform, matModelView);
+
+    int eyesCount = 1;
+    if (RLGL.State.stereoRender) eyesCount = 2;
+
+    for (int eye = 0; eye < eyesCount; eye++)
+    {
+        Matrix matMVP = MatrixMultiply(matModelView, RLGL.State.projection);
+
+        if (eyesCount == 2)
+        {
+            rlViewport(eye*RLGL.State.framebufferWidth/2, 0, RLGL.State.framebufferWidth/2, RLGL.State.framebufferHeight);
+            matMVP = MatrixMultiply(MatrixMultiply(matModelView, RLGL.State.viewOffsetStereo[eye]), RLGL.State.projectionStereo[eye]);
+        }
+
+        glUniformMatrix4fv(RLGL.State.currentShader.locs[SHADER_LOC_MATRIX_MVP], 1, false, MatrixToFloat(matMVP));
+
+        for (int i = 0, vertexOffset = 0; i < list.drawsCount; i++)
+        {
+            rlStateBindTexture(GL_TEXTURE_2D, list.draws[i].textureId);
+            glDrawArrays(list.draws[i].mode, vertexOffset, list.draws[i].vertexCount);
+
+            vertexOffset += list.draws[i].vertexCount;
+            RLGL.State.drawCallsCounter++;
+            RLGL.State.renderStats.vertices += list.draws[i].vertexCount;
+        }
+    }
+
+    if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+    else glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    rlStateUseProgram(0);
+#endif
+}
+
+// Unload command list from CPU and GPU memory
+void rlUnloadCommandList(CommandList list)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (list.vboId != 0) glDeleteBuffers(1, &list.vboId);
+    if (RLGL.ExtSupported.vao && (list.vaoId != 0)) glDeleteVertexArrays(1, &list.vaoId);
+#endif
+    RL_FREE(list.draws);
+}
+
+// Textures data management
+//-----------------------------------------------------------------------------------------
+// Convert image data to OpenGL texture (returns OpenGL valid Id)
+unsigned int rlLoadTexture(void *data, int width, int height, int format, int mipmapCount)
+{
+    rlStateBindTexture(GL_TEXTURE_2D, 0);    // Free any old binding
+
+    unsigned int id = 0;
+
+    // Check texture format support by OpenGL 1.1 (compressed textures not supported)
+#if defined(GRAPHICS_API_OPENGL_11)
+    if (format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
+    {
+        TRACELOG(LOG_WARNING, "GL: OpenGL 1.1 does not support GPU compressed texture formats");
+        return id;
+    }
+#else
+    if ((!RLGL.ExtSupported.texCompDXT) && ((format == PIXELFORMAT_COMPRESSED_DXT1_RGB) || (format == PIXELFORMAT_COMPRESSED_DXT1_RGBA) ||
+        (format == PIXELFORMAT_COMPRESSED_DXT3_RGBA) || (format == PIXELFORMAT_COMPRESSED_DXT5_RGBA)))
+    {
+        TRACELOG(LOG_WARNING, "GL: DXT compressed texture format not supported");
+        return id;
+    }
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((!RLGL.ExtSupported.texCompETC1) && (format == PIXELFORMAT_COMPRESSED_ETC1_RGB))
+    {
+        TRACELOG(LOG_WARNING, "GL: ETC1 compressed texture format not supported");
+        return id;
+    }
+
+    if ((!RLGL.ExtSupported.texCompETC2) && ((format == PIXELFORMAT_COMPRESSED_ETC2_RGB) || (format == PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA)))
+    {
+        TRACELOG(LOG_WARNING, "GL: ETC2 compressed texture format not supported");
+        return id;
+    }
+
+    if ((!RLGL.ExtSupported.texCompPVRT) && ((format == PIXELFORMAT_COMPRESSED_PVRT_RGB) || (format == PIXELFORMAT_COMPRESSED_PVRT_RGBA)))
+    {
+        TRACELOG(LOG_WARNING, "GL: PVRT compressed texture format not supported");
+        return id;
+    }
+
+    if ((!RLGL.ExtSupported.texCompASTC) && ((format == PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA) || (format == PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA)))
+    {
+        TRACELOG(LOG_WARNING, "GL: ASTC compressed texture format not supported");
+        return id;
+    }
+#endif
+#endif  // GRAPHICS_API_OPENGL_11
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glGenTextures(1, &id);              // Generate texture id
+
+    rlStateBindTexture(GL_TEXTURE_2D, id);
+
+    int mipWidth = width;
+    int mipHeight = height;
+    int mipOffset = 0;          // Mipmap data offset
+
+    // Load the different mipmap levels
+    for (int i = 0; i < mipmapCount; i++)
+    {
+        unsigned int mipSize = rlGetPixelDataSize(mipWidth, mipHeight, format);
+
+        unsigned int glInternalFormat, glFormat, glType;
         rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType);
 
         TRACELOGD("TEXTURE: Load mipmap level %i (%i x %i), size: %i, offset: %i", i, mipWidth, mipHeight, mipSize, mipOffset);
@@ -2490,7 +3418,7 @@ unsigned int rlLoadTexture(void *data, int width, int height, int format, int mi
     // NOTE: If mipmaps were not in data, they are not generated automatically
 
     // Unbind current texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 
     if (id > 0) TRACELOG(LOG_INFO, "TEXTURE: [ID %i] Texture loaded successfully (%ix%i - %i mipmaps)", id, width, height, mipmapCount);
     else TRACELOG(LOG_WARNING, "TEXTURE: Failed to load texture");
@@ -2521,7 +3449,7 @@ unsigned int rlLoadTextureDepth(int width, int height, bool useRenderBuffer)
     if (!useRenderBuffer && RLGL.ExtSupported.texDepth)
     {
         glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
+        rlStateBindTexture(GL_TEXTURE_2D, id);
         glTexImage2D(GL_TEXTURE_2D, 0, glInternalFormat, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -2529,7 +3457,7 @@ unsigned int rlLoadTextureDepth(int width, int height, bool useRenderBuffer)
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+        rlStateBindTexture(GL_TEXTURE_2D, 0);
 
         TRACELOG(LOG_INFO, "TEXTURE: Depth texture loaded successfully");
     }
@@ -2561,7 +3489,7 @@ unsigned int rlLoadTextureCubemap(void *data, int size, int format)
     unsigned int dataSize = rlGetPixelDataSize(size, size, format);
 
     glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+    rlStateBindTexture(GL_TEXTURE_CUBE_MAP, id);
 
     unsigned int glInternalFormat, glFormat, glType;
     rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType);
@@ -2620,7 +3548,7 @@ unsigned int rlLoadTextureCubemap(void *data, int size, int format)
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);  // Flag not supported on OpenGL ES 2.0
 #endif
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    rlStateBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 #endif
 
     if (id > 0) TRACELOG(LOG_INFO, "TEXTURE: [ID %i] Cubemap texture loaded successfully (%ix%i)", id, size, size);
@@ -2633,7 +3561,7 @@ unsigned int rlLoadTextureCubemap(void *data, int size, int format)
 // NOTE: We don't know safely if internal texture format is the expected one...
 void rlUpdateTexture(unsigned int id, int offsetX, int offsetY, int width, int height, int format, const void *data)
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    rlStateBindTexture(GL_TEXTURE_2D, id);
 
     unsigned int glInternalFormat, glFormat, glType;
     rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType);
@@ -2700,13 +3628,13 @@ void rlGetGlTextureFormats(int format, unsigned int *glInternalFormat, unsigned
 // Unload texture from GPU memory
 void rlUnloadTexture(unsigned int id)
 {
-    glDeleteTextures(1, &id);
+    rlStateDeleteTexture(id);
 }
 
 // Generate mipmap data for selected texture
 void rlGenerateMipmaps(Texture2D *texture)
 {
-    glBindTexture(GL_TEXTURE_2D, texture->id);
+    rlStateBindTexture(GL_TEXTURE_2D, texture->id);
 
     // Check if texture is power-of-two (POT)
     bool texIsPOT = false;
@@ -2771,7 +3699,7 @@ void rlGenerateMipmaps(Texture2D *texture)
 #endif
     else TRACELOG(LOG_WARNING, "TEXTURE: [ID %i] Failed to generate mipmaps", texture->id);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 }
 
 
@@ -2781,7 +3709,7 @@ void *rlReadTexturePixels(Texture2D texture)
     void *pixels = NULL;
 
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
-    glBindTexture(GL_TEXTURE_2D, texture.id);
+    rlStateBindTexture(GL_TEXTURE_2D, texture.id);
 
     // NOTE: Using texture.id, we can retrieve some texture info (but not on OpenGL ES 2.0)
     // Possible texture info: GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE
@@ -2807,7 +3735,7 @@ void *rlReadTexturePixels(Texture2D texture)
     }
     else TRACELOG(LOG_WARNING, "TEXTURE: [ID %i] Data retrieval not suported for pixel format (%i)", texture.id, texture.format);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 #endif
 
 #if defined(GRAPHICS_API_OPENGL_ES2)
@@ -2823,7 +3751,7 @@ void *rlReadTexturePixels(Texture2D texture)
     // TODO: Create depth texture/renderbuffer for fbo?
 
     glBindFramebuffer(GL_FRAMEBUFFER, fboId);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
 
     // Attach our texture to FBO
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.id, 0);
@@ -2845,32 +3773,156 @@ void *rlReadTexturePixels(Texture2D texture)
 // Read screen pixel data (color buffer)
 unsigned char *rlReadScreenPixels(int width, int height)
 {
-    unsigned char *screenData = (unsigned char *)RL_CALLOC(width*height*4, sizeof(unsigned char));
+    unsigned char *imgData = (unsigned char *)RL_MALLOC(width*height*4*sizeof(unsigned char));
 
     // NOTE 1: glReadPixels returns image flipped vertically -> (0,0) is the bottom left corner of the framebuffer
     // NOTE 2: We are getting alpha channel! Be careful, it can be transparent if not cleared properly!
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, screenData);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, imgData);
 
-    // Flip image vertically!
-    unsigned char *imgData = (unsigned char *)RL_MALLOC(width*height*4*sizeof(unsigned char));
+    // Flip image vertically, swapping lines in place
+    unsigned char *line = (unsigned char *)RL_MALLOC(width*4*sizeof(unsigned char));
+
+    for (int y = 0; y < height/2; y++)
+    {
+        unsigned char *top = imgData + y*width*4;
+        unsigned char *bottom = imgData + (height - 1 - y)*width*4;
+
+        memcpy(line, top, width*4);
+        memcpy(top, bottom, width*4);
+        memcpy(bottom, line, width*4);
+    }
+
+    RL_FREE(line);
 
-    for (int y = height - 1; y >= 0; y--)
+    // Set alpha component value to 255 (no trasparent image retrieval)
+    // NOTE: Alpha value has already been applied to RGB in framebuffer, we don't need it!
+    rlSetPixelsOpaque(imgData, width*height);
+
+    return imgData;     // NOTE: image data should be freed
+}
+
+// Start reading screen pixel data into a pixel buffer object
+// NOTE: Pixels are copied by the GPU once previous draws complete, read them one or two frames later
+// with rlGetScreenCapturePixels() to avoid stalling the pipeline
+ScreenCapture rlReadScreenPixelsAsync(int width, int height)
+{
+    ScreenCapture capture = { 0 };
+    capture.width = width;
+    capture.height = height;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (RLGL.ExtSupported.pixelBuffer)
     {
-        for (int x = 0; x < (width*4); x++)
+        int size = width*height*4;
+
+        // Reuse a released capture pixel buffer if any, reallocated if too small
+        if (RLGL.State.capturePboCount > 0)
+        {
+            RLGL.State.capturePboCount--;
+            capture.pboId = RLGL.State.capturePboIds[RLGL.State.capturePboCount];
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pboId);
+            if (RLGL.State.capturePboSizes[RLGL.State.capturePboCount] < size) glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        }
+        else
         {
-            imgData[((height - 1) - y)*width*4 + x] = screenData[(y*width*4) + x];  // Flip line
+            glGenBuffers(1, &capture.pboId);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pboId);
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        }
+
+        // NOTE: With a pixel pack buffer bound, glReadPixels() returns immediately, data pointer is a buffer offset
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-            // Set alpha component value to 255 (no trasparent image retrieval)
-            // NOTE: Alpha value has already been applied to RGB in framebuffer, we don't need it!
-            if (((x + 1)%4) == 0) imgData[((height - 1) - y)*width*4 + x] = 255;
+        capture.fence = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        return capture;
+    }
+#endif
+
+    capture.pixels = rlReadScreenPixels(width, height);
+
+    return capture;
+}
+
+// Check if screen capture pixels are available, does not wait
+bool rlIsScreenCaptureReady(ScreenCapture capture)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (capture.fence != NULL)
+    {
+        // NOTE: Flushing makes sure the fence is submitted, it could never be signaled otherwise
+        GLenum result = glClientWaitSync((GLsync)capture.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        return (result == GL_ALREADY_SIGNALED) || (result == GL_CONDITION_SATISFIED) || (result == GL_WAIT_FAILED);
+    }
+#endif
+
+    return (capture.pboId != 0) || (capture.pixels != NULL);
+}
+
+// Get screen capture pixel data, flipped vertically with alpha set to 255 like rlReadScreenPixels()
+// NOTE: Waits for the GPU if pixels are not ready yet, capture is released (returned data should be freed)
+// NOTE: Returns NULL if pixels could not be read back
+unsigned char *rlGetScreenCapturePixels(ScreenCapture *capture)
+{
+    unsigned char *imgData = capture->pixels;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (capture->pboId != 0)
+    {
+        int lineSize = capture->width*4;
+        imgData = (unsigned char *)RL_MALLOC(lineSize*capture->height*sizeof(unsigned char));
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capture->pboId);
+        const unsigned char *mapped = (const unsigned char *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, lineSize*capture->height, GL_MAP_READ_BIT);
+
+        if ((mapped != NULL) && (imgData != NULL))
+        {
+            // Flip image vertically while copying out of the mapped buffer
+            for (int y = 0; y < capture->height; y++) memcpy(imgData + y*lineSize, mapped + (capture->height - 1 - y)*lineSize, lineSize);
+            rlSetPixelsOpaque(imgData, capture->width*capture->height);
+        }
+        else
+        {
+            // NOTE: Failing to map must not look like a black frame, no data is returned
+            TRACELOG(LOG_WARNING, "RLGL: Failed to map screen capture pixel buffer");
+            RL_FREE(imgData);
+            imgData = NULL;
         }
+
+        if (mapped != NULL) glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     }
+#endif
 
-    RL_FREE(screenData);
+    capture->pixels = NULL;     // Returned to caller
+    rlUnloadScreenCapture(*capture);
+    *capture = (ScreenCapture){ 0 };
 
     return imgData;     // NOTE: image data should be freed
 }
 
+// Release screen capture without reading its pixels
+// NOTE: Pixel buffer is kept for reuse by next captures (up to MAX_SCREEN_CAPTURE_BUFFERS)
+void rlUnloadScreenCapture(ScreenCapture capture)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (capture.fence != NULL) glDeleteSync((GLsync)capture.fence);
+    if (capture.pboId != 0)
+    {
+        if (RLGL.State.capturePboCount < MAX_SCREEN_CAPTURE_BUFFERS)
+        {
+            RLGL.State.capturePboIds[RLGL.State.capturePboCount] = capture.pboId;
+            RLGL.State.capturePboSizes[RLGL.State.capturePboCount] = capture.width*capture.height*4;
+            RLGL.State.capturePboCount++;
+        }
+        else glDeleteBuffers(1, &capture.pboId);
+    }
+#endif
+
+    RL_FREE(capture.pixels);
+}
+
 // Framebuffer management (fbo)
 //-----------------------------------------------------------------------------------------
 // Load a framebuffer to be used for rendering
@@ -3089,29 +4141,369 @@ void rlDisableVertexAttribute(unsigned int index)
 #endif
 }
 
-void rlDrawVertexArray(int offset, int count)
-{
-    glDrawArrays(GL_TRIANGLES, offset, count);
+void rlDrawVertexArray(int offset, int count)
+{
+    glDrawArrays(GL_TRIANGLES, offset, count);
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.drawCallsCounter++;
+    RLGL.State.renderStats.vertices += count;
+#endif
+}
+
+void rlDrawVertexArrayElements(int offset, int count, void *buffer)
+{
+    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (unsigned short*)buffer + offset);
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RLGL.State.drawCallsCounter++;
+    RLGL.State.renderStats.vertices += count;
+#endif
+}
+
+void rlDrawVertexArrayInstanced(int offset, int count, int instances)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    glDrawArraysInstanced(GL_TRIANGLES, 0, count, instances);
+    RLGL.State.drawCallsCounter++;
+    RLGL.State.renderStats.vertices += count*instances;
+#endif
+}
+
+void rlDrawVertexArrayElementsInstanced(int offset, int count, void *buffer, int instances)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (unsigned short*)buffer + offset, instances);
+    RLGL.State.drawCallsCounter++;
+    RLGL.State.renderStats.vertices += count*instances;
+#endif
+}
+
+// Draw sprites with a single instanced draw call
+// NOTE: Current render batch is drawn first to keep drawing order, sprites use the internal instanced
+// sprites shader, returns false (nothing drawn) if instancing is not supported or a custom shader is active
+bool rlDrawSpritesInstanced(unsigned int textureId, int textureWidth, int textureHeight, const SpriteInstance *sprites, int count)
+{
+    bool result = false;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.ExtSupported.instancing || (RLGL.State.currentShader.id != RLGL.State.defaultShader.id)) return result;
+    if ((count <= 0) || (textureId == 0)) return true;
+
+    rlDrawRenderBatch(RLGL.currentBatch);
+
+    if (RLGL.State.spriteShaderId == 0) rlLoadShaderSprites();
+    if (RLGL.State.spriteShaderId == 0) return result;
+
+    int *locs = RLGL.State.spriteShaderLocs;
+
+    rlStateUseProgram(RLGL.State.spriteShaderId);
+    glUniform2f(locs[6], (float)textureWidth, (float)textureHeight);
+    glUniform1f(locs[7], RLGL.currentBatch->currentDepth);
+    glUniform4f(locs[8], 1.0f, 1.0f, 1.0f, 1.0f);
+
+    if (RLGL.ExtSupported.vao) glBindVertexArray(RLGL.State.spriteVaoId);
+
+    // Quad corners, two triangles
+    glBindBuffer(GL_ARRAY_BUFFER, RLGL.State.spriteVboId);
+    glVertexAttribPointer(locs[0], 2, GL_FLOAT, 0, 0, 0);
+    glEnableVertexAttribArray(locs[0]);
+
+    // Instance data: destination, source, origin + rotation, color
+    rlLoadInstanceData(sprites, count*sizeof(SpriteInstance));
+    glVertexAttribPointer(locs[1], 4, GL_FLOAT, 0, sizeof(SpriteInstance), (void *)0);
+    glVertexAttribPointer(locs[2], 4, GL_FLOAT, 0, sizeof(SpriteInstance), (void *)(4*sizeof(float)));
+    glVertexAttribPointer(locs[3], 3, GL_FLOAT, 0, sizeof(SpriteInstance), (void *)(8*sizeof(float)));
+    glVertexAttribPointer(locs[4], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (void *)(11*sizeof(float)));
+
+    for (int i = 1; i <= 4; i++)
+    {
+        glEnableVertexAttribArray(locs[i]);
+        glVertexAttribDivisor(locs[i], 1);
+    }
+
+    rlStateActiveTexture(0);
+    rlStateBindTexture(GL_TEXTURE_2D, textureId);
+
+    Matrix matModelView = RLGL.State.modelview;
+    if (RLGL.State.transformRequired) matModelView = MatrixMultiply(RLGL.State.transform, matModelView);
+
+    int eyesCount = 1;
+    if (RLGL.State.stereoRender) eyesCount = 2;
+
+    for (int eye = 0; eye < eyesCount; eye++)
+    {
+        Matrix matMVP = MatrixMultiply(matModelView, RLGL.State.projection);
+
+        if (eyesCount == 2)
+        {
+            rlViewport(eye*RLGL.State.framebufferWidth/2, 0, RLGL.State.framebufferWidth/2, RLGL.State.framebufferHeight);
+            matMVP = MatrixMultiply(MatrixMultiply(matModelView, RLGL.State.viewOffsetStereo[eye]), RLGL.State.projectionStereo[eye]);
+        }
+
+        glUniformMatrix4fv(locs[5], 1, false, MatrixToFloat(matMVP));
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+        RLGL.State.drawCallsCounter++;
+        RLGL.State.renderStats.vertices += 6*count;
+    }
+
+    if (RLGL.ExtSupported.vao) glBindVertexArray(0);
+    else
+    {
+        // NOTE: Without VAO, divisors are global vertex attributes state, render batch draws use the same locations
+        for (int i = 1; i <= 4; i++) glVertexAttribDivisor(locs[i], 0);
+        for (int i = 0; i <= 4; i++) glDisableVertexAttribArray(locs[i]);
+    }
+
+    rlStateBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    rlStateUseProgram(0);
+
+    result = true;
+#endif
+
+    return result;
+}
+
+#if !defined(RLGL_STANDALONE)
+// Draw mesh instances with material and different transforms
+// NOTE: Same as DrawMeshInstanced() but instance transforms are uploaded into the internal instance buffer,
+// reused (orphaned) on every call instead of a new vertex buffer created and deleted every time
+void rlDrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, int instances)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!RLGL.ExtSupported.instancing || (instances <= 0)) return;
+
+    int locModel = material.shader.locs[SHADER_LOC_MATRIX_MODEL];
+
+    if (locModel == -1)
+    {
+        TRACELOG(LOG_WARNING, "SHADER: [ID %i] Instance transform attribute location not set (SHADER_LOC_MATRIX_MODEL)", material.shader.id);
+        return;
+    }
+
+    // Bind shader program and send material data (colors, matrices, texture maps)
+    rlEnableMaterial(material);
+
+    // Convert instances transformations to column-major float arrays
+    if (RLGL.State.instanceTransformsCount < instances)
+    {
+        RL_FREE(RLGL.State.instanceTransforms);
+        RLGL.State.instanceTransforms = (float *)RL_MALLOC(instances*16*sizeof(float));
+        RLGL.State.instanceTransformsCount = instances;
+    }
+
+    for (int i = 0; i < instances; i++)
+    {
+        float16 mat = MatrixToFloatV(transforms[i]);
+        memcpy(RLGL.State.instanceTransforms + 16*i, mat.v, 16*sizeof(float));
+    }
+
+    // Bind mesh vertex data and attach internal instance buffer to it
+    // Instances transformation matrices are send to shader attribute location: SHADER_LOC_MATRIX_MODEL
+    rlEnableMeshBuffers(mesh, material.shader);
+    rlLoadInstanceData(RLGL.State.instanceTransforms, instances*16*sizeof(float));
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        rlEnableVertexAttribute(locModel + i);
+        rlSetVertexAttribute(locModel + i, 4, RL_FLOAT, 0, sizeof(Matrix), (void *)(i*4*sizeof(float)));
+        rlSetVertexAttributeDivisor(locModel + i, 1);
+    }
+
+    // Accumulate internal matrix transform (push/pop) and view matrix
+    // NOTE: At this point the modelview matrix just contains the view matrix (camera)
+    Matrix matModelView = MatrixMultiply(rlGetMatrixTransform(), RLGL.State.modelview);
+
+    rlDrawMeshBuffers(mesh, material.shader, matModelView, instances);
+
+    // Detach instance buffer, mesh VAO (or global vertex attributes state) could be drawn without instancing
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        rlSetVertexAttributeDivisor(locModel + i, 0);
+        rlDisableVertexAttribute(locModel + i);
+    }
+
+    rlDisableMeshBuffers();
+    rlDisableMaterial();
+#endif
+}
+#endif
+
+#if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)) && !defined(RLGL_STANDALONE)
+// Enable material shader and send material data: colors, view/projection/normal matrices and texture maps
+// NOTE: Mesh drawing steps of rlDrawMeshInstanced(), same as DrawMeshInstanced() in models.c
+static void rlEnableMaterial(Material material)
+{
+    // Bind shader program
+    rlEnableShader(material.shader.id);
+
+    // Upload to shader material.colDiffuse
+    if (material.shader.locs[SHADER_LOC_COLOR_DIFFUSE] != -1)
+    {
+        float values[4] = {
+            (float)material.maps[MATERIAL_MAP_DIFFUSE].color.r/255.0f,
+            (float)material.maps[MATERIAL_MAP_DIFFUSE].color.g/255.0f,
+            (float)material.maps[MATERIAL_MAP_DIFFUSE].color.b/255.0f,
+            (float)material.maps[MATERIAL_MAP_DIFFUSE].color.a/255.0f
+        };
+
+        rlSetUniform(material.shader.locs[SHADER_LOC_COLOR_DIFFUSE], values, SHADER_UNIFORM_VEC4, 1);
+    }
+
+    // Upload to shader material.colSpecular (if location available)
+    if (material.shader.locs[SHADER_LOC_COLOR_SPECULAR] != -1)
+    {
+        float values[4] = {
+            (float)material.maps[MATERIAL_MAP_SPECULAR].color.r/255.0f,
+            (float)material.maps[MATERIAL_MAP_SPECULAR].color.g/255.0f,
+            (float)material.maps[MATERIAL_MAP_SPECULAR].color.b/255.0f,
+            (float)material.maps[MATERIAL_MAP_SPECULAR].color.a/255.0f
+        };
+
+        rlSetUniform(material.shader.locs[SHADER_LOC_COLOR_SPECULAR], values, SHADER_UNIFORM_VEC4, 1);
+    }
+
+    // Upload view and projection matrices (if locations available)
+    if (material.shader.locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_VIEW], RLGL.State.modelview);
+    if (material.shader.locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_PROJECTION], RLGL.State.projection);
+
+    // Upload model normal matrix (if locations available)
+    // NOTE: Model transformation is done per instance in the shader, model matrix is identity here
+    if (material.shader.locs[SHADER_LOC_MATRIX_NORMAL] != -1) rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_NORMAL], MatrixIdentity());
+
+    // Bind active texture maps (if available)
+    for (int i = 0; i < MAX_MATERIAL_MAPS; i++)
+    {
+        if (material.maps[i].texture.id > 0)
+        {
+            // Select current shader texture slot
+            rlActiveTextureSlot(i);
+
+            // Enable texture for active slot
+            if ((i == MATERIAL_MAP_IRRADIANCE) ||
+                (i == MATERIAL_MAP_PREFILTER) ||
+                (i == MATERIAL_MAP_CUBEMAP)) rlEnableTextureCubemap(material.maps[i].texture.id);
+            else rlEnableTexture(material.maps[i].texture.id);
+
+            rlSetUniform(material.shader.locs[SHADER_LOC_MAP_DIFFUSE + i], (int *)&i, SHADER_UNIFORM_INT, 1);
+        }
+    }
+}
+
+// Unbind all material texture maps and disable shader program
+static void rlDisableMaterial(void)
+{
+    for (int i = 0; i < MAX_MATERIAL_MAPS; i++)
+    {
+        // Select current shader texture slot
+        rlActiveTextureSlot(i);
+
+        // Disable texture for active slot
+        if ((i == MATERIAL_MAP_IRRADIANCE) ||
+            (i == MATERIAL_MAP_PREFILTER) ||
+            (i == MATERIAL_MAP_CUBEMAP)) rlDisableTextureCubemap();
+        else rlDisableTexture();
+    }
+
+    rlDisableShader();
+}
+
+// Bind mesh vertex data to shader attributes: mesh VAO if available or mesh VBOs otherwise
+static void rlEnableMeshBuffers(Mesh mesh, Shader shader)
+{
+    // Try binding vertex array objects (VAO) or use VBOs if not possible
+    if (rlEnableVertexArray(mesh.vaoId)) return;
+
+    // Bind mesh VBO data: vertex position (shader-location = 0)
+    rlEnableVertexBuffer(mesh.vboId[0]);
+    rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_POSITION], 3, RL_FLOAT, 0, 0, 0);
+    rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_POSITION]);
+
+    // Bind mesh VBO data: vertex texcoords (shader-location = 1)
+    rlEnableVertexBuffer(mesh.vboId[1]);
+    rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, 0, 0, 0);
+    rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+
+    if (shader.locs[SHADER_LOC_VERTEX_NORMAL] != -1)
+    {
+        // Bind mesh VBO data: vertex normals (shader-location = 2)
+        rlEnableVertexBuffer(mesh.vboId[2]);
+        rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_NORMAL], 3, RL_FLOAT, 0, 0, 0);
+        rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_NORMAL]);
+    }
+
+    // Bind mesh VBO data: vertex colors (shader-location = 3, if available)
+    if (shader.locs[SHADER_LOC_VERTEX_COLOR] != -1)
+    {
+        if (mesh.vboId[3] != 0)
+        {
+            rlEnableVertexBuffer(mesh.vboId[3]);
+            rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, 1, 0, 0);
+            rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_COLOR]);
+        }
+        else
+        {
+            // Set default value for unused attribute
+            // NOTE: Required when using default shader and no VAO support
+            float value[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            rlSetVertexAttributeDefault(shader.locs[SHADER_LOC_VERTEX_COLOR], value, SHADER_ATTRIB_VEC4, 4);
+            rlDisableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_COLOR]);
+        }
+    }
+
+    // Bind mesh VBO data: vertex tangents (shader-location = 4, if available)
+    if (shader.locs[SHADER_LOC_VERTEX_TANGENT] != -1)
+    {
+        rlEnableVertexBuffer(mesh.vboId[4]);
+        rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TANGENT], 4, RL_FLOAT, 0, 0, 0);
+        rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TANGENT]);
+    }
+
+    // Bind mesh VBO data: vertex texcoords2 (shader-location = 5, if available)
+    if (shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] != -1)
+    {
+        rlEnableVertexBuffer(mesh.vboId[5]);
+        rlSetVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TEXCOORD02], 2, RL_FLOAT, 0, 0, 0);
+        rlEnableVertexAttribute(shader.locs[SHADER_LOC_VERTEX_TEXCOORD02]);
+    }
+
+    if (mesh.indices != NULL) rlEnableVertexBufferElement(mesh.vboId[6]);
 }
 
-void rlDrawVertexArrayElements(int offset, int count, void *buffer)
+// Disable all possible vertex array objects (or VBOs)
+static void rlDisableMeshBuffers(void)
 {
-    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (unsigned short*)buffer + offset);
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
 }
 
-void rlDrawVertexArrayInstanced(int offset, int count, int instances)
+// Draw bound mesh buffers instances for every eye (stereo rendering)
+static void rlDrawMeshBuffers(Mesh mesh, Shader shader, Matrix matModelView, int instances)
 {
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glDrawArraysInstanced(GL_TRIANGLES, 0, count, instances);
-#endif
-}
+    int eyesCount = 1;
+    if (RLGL.State.stereoRender) eyesCount = 2;
 
-void rlDrawVertexArrayElementsInstanced(int offset, int count, void *buffer, int instances)
-{
-#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (unsigned short*)buffer + offset, instances);
-#endif
+    for (int eye = 0; eye < eyesCount; eye++)
+    {
+        // Calculate model-view-projection matrix (MVP)
+        Matrix matModelViewProjection = MatrixIdentity();
+        if (eyesCount == 1) matModelViewProjection = MatrixMultiply(matModelView, RLGL.State.projection);
+        else
+        {
+            // Setup current eye viewport (half screen width)
+            rlViewport(eye*RLGL.State.framebufferWidth/2, 0, RLGL.State.framebufferWidth/2, RLGL.State.framebufferHeight);
+            matModelViewProjection = MatrixMultiply(MatrixMultiply(matModelView, RLGL.State.viewOffsetStereo[eye]), RLGL.State.projectionStereo[eye]);
+        }
+
+        // Send combined model-view-projection matrix to shader
+        rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], matModelViewProjection);
+
+        // Draw mesh instanced
+        if (mesh.indices != NULL) rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount*3, 0, instances);
+        else rlDrawVertexArrayInstanced(0, mesh.vertexCount, instances);
+    }
 }
+#endif
 
 #if defined(GRAPHICS_API_OPENGL_11)
 void rlEnableStatePointer(int vertexAttribType, void *buffer)
@@ -3796,7 +5188,7 @@ static void rlLoadShaderDefault(void)
 // NOTE: It uses global variable: RLGL.State.defaultShader
 static void rlUnloadShaderDefault(void)
 {
-    glUseProgram(0);
+    rlStateUseProgram(0);
 
     glDetachShader(RLGL.State.defaultShader.id, RLGL.State.defaultVShaderId);
     glDetachShader(RLGL.State.defaultShader.id, RLGL.State.defaultFShaderId);
@@ -3810,6 +5202,364 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShader.id);
 }
 
+// Load render batch vertex data into currently bound VBO (GL_ARRAY_BUFFER)
+// NOTE: On RL_BATCH_UPLOAD_PERSISTENT, buffer storage is kept mapped and provided CPU data is freed,
+// data is replaced by the mapped pointer, used to write vertex data
+// WARNING: If mapping fails, false is returned and data is kept, but buffer storage is immutable,
+// it can't be used with other upload modes and must be deleted
+static bool rlLoadBatchBufferStorage(void **data, int size, int uploadMode)
+{
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(__APPLE__)
+    if (uploadMode == RL_BATCH_UPLOAD_PERSISTENT)
+    {
+        // NOTE: GL_MAP_READ_BIT is required, rlEnd() reads previous colors to fill missing ones
+        GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(GL_ARRAY_BUFFER, size, *data, flags);
+        void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+
+        if (mapped == NULL) return false;
+
+        RL_FREE(*data);
+        *data = mapped;
+        return true;
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, size, *data, GL_DYNAMIC_DRAW);
+
+    return true;
+}
+
+// Sort render batch draw calls by layer, texture and mode, merging consecutive ones sharing them
+// NOTE: Sorting is stable, submission order is kept for draws sharing the same key, vertex data is
+// reordered to match the new draw calls, only first drawsCount draw calls are processed (current one is
+// excluded while still being filled) and empty ones are dropped; returns the resulting draw calls count
+// WARNING: Shader is not part of the key, shader changes already force a batch draw (see DrawCall)
+static int rlSortRenderBatch(RenderBatch *batch, int drawsCount)
+{
+    VertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+    int order[DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int offsets[DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    DrawCall draws[DEFAULT_BATCH_DRAWCALLS] = { 0 };
+
+    // Stable insertion sort (draws count is small), also registers vertex offset of every draw call
+    for (int i = 0, offset = 0; i < drawsCount; i++)
+    {
+        DrawCall *draw = &batch->draws[i];
+        int j = i;
+
+        while (j > 0)
+        {
+            DrawCall *prev = &batch->draws[order[j - 1]];
+
+            if ((prev->layer < draw->layer) || ((prev->layer == draw->layer) && ((prev->textureId < draw->textureId) ||
+                ((prev->textureId == draw->textureId) && (prev->mode <= draw->mode))))) break;
+
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        order[j] = i;
+        offsets[i] = offset;
+        offset += (draw->vertexCount + draw->vertexAlignment);
+    }
+
+    if (RLGL.State.sortBufferSize < buffer->elementsCount*4)
+    {
+        RL_FREE(RLGL.State.sortBuffer);
+        RLGL.State.sortBuffer = (BatchVertex *)RL_MALLOC(buffer->elementsCount*4*sizeof(BatchVertex));
+        RLGL.State.sortBufferSize = buffer->elementsCount*4;
+    }
+
+    // Gather vertex data in sorted order, merging draw calls with same key
+    int count = 0;
+    int vCounter = 0;
+
+    for (int i = 0; i < drawsCount; i++)
+    {
+        DrawCall *draw = &batch->draws[order[i]];
+        int offset = offsets[order[i]];
+
+        if (draw->vertexCount == 0) continue;
+
+        if ((count > 0) && (draws[count - 1].layer == draw->layer) &&
+            (draws[count - 1].textureId == draw->textureId) && (draws[count - 1].mode == draw->mode))
+        {
+            draws[count - 1].vertexCount += draw->vertexCount;
+        }
+        else
+        {
+            // Close previous draw call, aligned the same way rlBegin()/rlSetTexture() do
+            if (count > 0) vCounter += (draws[count - 1].vertexAlignment = rlGetDrawCallAlignment(&draws[count - 1]));
+
+            draws[count] = *draw;
+            count++;
+        }
+
+        BatchVertex *dest = RLGL.State.sortBuffer + vCounter;
+
+        if (batch->layout == RL_BATCH_LAYOUT_INTERLEAVED) memcpy(dest, buffer->interleaved + offset, draw->vertexCount*sizeof(BatchVertex));
+        else
+        {
+            for (int k = 0; k < draw->vertexCount; k++)
+            {
+                dest[k].x = buffer->vertices[3*(offset + k)];
+                dest[k].y = buffer->vertices[3*(offset + k) + 1];
+                dest[k].z = buffer->vertices[3*(offset + k) + 2];
+                dest[k].u = buffer->texcoords[2*(offset + k)];
+                dest[k].v = buffer->texcoords[2*(offset + k) + 1];
+                dest[k].r = buffer->colors[4*(offset + k)];
+                dest[k].g = buffer->colors[4*(offset + k) + 1];
+                dest[k].b = buffer->colors[4*(offset + k) + 2];
+                dest[k].a = buffer->colors[4*(offset + k) + 3];
+            }
+        }
+
+        vCounter += draw->vertexCount;
+    }
+
+    // Copy back sorted vertex data (alignment vertex are not copied, they are never drawn)
+    if (batch->layout == RL_BATCH_LAYOUT_INTERLEAVED) memcpy(buffer->interleaved, RLGL.State.sortBuffer, vCounter*sizeof(BatchVertex));
+    else
+    {
+        for (int k = 0; k < vCounter; k++)
+        {
+            BatchVertex *vertex = &RLGL.State.sortBuffer[k];
+
+            buffer->vertices[3*k] = vertex->x;
+            buffer->vertices[3*k + 1] = vertex->y;
+            buffer->vertices[3*k + 2] = vertex->z;
+            buffer->texcoords[2*k] = vertex->u;
+            buffer->texcoords[2*k + 1] = vertex->v;
+            buffer->colors[4*k] = vertex->r;
+            buffer->colors[4*k + 1] = vertex->g;
+            buffer->colors[4*k + 2] = vertex->b;
+            buffer->colors[4*k + 3] = vertex->a;
+        }
+    }
+
+    if (count > 0) vCounter += (draws[count - 1].vertexAlignment = rlGetDrawCallAlignment(&draws[count - 1]));
+
+    buffer->vCounter = vCounter;
+    buffer->tcCounter = vCounter;
+    buffer->cCounter = vCounter;
+
+    // Store resulting draw calls, reset the released ones (and current one) as rlDrawRenderBatch() does
+    for (int i = 0; i < count; i++) batch->draws[i] = draws[i];
+    for (int i = count; (i <= drawsCount) && (i < DEFAULT_BATCH_DRAWCALLS); i++)
+    {
+        batch->draws[i].mode = RL_QUADS;
+        batch->draws[i].vertexCount = 0;
+        batch->draws[i].vertexAlignment = 0;
+        batch->draws[i].textureId = RLGL.State.defaultTextureId;
+        batch->draws[i].layer = RLGL.State.drawLayer;
+    }
+
+    return count;
+}
+
+// Get number of vertex required after a draw call to keep next one aligned for QUADS index processing
+static int rlGetDrawCallAlignment(const DrawCall *draw)
+{
+    int alignment = 0;
+
+    if (draw->mode == RL_LINES) alignment = ((draw->vertexCount < 4)? draw->vertexCount : draw->vertexCount%4);
+    else if (draw->mode == RL_TRIANGLES) alignment = ((draw->vertexCount < 4)? 1 : (4 - (draw->vertexCount%4)));
+
+    return alignment;
+}
+
+// Record render batch vertex data and draw calls into command list being recorded
+// NOTE: QUADS are converted to TRIANGLES (no index buffer required), alignment vertex are skipped and
+// consecutive draw calls with same texture and mode are merged
+static void rlRecordRenderBatch(RenderBatch *batch)
+{
+    // QUADS vertex indices, same as render batch index buffer
+    static const int quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    VertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+
+    // Worst case: every vertex is part of a QUAD, 6 vertex recorded for every 4
+    int required = RLGL.State.listVertexCount + buffer->vCounter/4*6 + 6;
+    if (required > RLGL.State.listVertexCapacity)
+    {
+        int capacity = (required > 2*RLGL.State.listVertexCapacity)? required : 2*RLGL.State.listVertexCapacity;
+        BatchVertex *vertices = (BatchVertex *)RL_REALLOC(RLGL.State.listVertices, capacity*sizeof(BatchVertex));
+        if (vertices == NULL) return;
+
+        RLGL.State.listVertices = vertices;
+        RLGL.State.listVertexCapacity = capacity;
+    }
+
+    if (RLGL.State.listDrawsCount + batch->drawsCounter > RLGL.State.listDrawsCapacity)
+    {
+        int capacity = RLGL.State.listDrawsCount + batch->drawsCounter;
+        if (capacity < 2*RLGL.State.listDrawsCapacity) capacity = 2*RLGL.State.listDrawsCapacity;
+        DrawCall *draws = (DrawCall *)RL_REALLOC(RLGL.State.listDraws, capacity*sizeof(DrawCall));
+        if (draws == NULL) return;
+
+        RLGL.State.listDraws = draws;
+        RLGL.State.listDrawsCapacity = capacity;
+    }
+
+    for (int i = 0, offset = 0; i < batch->drawsCounter; i++)
+    {
+        DrawCall *draw = &batch->draws[i];
+        int start = offset;
+        offset += (draw->vertexCount + draw->vertexAlignment);
+
+        if (draw->vertexCount == 0) continue;
+
+        int mode = (draw->mode == RL_QUADS)? RL_TRIANGLES : draw->mode;
+        int count = (draw->mode == RL_QUADS)? draw->vertexCount/4*6 : draw->vertexCount;
+
+        DrawCall *last = (RLGL.State.listDrawsCount > 0)? &RLGL.State.listDraws[RLGL.State.listDrawsCount - 1] : NULL;
+        if ((last != NULL) && (last->mode == mode) && (last->textureId == draw->textureId)) last->vertexCount += count;
+        else
+        {
+            DrawCall *recorded = &RLGL.State.listDraws[RLGL.State.listDrawsCount++];
+            *recorded = *draw;
+            recorded->mode = mode;
+            recorded->vertexCount = count;
+            recorded->vertexAlignment = 0;
+        }
+
+        BatchVertex *dest = RLGL.State.listVertices + RLGL.State.listVertexCount;
+        RLGL.State.listVertexCount += count;
+
+        for (int k = 0; k < count; k++)
+        {
+            int index = start + k;
+            if (draw->mode == RL_QUADS) index = start + 4*(k/6) + quadIndices[k%6];
+
+            if (batch->layout == RL_BATCH_LAYOUT_INTERLEAVED) dest[k] = buffer->interleaved[index];
+            else
+            {
+                dest[k].x = buffer->vertices[3*index];
+                dest[k].y = buffer->vertices[3*index + 1];
+                dest[k].z = buffer->vertices[3*index + 2];
+                dest[k].u = buffer->texcoords[2*index];
+                dest[k].v = buffer->texcoords[2*index + 1];
+                dest[k].r = buffer->colors[4*index];
+                dest[k].g = buffer->colors[4*index + 1];
+                dest[k].b = buffer->colors[4*index + 2];
+                dest[k].a = buffer->colors[4*index + 3];
+            }
+        }
+    }
+}
+
+// Load instance data into internal instance buffer, left bound as GL_ARRAY_BUFFER
+// NOTE: Buffer is orphaned on every upload (or grown if required), previous draws can still read
+// the old storage while the new data is uploaded, no new buffer is created per draw
+static void rlLoadInstanceData(const void *data, int size)
+{
+    if (RLGL.State.instanceVboId == 0) glGenBuffers(1, &RLGL.State.instanceVboId);
+
+    glBindBuffer(GL_ARRAY_BUFFER, RLGL.State.instanceVboId);
+
+    if (size > RLGL.State.instanceBufferSize)
+    {
+        RLGL.State.instanceBufferSize = (size > 2*RLGL.State.instanceBufferSize)? size : 2*RLGL.State.instanceBufferSize;
+        TRACELOG(LOG_DEBUG, "VBO: [ID %i] Instance buffer resized (%i bytes)", RLGL.State.instanceVboId, RLGL.State.instanceBufferSize);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, RLGL.State.instanceBufferSize, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    RLGL.State.renderStats.bytesUploaded += size;
+}
+
+// Load instanced sprites shader and quad corners buffer
+// NOTE: Default fragment shader is reused, locations: [0] vertexPosition (quad corner), [1] instanceDest,
+// [2] instanceSource, [3] instanceOrigin (origin + rotation), [4] instanceColor, [5] mvp, [6] textureSize,
+// [7] depth, [8] colDiffuse
+static void rlLoadShaderSprites(void)
+{
+    const char *vShaderSprites =
+#if defined(GRAPHICS_API_OPENGL_21)
+    "#version 120                       \n"
+    "attribute vec2 vertexPosition;     \n"
+    "attribute vec4 instanceDest;       \n"
+    "attribute vec4 instanceSource;     \n"
+    "attribute vec3 instanceOrigin;     \n"
+    "attribute vec4 instanceColor;      \n"
+    "varying vec2 fragTexCoord;         \n"
+    "varying vec4 fragColor;            \n"
+#elif defined(GRAPHICS_API_OPENGL_33)
+    "#version 330                       \n"
+    "in vec2 vertexPosition;            \n"
+    "in vec4 instanceDest;              \n"
+    "in vec4 instanceSource;            \n"
+    "in vec3 instanceOrigin;            \n"
+    "in vec4 instanceColor;             \n"
+    "out vec2 fragTexCoord;             \n"
+    "out vec4 fragColor;                \n"
+#endif
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    "#version 100                       \n"
+    "attribute vec2 vertexPosition;     \n"
+    "attribute vec4 instanceDest;       \n"
+    "attribute vec4 instanceSource;     \n"
+    "attribute vec3 instanceOrigin;     \n"
+    "attribute vec4 instanceColor;      \n"
+    "varying vec2 fragTexCoord;         \n"
+    "varying vec4 fragColor;            \n"
+#endif
+    "uniform mat4 mvp;                  \n"
+    "uniform vec2 textureSize;          \n"
+    "uniform float depth;               \n"
+    "void main()                        \n"
+    "{                                  \n"
+    "    vec4 source = instanceSource;  \n"     // Same texcoords as DrawTexturePro(), flipped if negative size
+    "    float flipX = (source.z < 0.0)? 1.0 : 0.0; \n"
+    "    source.z = abs(source.z);      \n"
+    "    if (source.w < 0.0) source.y -= source.w; \n"
+    "    vec2 corner = vec2(mix(vertexPosition.x, 1.0 - vertexPosition.x, flipX), vertexPosition.y); \n"
+    "    fragTexCoord = (source.xy + corner*source.zw)/textureSize; \n"
+    "    fragColor = instanceColor;     \n"
+    "    vec2 local = vertexPosition*instanceDest.zw - instanceOrigin.xy; \n"
+    "    float angle = radians(instanceOrigin.z); \n"
+    "    vec2 rotated = vec2(local.x*cos(angle) - local.y*sin(angle), local.x*sin(angle) + local.y*cos(angle)); \n"
+    "    gl_Position = mvp*vec4(instanceDest.xy + rotated, depth, 1.0); \n"
+    "}                                  \n";
+
+    unsigned int vShaderId = rlCompileShader(vShaderSprites, GL_VERTEX_SHADER);
+    if (vShaderId == 0) return;
+
+    RLGL.State.spriteShaderId = rlLoadShaderProgram(vShaderId, RLGL.State.defaultFShaderId);
+    glDetachShader(RLGL.State.spriteShaderId, vShaderId);
+    glDetachShader(RLGL.State.spriteShaderId, RLGL.State.defaultFShaderId);
+    glDeleteShader(vShaderId);
+
+    if (RLGL.State.spriteShaderId == 0) return;
+
+    int *locs = RLGL.State.spriteShaderLocs;
+    locs[0] = glGetAttribLocation(RLGL.State.spriteShaderId, "vertexPosition");
+    locs[1] = glGetAttribLocation(RLGL.State.spriteShaderId, "instanceDest");
+    locs[2] = glGetAttribLocation(RLGL.State.spriteShaderId, "instanceSource");
+    locs[3] = glGetAttribLocation(RLGL.State.spriteShaderId, "instanceOrigin");
+    locs[4] = glGetAttribLocation(RLGL.State.spriteShaderId, "instanceColor");
+    locs[5] = glGetUniformLocation(RLGL.State.spriteShaderId, "mvp");
+    locs[6] = glGetUniformLocation(RLGL.State.spriteShaderId, "textureSize");
+    locs[7] = glGetUniformLocation(RLGL.State.spriteShaderId, "depth");
+    locs[8] = glGetUniformLocation(RLGL.State.spriteShaderId, "colDiffuse");
+
+    rlStateUseProgram(RLGL.State.spriteShaderId);
+    glUniform1i(glGetUniformLocation(RLGL.State.spriteShaderId, "texture0"), 0);
+    rlStateUseProgram(0);
+
+    // Quad corners: top-left, bottom-left, bottom-right / top-left, bottom-right, top-right
+    float corners[12] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f };
+
+    if (RLGL.ExtSupported.vao) glGenVertexArrays(1, &RLGL.State.spriteVaoId);
+    glGenBuffers(1, &RLGL.State.spriteVboId);
+    glBindBuffer(GL_ARRAY_BUFFER, RLGL.State.spriteVboId);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    TRACELOG(LOG_INFO, "SHADER: [ID %i] Instanced sprites shader loaded successfully", RLGL.State.spriteShaderId);
+}
+
 #if defined(SUPPORT_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static char *rlGetCompressedFormatName(int format)
@@ -4021,6 +5771,369 @@ static Color *rlGenNextMipmapData(Color *srcData, int srcWidth, int srcHeight)
 }
 #endif  // GRAPHICS_API_OPENGL_11
 
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+// Use shader program, skipped if already in use
+static void rlStateUseProgram(unsigned int id)
+{
+    if (RLGL.GLState.program == (int)id) { RLGL.GLState.elidedCalls++; return; }
+
+    glUseProgram(id);
+    RLGL.GLState.program = (int)id;
+    RLGL.GLState.issuedCalls++;
+}
+
+// Select active texture slot, skipped if already active
+static void rlStateActiveTexture(int slot)
+{
+    if (RLGL.GLState.activeSlot == slot) { RLGL.GLState.elidedCalls++; return; }
+
+    glActiveTexture(GL_TEXTURE0 + slot);
+    RLGL.GLState.activeSlot = slot;
+    RLGL.GLState.issuedCalls++;
+}
+#endif
+
+// Bind texture to active texture slot, skipped if already bound
+// NOTE: Bindings on slots over MAX_STATE_CACHE_TEXTURE_SLOTS (or unknown active slot) are always issued
+static void rlStateBindTexture(unsigned int target, unsigned int id)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    int slot = RLGL.GLState.activeSlot;
+    int *bound = NULL;
+
+    if ((slot >= 0) && (slot < MAX_STATE_CACHE_TEXTURE_SLOTS))
+    {
+        if (target == GL_TEXTURE_2D) bound = &RLGL.GLState.texture2D[slot];
+        else if (target == GL_TEXTURE_CUBE_MAP) bound = &RLGL.GLState.textureCubemap[slot];
+    }
+
+    if ((bound != NULL) && (*bound == (int)id)) { RLGL.GLState.elidedCalls++; return; }
+
+    glBindTexture(target, id);
+    if (bound != NULL) *bound = (int)id;
+    RLGL.GLState.issuedCalls++;
+#else
+    glBindTexture(target, id);
+#endif
+}
+
+// Delete texture, removing it from cached bindings
+// NOTE: Deleted texture is unbound from every slot by GL, its id can be reused by next texture
+static void rlStateDeleteTexture(unsigned int id)
+{
+    glDeleteTextures(1, &id);
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    for (int i = 0; i < MAX_STATE_CACHE_TEXTURE_SLOTS; i++)
+    {
+        if (RLGL.GLState.texture2D[i] == (int)id) RLGL.GLState.texture2D[i] = 0;
+        if (RLGL.GLState.textureCubemap[i] == (int)id) RLGL.GLState.textureCubemap[i] = 0;
+    }
+#endif
+}
+
+// Enable/disable GL capability, skipped if already set
+static void rlStateSetCapability(unsigned int cap, bool enabled)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    int *current = NULL;
+
+    switch (cap)
+    {
+        case GL_DEPTH_TEST: current = &RLGL.GLState.depthTest; break;
+        case GL_BLEND: current = &RLGL.GLState.blend; break;
+        case GL_CULL_FACE: current = &RLGL.GLState.cullFace; break;
+        case GL_SCISSOR_TEST: current = &RLGL.GLState.scissorTest; break;
+        default: break;
+    }
+
+    if ((current != NULL) && (*current == (int)enabled)) { RLGL.GLState.elidedCalls++; return; }
+    if (current != NULL) *current = (int)enabled;
+    RLGL.GLState.issuedCalls++;
+#endif
+
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+}
+
+#if defined(RLGL_NULL_BACKEND)
+// Null backend OpenGL functions
+// NOTE: Only functions used by rlgl on OpenGL 3.3 are provided, queries return a working OpenGL 3.3 device
+// with no extension (no persistent mapped buffers), texture and pixels readbacks leave data untouched
+// and mapped buffers read as zeros
+static unsigned int rlNullGenId(void) { return ++RLNULL.nextId; }
+static void APIENTRY rlNullGenObjects(GLsizei n, GLuint *ids) { for (int i = 0; i < n; i++) ids[i] = rlNullGenId(); }
+static void APIENTRY rlNullDeleteObjects(GLsizei n, const GLuint *ids) { }
+
+static const GLubyte *APIENTRY rlNullGetString(GLenum name)
+{
+    switch (name)
+    {
+        case GL_VENDOR: return (const GLubyte *)"raylib";
+        case GL_RENDERER: return (const GLubyte *)"rlgl null backend";
+        case GL_VERSION: return (const GLubyte *)"3.3.0 rlgl null backend";
+        case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte *)"3.30";
+        default: return (const GLubyte *)"";
+    }
+}
+static const GLubyte *APIENTRY rlNullGetStringi(GLenum name, GLuint index) { return (const GLubyte *)"GL_RLGL_null_backend"; }
+static void APIENTRY rlNullGetIntegerv(GLenum pname, GLint *data)
+{
+    // NOTE: Unknown values are left untouched, they could be arrays of unknown size
+    switch (pname)
+    {
+        case GL_NUM_EXTENSIONS: *data = 1; break;       // GLAD requires at least one extension
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_CUBE_MAP_TEXTURE_SIZE: *data = 16384; break;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS: *data = 16; break;
+        case GL_MAX_DRAW_BUFFERS: *data = 8; break;
+        default: break;
+    }
+}
+static void APIENTRY rlNullGetFloatv(GLenum pname, GLfloat *data)
+{
+    if (pname == GL_LINE_WIDTH) *data = (RLNULL.lineWidth > 0.0f)? RLNULL.lineWidth : 1.0f;
+    else if (pname == 0x84FF) *data = 16.0f;           // GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+}
+static GLenum APIENTRY rlNullGetError(void) { return GL_NO_ERROR; }
+
+static void APIENTRY rlNullSetCapability(GLenum cap) { }
+static void APIENTRY rlNullSetEnum(GLenum value) { }
+static void APIENTRY rlNullSetEnum2(GLenum a, GLenum b) { }
+static void APIENTRY rlNullSetBoolean(GLboolean flag) { }
+static void APIENTRY rlNullSetRect(GLint x, GLint y, GLsizei width, GLsizei height) { }
+static void APIENTRY rlNullClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { }
+static void APIENTRY rlNullClearDepth(GLdouble depth) { }
+static void APIENTRY rlNullLineWidth(GLfloat width) { RLNULL.lineWidth = width; }
+static void APIENTRY rlNullPixelStorei(GLenum pname, GLint param) { }
+static void APIENTRY rlNullClear(GLbitfield mask) { rlNullRecord(RL_NULL_COMMAND_CLEAR, mask, 0, 0, 0, 0); }
+
+// Textures
+static void APIENTRY rlNullActiveTexture(GLenum texture) { RLNULL.activeSlot = (texture - GL_TEXTURE0)%32; }
+static void APIENTRY rlNullBindTexture(GLenum target, GLuint texture) { if (target == GL_TEXTURE_2D) RLNULL.texture2D[RLNULL.activeSlot] = texture; }
+static void APIENTRY rlNullTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+    if (pixels != NULL) rlNullRecord(RL_NULL_COMMAND_TEXTURE_UPLOAD, target, RLNULL.texture2D[RLNULL.activeSlot], width*height, 1, 0);
+}
+static void APIENTRY rlNullTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+    rlNullRecord(RL_NULL_COMMAND_TEXTURE_UPLOAD, target, RLNULL.texture2D[RLNULL.activeSlot], width*height, 1, 0);
+}
+static void APIENTRY rlNullCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+    rlNullRecord(RL_NULL_COMMAND_TEXTURE_UPLOAD, target, RLNULL.texture2D[RLNULL.activeSlot], width*height, 1, imageSize);
+}
+static void APIENTRY rlNullTexParameteri(GLenum target, GLenum pname, GLint param) { }
+static void APIENTRY rlNullTexParameteriv(GLenum target, GLenum pname, const GLint *params) { }
+static void APIENTRY rlNullTexParameterf(GLenum target, GLenum pname, GLfloat param) { }
+static void APIENTRY rlNullGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels) { }
+static void APIENTRY rlNullReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) { }
+
+// Buffers and vertex arrays
+static void APIENTRY rlNullBindBuffer(GLenum target, GLuint buffer)
+{
+    if (target == GL_ARRAY_BUFFER) RLNULL.arrayBuffer = buffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER) RLNULL.elementBuffer = buffer;
+}
+static unsigned int rlNullBoundBuffer(GLenum target) { return (target == GL_ELEMENT_ARRAY_BUFFER)? RLNULL.elementBuffer : RLNULL.arrayBuffer; }
+static void APIENTRY rlNullBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    if (data != NULL) rlNullRecord(RL_NULL_COMMAND_BUFFER_UPLOAD, target, rlNullBoundBuffer(target), 0, 1, (int)size);
+}
+static void APIENTRY rlNullBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    rlNullRecord(RL_NULL_COMMAND_BUFFER_UPLOAD, target, rlNullBoundBuffer(target), 0, 1, (int)size);
+}
+static void *APIENTRY rlNullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    if (length > RLNULL.mappedSize)
+    {
+        RL_FREE(RLNULL.mapped);
+        RLNULL.mapped = (unsigned char *)RL_MALLOC(length);
+        RLNULL.mappedSize = (RLNULL.mapped != NULL)? (int)length : 0;
+    }
+    if (RLNULL.mapped != NULL) memset(RLNULL.mapped, 0, length);
+
+    return RLNULL.mapped;
+}
+static GLboolean APIENTRY rlNullUnmapBuffer(GLenum target) { return GL_TRUE; }
+static void APIENTRY rlNullBindVertexArray(GLuint array) { }
+static void APIENTRY rlNullVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) { }
+static void APIENTRY rlNullVertexAttribArray(GLuint index) { }
+static void APIENTRY rlNullVertexAttribDivisor(GLuint index, GLuint divisor) { }
+static void APIENTRY rlNullVertexAttribfv(GLuint index, const GLfloat *v) { }
+
+// Framebuffers
+static void APIENTRY rlNullBindObject(GLenum target, GLuint id) { }
+static void APIENTRY rlNullFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { }
+static void APIENTRY rlNullFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { }
+static void APIENTRY rlNullRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) { }
+static void APIENTRY rlNullGetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, GLenum pname, GLint *params) { *params = 0; }
+static GLenum APIENTRY rlNullCheckFramebufferStatus(GLenum target) { return GL_FRAMEBUFFER_COMPLETE; }
+
+// Shaders
+static GLuint APIENTRY rlNullCreateShader(GLenum type) { return rlNullGenId(); }
+static GLuint APIENTRY rlNullCreateProgram(void) { return rlNullGenId(); }
+static void APIENTRY rlNullShaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length) { }
+static void APIENTRY rlNullSetObject(GLuint id) { }
+static void APIENTRY rlNullSetObjects(GLuint program, GLuint shader) { }
+static void APIENTRY rlNullBindAttribLocation(GLuint program, GLuint index, const GLchar *name) { }
+static void APIENTRY rlNullGetShaderiv(GLuint shader, GLenum pname, GLint *params) { *params = (pname == GL_COMPILE_STATUS)? GL_TRUE : 0; }
+static void APIENTRY rlNullGetProgramiv(GLuint program, GLenum pname, GLint *params) { *params = (pname == GL_LINK_STATUS)? GL_TRUE : 0; }
+static void APIENTRY rlNullGetInfoLog(GLuint id, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    if (length != NULL) *length = 0;
+    if (bufSize > 0) infoLog[0] = '\0';
+}
+static void APIENTRY rlNullGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) { rlNullGetInfoLog(program, bufSize, length, name); }
+static GLint APIENTRY rlNullGetLocation(GLuint program, const GLchar *name) { return 0; }    // Every attribute and uniform exists
+static void APIENTRY rlNullUniform1i(GLint location, GLint v0) { }
+static void APIENTRY rlNullUniform1f(GLint location, GLfloat v0) { }
+static void APIENTRY rlNullUniform2f(GLint location, GLfloat v0, GLfloat v1) { }
+static void APIENTRY rlNullUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) { }
+static void APIENTRY rlNullUniformiv(GLint location, GLsizei count, const GLint *value) { }
+static void APIENTRY rlNullUniformfv(GLint location, GLsizei count, const GLfloat *value) { }
+static void APIENTRY rlNullUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { }
+
+// Sync objects
+static GLsync APIENTRY rlNullFenceSync(GLenum condition, GLbitfield flags) { return (GLsync)(size_t)rlNullGenId(); }
+static GLenum APIENTRY rlNullClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { return GL_ALREADY_SIGNALED; }
+static void APIENTRY rlNullDeleteSync(GLsync sync) { }
+
+// Draw calls, texture bound to slot 0 is recorded
+static void APIENTRY rlNullDrawArrays(GLenum mode, GLint first, GLsizei count) { rlNullRecord(RL_NULL_COMMAND_DRAW, mode, RLNULL.texture2D[0], count, 1, 0); }
+static void APIENTRY rlNullDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) { rlNullRecord(RL_NULL_COMMAND_DRAW, mode, RLNULL.texture2D[0], count, 1, 0); }
+static void APIENTRY rlNullDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+    rlNullRecord(RL_NULL_COMMAND_DRAW_INSTANCED, mode, RLNULL.texture2D[0], count, instancecount, 0);
+}
+static void APIENTRY rlNullDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount)
+{
+    rlNullRecord(RL_NULL_COMMAND_DRAW_INSTANCED, mode, RLNULL.texture2D[0], count, instancecount, 0);
+}
+
+// Record command into null backend log, log grows as required
+static void rlNullRecord(int type, unsigned int mode, unsigned int id, int count, int instances, int size)
+{
+    if (RLNULL.commandsCount >= RLNULL.commandsCapacity)
+    {
+        int capacity = (RLNULL.commandsCapacity > 0)? RLNULL.commandsCapacity*2 : 1024;
+        NullCommand *commands = (NullCommand *)RL_REALLOC(RLNULL.commands, capacity*sizeof(NullCommand));
+        if (commands == NULL) return;
+
+        RLNULL.commands = commands;
+        RLNULL.commandsCapacity = capacity;
+    }
+
+    RLNULL.commands[RLNULL.commandsCount++] = (NullCommand){ type, mode, id, count, instances, size };
+}
+
+// Get null backend OpenGL function by name, NULL if not provided
+void *rlNullGetProcAddress(const char *name)
+{
+    static const struct { const char *name; void *proc; } procs[] = {
+        { "glGetString", (void *)rlNullGetString }, { "glGetStringi", (void *)rlNullGetStringi },
+        { "glGetIntegerv", (void *)rlNullGetIntegerv }, { "glGetFloatv", (void *)rlNullGetFloatv },
+        { "glGetError", (void *)rlNullGetError },
+        { "glEnable", (void *)rlNullSetCapability }, { "glDisable", (void *)rlNullSetCapability },
+        { "glBlendEquation", (void *)rlNullSetEnum }, { "glBlendFunc", (void *)rlNullSetEnum2 },
+        { "glCullFace", (void *)rlNullSetEnum }, { "glFrontFace", (void *)rlNullSetEnum },
+        { "glDepthFunc", (void *)rlNullSetEnum }, { "glPolygonMode", (void *)rlNullSetEnum2 },
+        { "glDepthMask", (void *)rlNullSetBoolean }, { "glViewport", (void *)rlNullSetRect },
+        { "glScissor", (void *)rlNullSetRect }, { "glClearColor", (void *)rlNullClearColor },
+        { "glClearDepth", (void *)rlNullClearDepth }, { "glLineWidth", (void *)rlNullLineWidth },
+        { "glPixelStorei", (void *)rlNullPixelStorei }, { "glClear", (void *)rlNullClear },
+
+        { "glGenTextures", (void *)rlNullGenObjects }, { "glDeleteTextures", (void *)rlNullDeleteObjects },
+        { "glActiveTexture", (void *)rlNullActiveTexture }, { "glBindTexture", (void *)rlNullBindTexture },
+        { "glTexImage2D", (void *)rlNullTexImage2D }, { "glTexSubImage2D", (void *)rlNullTexSubImage2D },
+        { "glCompressedTexImage2D", (void *)rlNullCompressedTexImage2D },
+        { "glTexParameteri", (void *)rlNullTexParameteri }, { "glTexParameteriv", (void *)rlNullTexParameteriv },
+        { "glTexParameterf", (void *)rlNullTexParameterf }, { "glGenerateMipmap", (void *)rlNullSetEnum },
+        { "glGetTexImage", (void *)rlNullGetTexImage }, { "glReadPixels", (void *)rlNullReadPixels },
+
+        { "glGenBuffers", (void *)rlNullGenObjects }, { "glDeleteBuffers", (void *)rlNullDeleteObjects },
+        { "glBindBuffer", (void *)rlNullBindBuffer }, { "glBufferData", (void *)rlNullBufferData },
+        { "glBufferSubData", (void *)rlNullBufferSubData },
+        { "glMapBufferRange", (void *)rlNullMapBufferRange }, { "glUnmapBuffer", (void *)rlNullUnmapBuffer },
+        { "glGenVertexArrays", (void *)rlNullGenObjects }, { "glDeleteVertexArrays", (void *)rlNullDeleteObjects },
+        { "glBindVertexArray", (void *)rlNullBindVertexArray }, { "glVertexAttribPointer", (void *)rlNullVertexAttribPointer },
+        { "glEnableVertexAttribArray", (void *)rlNullVertexAttribArray }, { "glDisableVertexAttribArray", (void *)rlNullVertexAttribArray },
+        { "glVertexAttribDivisor", (void *)rlNullVertexAttribDivisor },
+        { "glVertexAttrib1fv", (void *)rlNullVertexAttribfv }, { "glVertexAttrib2fv", (void *)rlNullVertexAttribfv },
+        { "glVertexAttrib3fv", (void *)rlNullVertexAttribfv }, { "glVertexAttrib4fv", (void *)rlNullVertexAttribfv },
+
+        { "glGenFramebuffers", (void *)rlNullGenObjects }, { "glDeleteFramebuffers", (void *)rlNullDeleteObjects },
+        { "glGenRenderbuffers", (void *)rlNullGenObjects }, { "glDeleteRenderbuffers", (void *)rlNullDeleteObjects },
+        { "glBindFramebuffer", (void *)rlNullBindObject }, { "glBindRenderbuffer", (void *)rlNullBindObject },
+        { "glFramebufferTexture2D", (void *)rlNullFramebufferTexture2D },
+        { "glFramebufferRenderbuffer", (void *)rlNullFramebufferRenderbuffer },
+        { "glRenderbufferStorage", (void *)rlNullRenderbufferStorage },
+        { "glGetFramebufferAttachmentParameteriv", (void *)rlNullGetFramebufferAttachmentParameteriv },
+        { "glCheckFramebufferStatus", (void *)rlNullCheckFramebufferStatus },
+
+        { "glCreateShader", (void *)rlNullCreateShader }, { "glCreateProgram", (void *)rlNullCreateProgram },
+        { "glShaderSource", (void *)rlNullShaderSource }, { "glCompileShader", (void *)rlNullSetObject },
+        { "glDeleteShader", (void *)rlNullSetObject }, { "glDeleteProgram", (void *)rlNullSetObject },
+        { "glLinkProgram", (void *)rlNullSetObject }, { "glUseProgram", (void *)rlNullSetObject },
+        { "glAttachShader", (void *)rlNullSetObjects }, { "glDetachShader", (void *)rlNullSetObjects },
+        { "glBindAttribLocation", (void *)rlNullBindAttribLocation },
+        { "glGetShaderiv", (void *)rlNullGetShaderiv }, { "glGetProgramiv", (void *)rlNullGetProgramiv },
+        { "glGetShaderInfoLog", (void *)rlNullGetInfoLog }, { "glGetProgramInfoLog", (void *)rlNullGetInfoLog },
+        { "glGetActiveUniform", (void *)rlNullGetActiveUniform },
+        { "glGetUniformLocation", (void *)rlNullGetLocation }, { "glGetAttribLocation", (void *)rlNullGetLocation },
+        { "glUniform1i", (void *)rlNullUniform1i }, { "glUniform1f", (void *)rlNullUniform1f },
+        { "glUniform2f", (void *)rlNullUniform2f }, { "glUniform4f", (void *)rlNullUniform4f },
+        { "glUniform1iv", (void *)rlNullUniformiv }, { "glUniform2iv", (void *)rlNullUniformiv },
+        { "glUniform3iv", (void *)rlNullUniformiv }, { "glUniform4iv", (void *)rlNullUniformiv },
+        { "glUniform1fv", (void *)rlNullUniformfv }, { "glUniform2fv", (void *)rlNullUniformfv },
+        { "glUniform3fv", (void *)rlNullUniformfv }, { "glUniform4fv", (void *)rlNullUniformfv },
+        { "glUniformMatrix4fv", (void *)rlNullUniformMatrix4fv },
+
+        { "glFenceSync", (void *)rlNullFenceSync }, { "glClientWaitSync", (void *)rlNullClientWaitSync },
+        { "glDeleteSync", (void *)rlNullDeleteSync },
+
+        { "glDrawArrays", (void *)rlNullDrawArrays }, { "glDrawElements", (void *)rlNullDrawElements },
+        { "glDrawArraysInstanced", (void *)rlNullDrawArraysInstanced },
+        { "glDrawElementsInstanced", (void *)rlNullDrawElementsInstanced },
+    };
+
+    for (int i = 0; i < (int)(sizeof(procs)/sizeof(procs[0])); i++)
+    {
+        if (strcmp(procs[i].name, name) == 0) return procs[i].proc;
+    }
+
+    return NULL;
+}
+
+// Get commands recorded since last clear
+// NOTE: Returned pointer is only valid until next recorded command or clear
+const NullCommand *rlNullGetCommands(int *count)
+{
+    if (count != NULL) *count = RLNULL.commandsCount;
+    return RLNULL.commands;
+}
+
+// Clear recorded commands, allocated log is kept
+void rlNullClearCommands(void)
+{
+    RLNULL.commandsCount = 0;
+}
+#endif  // RLGL_NULL_BACKEND
+
+// Set alpha of RGBA pixels to 255
+// NOTE: Pixels are processed as 32 bit words, a loop compilers vectorize
+static void rlSetPixelsOpaque(unsigned char *pixels, int count)
+{
+    const unsigned char opaque[4] = { 0, 0, 0, 255 };
+    unsigned int mask = 0;
+    memcpy(&mask, opaque, 4);       // Alpha byte mask, whatever the endianness
+
+    unsigned int *words = (unsigned int *)pixels;
+    for (int i = 0; i < count; i++) words[i] |= mask;
+}
+
 // Get pixel data size in bytes (image or texture)
 // NOTE: Size depends on pixel format
 static int rlGetPixelDataSize(int width, int height, int format)
@@ -3,5 +3,13 @@
 #![allow(non_snake_case)]
 include!(concat!(env!("OUT_DIR"), "/bindings.rs"));
 
+mod rlgl;
+pub use rlgl::*;
+
+#[cfg(feature = "null_backend")]
+mod rlgl_null;
+#[cfg(feature = "null_backend")]
+pub use rlgl_null::*;
+
 #[cfg(target_os = "macos")]
 pub const MAX_MATERIAL_MAPS: u32 = 12;
\ No newline at end of file
@@ -0,0 +1,344 @@
+// Hand written rlgl bindings, generated bindings do not carry rlgl.h on every platform.
+// Follows bindgen output (rustified enums) and must be kept in sync with raylib-sys/rlgl.h.
+
+pub const RL_LINES: u32 = 1;
+pub const RL_TRIANGLES: u32 = 4;
+pub const RL_QUADS: u32 = 7;
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct BatchVertex {
+    pub x: f32,
+    pub y: f32,
+    pub z: f32,
+    pub u: f32,
+    pub v: f32,
+    pub r: ::std::os::raw::c_uchar,
+    pub g: ::std::os::raw::c_uchar,
+    pub b: ::std::os::raw::c_uchar,
+    pub a: ::std::os::raw::c_uchar,
+}
+#[test]
+fn bindgen_test_layout_BatchVertex() {
+    assert_eq!(
+        ::std::mem::size_of::<BatchVertex>(),
+        24usize,
+        concat!("Size of: ", stringify!(BatchVertex))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<BatchVertex>(),
+        4usize,
+        concat!("Alignment of ", stringify!(BatchVertex))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct VertexBuffer {
+    pub elementsCount: ::std::os::raw::c_int,
+    pub vCounter: ::std::os::raw::c_int,
+    pub tcCounter: ::std::os::raw::c_int,
+    pub cCounter: ::std::os::raw::c_int,
+    pub vertices: *mut f32,
+    pub texcoords: *mut f32,
+    pub colors: *mut ::std::os::raw::c_uchar,
+    pub interleaved: *mut BatchVertex,
+    pub indices: *mut ::std::os::raw::c_uint,
+    pub vaoId: ::std::os::raw::c_uint,
+    pub vboId: [::std::os::raw::c_uint; 4usize],
+    pub syncFence: *mut ::std::os::raw::c_void,
+}
+#[test]
+fn bindgen_test_layout_VertexBuffer() {
+    assert_eq!(
+        ::std::mem::size_of::<VertexBuffer>(),
+        88usize,
+        concat!("Size of: ", stringify!(VertexBuffer))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<VertexBuffer>(),
+        8usize,
+        concat!("Alignment of ", stringify!(VertexBuffer))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct DrawCall {
+    pub mode: ::std::os::raw::c_int,
+    pub vertexCount: ::std::os::raw::c_int,
+    pub vertexAlignment: ::std::os::raw::c_int,
+    pub textureId: ::std::os::raw::c_uint,
+    pub layer: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_DrawCall() {
+    assert_eq!(
+        ::std::mem::size_of::<DrawCall>(),
+        20usize,
+        concat!("Size of: ", stringify!(DrawCall))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<DrawCall>(),
+        4usize,
+        concat!("Alignment of ", stringify!(DrawCall))
+    );
+}
+#[repr(u32)]
+#[derive(Debug, Copy, Clone, Hash, PartialEq, Eq)]
+pub enum RenderBatchUploadMode {
+    RL_BATCH_UPLOAD_SUBDATA = 0,
+    RL_BATCH_UPLOAD_ORPHAN = 1,
+    RL_BATCH_UPLOAD_PERSISTENT = 2,
+}
+#[repr(u32)]
+#[derive(Debug, Copy, Clone, Hash, PartialEq, Eq)]
+pub enum RenderBatchLayout {
+    RL_BATCH_LAYOUT_SEPARATE = 0,
+    RL_BATCH_LAYOUT_INTERLEAVED = 1,
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct RenderBatch {
+    pub buffersCount: ::std::os::raw::c_int,
+    pub currentBuffer: ::std::os::raw::c_int,
+    pub vertexBuffer: *mut VertexBuffer,
+    pub draws: *mut DrawCall,
+    pub drawsCounter: ::std::os::raw::c_int,
+    pub currentDepth: f32,
+    pub uploadMode: ::std::os::raw::c_int,
+    pub layout: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_RenderBatch() {
+    assert_eq!(
+        ::std::mem::size_of::<RenderBatch>(),
+        40usize,
+        concat!("Size of: ", stringify!(RenderBatch))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<RenderBatch>(),
+        8usize,
+        concat!("Alignment of ", stringify!(RenderBatch))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct RenderStats {
+    pub flushes: ::std::os::raw::c_uint,
+    pub overflowFlushes: ::std::os::raw::c_uint,
+    pub drawCalls: ::std::os::raw::c_uint,
+    pub vertices: ::std::os::raw::c_uint,
+    pub bytesUploaded: ::std::os::raw::c_uint,
+    pub stateCallsIssued: ::std::os::raw::c_uint,
+    pub stateCallsElided: ::std::os::raw::c_uint,
+}
+#[test]
+fn bindgen_test_layout_RenderStats() {
+    assert_eq!(
+        ::std::mem::size_of::<RenderStats>(),
+        28usize,
+        concat!("Size of: ", stringify!(RenderStats))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<RenderStats>(),
+        4usize,
+        concat!("Alignment of ", stringify!(RenderStats))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct SpriteInstance {
+    pub dest: [f32; 4usize],
+    pub source: [f32; 4usize],
+    pub origin: [f32; 2usize],
+    pub rotation: f32,
+    pub color: [::std::os::raw::c_uchar; 4usize],
+}
+#[test]
+fn bindgen_test_layout_SpriteInstance() {
+    assert_eq!(
+        ::std::mem::size_of::<SpriteInstance>(),
+        48usize,
+        concat!("Size of: ", stringify!(SpriteInstance))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<SpriteInstance>(),
+        4usize,
+        concat!("Alignment of ", stringify!(SpriteInstance))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct CommandList {
+    pub vertexCount: ::std::os::raw::c_int,
+    pub drawsCount: ::std::os::raw::c_int,
+    pub draws: *mut DrawCall,
+    pub vaoId: ::std::os::raw::c_uint,
+    pub vboId: ::std::os::raw::c_uint,
+}
+#[test]
+fn bindgen_test_layout_CommandList() {
+    assert_eq!(
+        ::std::mem::size_of::<CommandList>(),
+        24usize,
+        concat!("Size of: ", stringify!(CommandList))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<CommandList>(),
+        8usize,
+        concat!("Alignment of ", stringify!(CommandList))
+    );
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct ScreenCapture {
+    pub pboId: ::std::os::raw::c_uint,
+    pub fence: *mut ::std::os::raw::c_void,
+    pub pixels: *mut ::std::os::raw::c_uchar,
+    pub width: ::std::os::raw::c_int,
+    pub height: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_ScreenCapture() {
+    assert_eq!(
+        ::std::mem::size_of::<ScreenCapture>(),
+        32usize,
+        concat!("Size of: ", stringify!(ScreenCapture))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<ScreenCapture>(),
+        8usize,
+        concat!("Alignment of ", stringify!(ScreenCapture))
+    );
+}
+extern "C" {
+    pub fn rlGetTextureDefault() -> super::Texture2D;
+}
+extern "C" {
+    pub fn rlLoadTexture(
+        data: *mut ::std::os::raw::c_void,
+        width: ::std::os::raw::c_int,
+        height: ::std::os::raw::c_int,
+        format: ::std::os::raw::c_int,
+        mipmapCount: ::std::os::raw::c_int,
+    ) -> ::std::os::raw::c_uint;
+}
+extern "C" {
+    pub fn rlLoadRenderBatch(
+        numBuffers: ::std::os::raw::c_int,
+        bufferElements: ::std::os::raw::c_int,
+    ) -> RenderBatch;
+}
+extern "C" {
+    pub fn rlLoadRenderBatchEx(
+        numBuffers: ::std::os::raw::c_int,
+        bufferElements: ::std::os::raw::c_int,
+        uploadMode: ::std::os::raw::c_int,
+        layout: ::std::os::raw::c_int,
+    ) -> RenderBatch;
+}
+extern "C" {
+    pub fn rlUnloadRenderBatch(batch: RenderBatch);
+}
+extern "C" {
+    pub fn rlDrawRenderBatch(batch: *mut RenderBatch);
+}
+extern "C" {
+    pub fn rlSetRenderBatchActive(batch: *mut RenderBatch);
+}
+extern "C" {
+    pub fn rlDrawRenderBatchActive();
+}
+extern "C" {
+    pub fn rlCheckRenderBatchLimit(vCount: ::std::os::raw::c_int) -> bool;
+}
+extern "C" {
+    pub fn rlGetRenderBatchElements() -> ::std::os::raw::c_int;
+}
+extern "C" {
+    pub fn rlGetRenderBatchDepth() -> f32;
+}
+extern "C" {
+    pub fn rlEnableSortedBatch();
+}
+extern "C" {
+    pub fn rlDisableSortedBatch();
+}
+extern "C" {
+    pub fn rlSetDrawLayer(layer: ::std::os::raw::c_int);
+}
+extern "C" {
+    pub fn rlGetDrawCallsCount() -> ::std::os::raw::c_uint;
+}
+extern "C" {
+    pub fn rlGetStateCallsIssued() -> ::std::os::raw::c_uint;
+}
+extern "C" {
+    pub fn rlGetStateCallsElided() -> ::std::os::raw::c_uint;
+}
+extern "C" {
+    pub fn rlResetStateCache();
+}
+extern "C" {
+    pub fn rlGetRenderStats() -> RenderStats;
+}
+extern "C" {
+    pub fn rlGetRenderStatsPrevious() -> RenderStats;
+}
+extern "C" {
+    pub fn rlResetRenderStats();
+}
+extern "C" {
+    pub fn rlBeginCommandList();
+}
+extern "C" {
+    pub fn rlEndCommandList(list: *mut CommandList);
+}
+extern "C" {
+    pub fn rlDrawCommandList(list: CommandList, transform: super::Matrix);
+}
+extern "C" {
+    pub fn rlUnloadCommandList(list: CommandList);
+}
+extern "C" {
+    pub fn rlBegin(mode: ::std::os::raw::c_int);
+}
+extern "C" {
+    pub fn rlEnd();
+}
+extern "C" {
+    pub fn rlSetTexture(id: ::std::os::raw::c_uint);
+}
+extern "C" {
+    pub fn rlVertexBatch(vertices: *const BatchVertex, count: ::std::os::raw::c_int);
+}
+extern "C" {
+    pub fn rlDrawSpritesInstanced(
+        textureId: ::std::os::raw::c_uint,
+        textureWidth: ::std::os::raw::c_int,
+        textureHeight: ::std::os::raw::c_int,
+        sprites: *const SpriteInstance,
+        count: ::std::os::raw::c_int,
+    ) -> bool;
+}
+extern "C" {
+    pub fn rlDrawMeshInstanced(
+        mesh: super::Mesh,
+        material: super::Material,
+        transforms: *const super::Matrix,
+        instances: ::std::os::raw::c_int,
+    );
+}
+extern "C" {
+    pub fn rlReadScreenPixelsAsync(
+        width: ::std::os::raw::c_int,
+        height: ::std::os::raw::c_int,
+    ) -> ScreenCapture;
+}
+extern "C" {
+    pub fn rlIsScreenCaptureReady(capture: ScreenCapture) -> bool;
+}
+extern "C" {
+    pub fn rlGetScreenCapturePixels(capture: *mut ScreenCapture) -> *mut ::std::os::raw::c_uchar;
+}
+extern "C" {
+    pub fn rlUnloadScreenCapture(capture: ScreenCapture);
+}
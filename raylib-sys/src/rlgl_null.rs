@@ -0,0 +1,82 @@
+// Hand written rlgl null backend bindings (RLGL_NULL_BACKEND), only built with the `null_backend` feature.
+// Follows bindgen output (rustified enums) and must be kept in sync with raylib-sys/rlgl.h.
+// rlgl initialization functions are not part of every platform generated bindings, they are required
+// to initialize rlgl without a window.
+
+pub const RL_MODELVIEW: u32 = 5888;
+pub const RL_PROJECTION: u32 = 5889;
+#[repr(u32)]
+#[derive(Debug, Copy, Clone, Hash, PartialEq, Eq)]
+pub enum NullCommandType {
+    RL_NULL_COMMAND_FLUSH = 0,
+    RL_NULL_COMMAND_DRAW = 1,
+    RL_NULL_COMMAND_DRAW_INSTANCED = 2,
+    RL_NULL_COMMAND_BUFFER_UPLOAD = 3,
+    RL_NULL_COMMAND_TEXTURE_UPLOAD = 4,
+    RL_NULL_COMMAND_CLEAR = 5,
+}
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone, PartialEq, Eq)]
+pub struct NullCommand {
+    pub type_: ::std::os::raw::c_int,
+    pub mode: ::std::os::raw::c_uint,
+    pub id: ::std::os::raw::c_uint,
+    pub count: ::std::os::raw::c_int,
+    pub instances: ::std::os::raw::c_int,
+    pub size: ::std::os::raw::c_int,
+}
+#[test]
+fn bindgen_test_layout_NullCommand() {
+    assert_eq!(
+        ::std::mem::size_of::<NullCommand>(),
+        24usize,
+        concat!("Size of: ", stringify!(NullCommand))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<NullCommand>(),
+        4usize,
+        concat!("Alignment of ", stringify!(NullCommand))
+    );
+}
+extern "C" {
+    pub fn rlNullGetProcAddress(name: *const ::std::os::raw::c_char)
+        -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    pub fn rlNullGetCommands(count: *mut ::std::os::raw::c_int) -> *const NullCommand;
+}
+extern "C" {
+    pub fn rlNullClearCommands();
+}
+extern "C" {
+    pub fn rlglInit(width: ::std::os::raw::c_int, height: ::std::os::raw::c_int);
+}
+extern "C" {
+    pub fn rlglClose();
+}
+extern "C" {
+    pub fn rlLoadExtensions(loader: *mut ::std::os::raw::c_void);
+}
+extern "C" {
+    pub fn rlViewport(
+        x: ::std::os::raw::c_int,
+        y: ::std::os::raw::c_int,
+        width: ::std::os::raw::c_int,
+        height: ::std::os::raw::c_int,
+    );
+}
+extern "C" {
+    pub fn rlMatrixMode(mode: ::std::os::raw::c_int);
+}
+extern "C" {
+    pub fn rlLoadIdentity();
+}
+extern "C" {
+    pub fn rlOrtho(left: f64, right: f64, bottom: f64, top: f64, znear: f64, zfar: f64);
+}
+extern "C" {
+    pub fn LoadFontDefault();
+}
+extern "C" {
+    pub fn UnloadFontDefault();
+}
@@ -13,7 +13,14 @@ pub use ffi::KeyboardKey;
 pub use ffi::MaterialMapIndex;
 pub use ffi::MouseButton;
 pub use ffi::NPatchLayout;
+#[cfg(feature = "null_backend")]
+pub use ffi::NullCommand;
+#[cfg(feature = "null_backend")]
+pub use ffi::NullCommandType;
 pub use ffi::PixelFormat;
+pub use ffi::RenderBatchLayout;
+pub use ffi::RenderBatchUploadMode;
+pub use ffi::RenderStats;
 pub use ffi::ShaderLocationIndex;
 pub use ffi::ShaderUniformDataType;
 pub use ffi::TextureFilter;
@@ -0,0 +1,652 @@
+//! Packed asset archives, mapped in memory and read by raylib file loading callbacks
+use crate::core::mapped::MappedFile;
+use crate::core::texture::mem_alloc;
+use crate::ffi;
+use std::borrow::Cow;
+use std::convert::TryFrom;
+use std::ffi::CStr;
+use std::io::{self, Read, Write};
+use std::os::raw::{c_char, c_uchar, c_uint};
+use std::path::Path;
+use std::sync::{Arc, RwLock};
+
+// Archive layout, little endian:
+// - header: magic, version, entry count, blob alignment, names offset (HEADER_SIZE bytes)
+// - index: one ENTRY_SIZE record per entry, sorted by path hash
+// - names: entry paths, UTF-8, referenced by the index
+// - blobs: entry data, each starting at a multiple of the alignment
+const MAGIC: &[u8; 4] = b"RLPK";
+const VERSION: u32 = 1;
+const HEADER_SIZE: usize = 24;
+const ENTRY_SIZE: usize = 40;
+const FLAG_DEFLATE: u16 = 1;
+/// Output buffer size of raylib `DecompressData`, larger entries are stored uncompressed.
+const MAX_INFLATE_SIZE: usize = 64 << 20;
+
+/// Normalizes a path the way archive entries are named: `/` separators, no `.` or empty parts.
+fn normalize_path(path: &str) -> String {
+    path.split(|c| c == '/' || c == '\\')
+        .filter(|part| !part.is_empty() && *part != ".")
+        .collect::<Vec<_>>()
+        .join("/")
+}
+
+/// FNV-1a, entries are looked up by the hash of their normalized path.
+fn path_hash(path: &str) -> u64 {
+    path.bytes().fold(0xcbf2_9ce4_8422_2325, |hash, b| {
+        (hash ^ b as u64).wrapping_mul(0x0100_0000_01b3)
+    })
+}
+
+fn read_u16(bytes: &[u8], offset: usize) -> u16 {
+    let mut b = [0; 2];
+    b.copy_from_slice(&bytes[offset..offset + 2]);
+    u16::from_le_bytes(b)
+}
+
+fn read_u32(bytes: &[u8], offset: usize) -> u32 {
+    let mut b = [0; 4];
+    b.copy_from_slice(&bytes[offset..offset + 4]);
+    u32::from_le_bytes(b)
+}
+
+fn read_u64(bytes: &[u8], offset: usize) -> u64 {
+    let mut b = [0; 8];
+    b.copy_from_slice(&bytes[offset..offset + 8]);
+    u64::from_le_bytes(b)
+}
+
+/// Compresses with raylib DEFLATE (`CompressData`, like `compress_data`), freeing its buffer.
+fn deflate(data: &[u8]) -> Result<Vec<u8>, String> {
+    let mut length = 0;
+    unsafe {
+        let buffer = ffi::CompressData(data.as_ptr() as *mut _, data.len() as i32, &mut length);
+        if buffer.is_null() {
+            return Err("could not compress data".to_string());
+        }
+        let compressed = std::slice::from_raw_parts(buffer, length as usize).to_vec();
+        ffi::MemFree(buffer as *mut _);
+        Ok(compressed)
+    }
+}
+
+/// Decompresses into raylib allocated memory, as `LoadFileData` callers free it.
+unsafe fn inflate(data: &[u8], size: usize) -> Result<*mut c_uchar, String> {
+    let mut length = 0;
+    let buffer = ffi::DecompressData(data.as_ptr() as *mut _, data.len() as i32, &mut length);
+    if buffer.is_null() || length as usize != size {
+        ffi::MemFree(buffer as *mut _);
+        return Err("could not decompress data".to_string());
+    }
+    Ok(buffer)
+}
+
+/// Copies `data` into raylib allocated memory, with a trailing NUL for text.
+unsafe fn raylib_alloc(data: &[u8], nul: bool) -> Result<*mut c_uchar, String> {
+    let buffer = mem_alloc::<c_uchar>(data.len() + nul as usize)
+        .ok_or_else(|| format!("could not allocate {} bytes", data.len()))?;
+    std::ptr::copy_nonoverlapping(data.as_ptr(), buffer, data.len());
+    if nul {
+        *buffer.add(data.len()) = 0;
+    }
+    Ok(buffer)
+}
+
+/// Writes asset archives, see [`Archive`].
+#[derive(Debug)]
+pub struct ArchiveBuilder {
+    alignment: usize,
+    entries: Vec<(String, Vec<u8>, bool)>,
+}
+
+impl Default for ArchiveBuilder {
+    fn default() -> ArchiveBuilder {
+        ArchiveBuilder::new()
+    }
+}
+
+impl ArchiveBuilder {
+    /// Creates a builder aligning entries to 16 bytes.
+    pub fn new() -> ArchiveBuilder {
+        ArchiveBuilder {
+            alignment: 16,
+            entries: Vec::new(),
+        }
+    }
+
+    /// Aligns every entry to `alignment` bytes (a power of two), e.g. 4096 to map entries
+    /// one page each.
+    pub fn alignment(mut self, alignment: usize) -> ArchiveBuilder {
+        self.alignment = alignment.max(1).next_power_of_two();
+        self
+    }
+
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Adds `data` as `path`, replacing any entry with the same path. If `compress`, the data
+    /// is stored compressed with DEFLATE, unless that does not make it smaller or it is over
+    /// the 64 MiB raylib can decompress.
+    pub fn add(&mut self, path: &str, data: Vec<u8>, compress: bool) {
+        let path = normalize_path(path);
+        self.entries.retain(|(p, _, _)| *p != path);
+        self.entries.push((path, data, compress));
+    }
+
+    /// Adds the file at `file` as `path`.
+    pub fn add_file(
+        &mut self,
+        path: &str,
+        file: impl AsRef<Path>,
+        compress: bool,
+    ) -> io::Result<()> {
+        let data = std::fs::read(file)?;
+        self.add(path, data, compress);
+        Ok(())
+    }
+
+    /// Adds every file under `directory`, named by their path relative to `directory`
+    /// prefixed with `prefix`. Returns the number of files added.
+    pub fn add_directory(
+        &mut self,
+        prefix: &str,
+        directory: impl AsRef<Path>,
+        compress: bool,
+    ) -> io::Result<usize> {
+        let mut added = 0;
+        let mut directories = vec![(prefix.to_string(), directory.as_ref().to_path_buf())];
+        while let Some((prefix, directory)) = directories.pop() {
+            let mut entries = std::fs::read_dir(&directory)?.collect::<io::Result<Vec<_>>>()?;
+            entries.sort_by_key(|e| e.file_name());
+            for entry in entries {
+                let name = format!("{}/{}", prefix, entry.file_name().to_string_lossy());
+                if entry.file_type()?.is_dir() {
+                    directories.push((name, entry.path()));
+                } else {
+                    self.add_file(&name, entry.path(), compress)?;
+                    added += 1;
+                }
+            }
+        }
+        Ok(added)
+    }
+
+    /// Writes the archive. Fails with `InvalidInput` if a path is over 64 KiB or the index
+    /// does not fit its 32 bits offsets.
+    pub fn write(&self, mut out: impl Write) -> io::Result<()> {
+        let too_large = |msg: &str| io::Error::new(io::ErrorKind::InvalidInput, msg);
+        let mut entries = Vec::with_capacity(self.entries.len());
+        for (path, data, compress) in &self.entries {
+            let packed = match *compress && data.len() <= MAX_INFLATE_SIZE {
+                true => deflate(data)
+                    .ok()
+                    .filter(|packed| packed.len() < data.len()),
+                false => None,
+            };
+            let hash = path_hash(path);
+            entries.push((
+                hash,
+                path,
+                data.len(),
+                packed.map_or(Cow::from(data), Cow::from),
+            ));
+        }
+        entries.sort_by(|a, b| (a.0, a.1).cmp(&(b.0, b.1)));
+
+        let align = |offset: usize| (offset + self.alignment - 1) & !(self.alignment - 1);
+        let names_offset = HEADER_SIZE + entries.len() * ENTRY_SIZE;
+        let names_size: usize = entries.iter().map(|e| e.1.len()).sum();
+        let mut offset = align(names_offset + names_size);
+
+        let mut head = Vec::with_capacity(offset);
+        head.extend_from_slice(MAGIC);
+        head.extend_from_slice(&VERSION.to_le_bytes());
+        let count = u32::try_from(entries.len()).map_err(|_| too_large("too many entries"))?;
+        head.extend_from_slice(&count.to_le_bytes());
+        let alignment =
+            u32::try_from(self.alignment).map_err(|_| too_large("alignment over 4 GiB"))?;
+        head.extend_from_slice(&alignment.to_le_bytes());
+        head.extend_from_slice(&(names_offset as u64).to_le_bytes());
+        let mut name_offset = names_offset;
+        for (hash, path, size, stored) in &entries {
+            // Only compressed data is owned
+            let flags = match stored {
+                Cow::Owned(_) => FLAG_DEFLATE,
+                Cow::Borrowed(_) => 0,
+            };
+            head.extend_from_slice(&hash.to_le_bytes());
+            head.extend_from_slice(&(offset as u64).to_le_bytes());
+            head.extend_from_slice(&(stored.len() as u64).to_le_bytes());
+            head.extend_from_slice(&(*size as u64).to_le_bytes());
+            let name_at =
+                u32::try_from(name_offset).map_err(|_| too_large("entry paths over 4 GiB"))?;
+            let name_len =
+                u16::try_from(path.len()).map_err(|_| too_large("entry path over 64 KiB"))?;
+            head.extend_from_slice(&name_at.to_le_bytes());
+            head.extend_from_slice(&name_len.to_le_bytes());
+            head.extend_from_slice(&flags.to_le_bytes());
+            name_offset += path.len();
+            offset = align(offset + stored.len());
+        }
+        for (_, path, _, _) in &entries {
+            head.extend_from_slice(path.as_bytes());
+        }
+
+        let mut written = head.len();
+        out.write_all(&head)?;
+        for (_, _, _, stored) in &entries {
+            let start = align(written);
+            io::copy(&mut io::repeat(0).take((start - written) as u64), &mut out)?;
+            out.write_all(stored)?;
+            written = start + stored.len();
+        }
+        out.flush()
+    }
+
+    /// Writes the archive to the file at `path`.
+    pub fn write_file(&self, path: impl AsRef<Path>) -> io::Result<()> {
+        self.write(io::BufWriter::new(std::fs::File::create(path)?))
+    }
+}
+
+/// Entry of an [`Archive`].
+#[derive(Debug, Copy, Clone, PartialEq, Eq)]
+pub struct ArchiveEntry<'a> {
+    pub path: &'a str,
+    /// Offset of the stored data in the archive.
+    pub offset: usize,
+    /// Size of the stored data, compressed or not.
+    pub stored_size: usize,
+    pub size: usize,
+    pub compressed: bool,
+}
+
+lazy_static::lazy_static! {
+    static ref INSTALLED: RwLock<Option<Arc<Archive>>> = RwLock::new(None);
+}
+
+/// Asset archive mapped in memory: a header, an index sorted by path hash, then the entries
+/// data, compressed or not. Built with [`ArchiveBuilder`] or the `pack_assets` sample.
+///
+/// Once [installed](Archive::install), raylib functions reading files through `LoadFileData`
+/// and `LoadFileText` (images, textures, fonts, waves, sounds, models, shaders...) read the
+/// archive entries instead, falling back to files for paths the archive does not have.
+#[derive(Debug)]
+pub struct Archive {
+    map: MappedFile,
+    count: usize,
+}
+
+impl Archive {
+    /// Maps and validates the archive at `path`.
+    ///
+    /// # Safety
+    ///
+    /// The archive file must not be written to nor truncated while open, see
+    /// [`MappedFile::open`].
+    pub unsafe fn open(path: impl AsRef<Path>) -> io::Result<Archive> {
+        let map = MappedFile::open(path)?;
+        let invalid = |msg: &str| io::Error::new(io::ErrorKind::InvalidData, msg);
+        let bytes = map.as_bytes();
+        if bytes.len() < HEADER_SIZE || &bytes[..4] != MAGIC {
+            return Err(invalid("not an asset archive"));
+        }
+        if read_u32(bytes, 4) != VERSION {
+            return Err(invalid("unsupported asset archive version"));
+        }
+        let count = read_u32(bytes, 8) as usize;
+        let names_offset = read_u64(bytes, 16) as usize;
+        if names_offset != HEADER_SIZE + count * ENTRY_SIZE || names_offset > bytes.len() {
+            return Err(invalid("truncated asset archive index"));
+        }
+        let len = bytes.len();
+        let archive = Archive { map, count };
+        let bytes = archive.map.as_bytes();
+        // Checked once here, lookups index the data without checks
+        for i in 0..count {
+            let e = archive.entry_at(i);
+            if i > 0 && archive.entry_at(i - 1).hash > e.hash {
+                return Err(invalid("asset archive index not sorted"));
+            }
+            let name_end = e.name_offset + e.name_len;
+            if name_end > len
+                || e.offset
+                    .checked_add(e.stored_size)
+                    .map_or(true, |end| end > len)
+                || std::str::from_utf8(&bytes[e.name_offset..name_end]).is_err()
+            {
+                return Err(invalid("truncated asset archive entry"));
+            }
+            if e.flags & FLAG_DEFLATE != 0 && e.size > MAX_INFLATE_SIZE {
+                return Err(invalid("compressed asset archive entry over 64 MiB"));
+            }
+            if e.flags & FLAG_DEFLATE == 0 && e.size != e.stored_size {
+                return Err(invalid("uncompressed asset archive entry size mismatch"));
+            }
+        }
+        Ok(archive)
+    }
+
+    pub fn len(&self) -> usize {
+        self.count
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.count == 0
+    }
+
+    fn entry_at(&self, index: usize) -> RawEntry {
+        let bytes = self.map.as_bytes();
+        let at = HEADER_SIZE + index * ENTRY_SIZE;
+        RawEntry {
+            hash: read_u64(bytes, at),
+            offset: read_u64(bytes, at + 8) as usize,
+            stored_size: read_u64(bytes, at + 16) as usize,
+            size: read_u64(bytes, at + 24) as usize,
+            name_offset: read_u32(bytes, at + 32) as usize,
+            name_len: read_u16(bytes, at + 36) as usize,
+            flags: read_u16(bytes, at + 38),
+        }
+    }
+
+    fn public_entry(&self, e: RawEntry) -> ArchiveEntry<'_> {
+        let name = &self.map.as_bytes()[e.name_offset..e.name_offset + e.name_len];
+        ArchiveEntry {
+            path: unsafe { std::str::from_utf8_unchecked(name) },
+            offset: e.offset,
+            stored_size: e.stored_size,
+            size: e.size,
+            compressed: e.flags & FLAG_DEFLATE != 0,
+        }
+    }
+
+    /// Entries in index order.
+    pub fn entries(&self) -> impl Iterator<Item = ArchiveEntry<'_>> + '_ {
+        (0..self.count).map(move |i| self.public_entry(self.entry_at(i)))
+    }
+
+    /// Looks up the entry of `path`.
+    pub fn entry(&self, path: &str) -> Option<ArchiveEntry<'_>> {
+        let path = normalize_path(path);
+        let hash = path_hash(&path);
+        // Binary search of the first entry with the hash, then the paths sharing it
+        let (mut low, mut high) = (0, self.count);
+        while low < high {
+            let mid = (low + high) / 2;
+            if self.entry_at(mid).hash < hash {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        (low..self.count)
+            .map(|i| self.entry_at(i))
+            .take_while(|e| e.hash == hash)
+            .map(|e| self.public_entry(e))
+            .find(|e| e.path == path)
+    }
+
+    pub fn contains(&self, path: &str) -> bool {
+        self.entry(path).is_some()
+    }
+
+    /// Stored data of `path`, as is: compressed entries are not decompressed. Uncompressed
+    /// entries are borrowed from the mapping, e.g. for an `ImageView`.
+    pub fn stored(&self, path: &str) -> Option<&[u8]> {
+        self.entry(path)
+            .map(|e| &self.map.as_bytes()[e.offset..e.offset + e.stored_size])
+    }
+
+    /// Data of `path`, decompressed if needed.
+    pub fn read(&self, path: &str) -> Option<Result<Cow<'_, [u8]>, String>> {
+        let entry = self.entry(path)?;
+        let stored = &self.map.as_bytes()[entry.offset..entry.offset + entry.stored_size];
+        if !entry.compressed {
+            return Some(Ok(Cow::from(stored)));
+        }
+        Some(unsafe {
+            inflate(stored, entry.size).map(|buffer| {
+                let data = std::slice::from_raw_parts(buffer, entry.size).to_vec();
+                ffi::MemFree(buffer as *mut _);
+                Cow::from(data)
+            })
+        })
+    }
+
+    /// Makes raylib read files from the archive, replacing the archive installed before.
+    /// Returns the archive, to keep using it.
+    pub fn install(self) -> Arc<Archive> {
+        let archive = Arc::new(self);
+        // The lock only guards an `Option<Arc>`, which a panic can not leave half written
+        *INSTALLED.write().unwrap_or_else(|e| e.into_inner()) = Some(archive.clone());
+        unsafe {
+            ffi::SetLoadFileDataCallback(Some(load_file_data));
+            ffi::SetLoadFileTextCallback(Some(load_file_text));
+        }
+        archive
+    }
+
+    /// Makes raylib read files from disk again. Returns the archive that was installed.
+    pub fn uninstall() -> Option<Arc<Archive>> {
+        unsafe {
+            ffi::SetLoadFileDataCallback(None);
+            ffi::SetLoadFileTextCallback(None);
+        }
+        INSTALLED.write().unwrap_or_else(|e| e.into_inner()).take()
+    }
+
+    /// The archive installed, if any. `None` if the lock is poisoned, so the raylib callbacks
+    /// fall back to files instead of panicking across the C boundary.
+    pub fn installed() -> Option<Arc<Archive>> {
+        INSTALLED
+            .read()
+            .ok()
+            .and_then(|installed| installed.clone())
+    }
+
+    /// Reads `path` into raylib allocated memory, from the archive if it has the entry.
+    /// Returns the buffer and the length of its data, without the NUL.
+    unsafe fn load(&self, path: &str, nul: bool) -> Option<Result<(*mut c_uchar, usize), String>> {
+        let entry = self.entry(path)?;
+        let stored = &self.map.as_bytes()[entry.offset..entry.offset + entry.stored_size];
+        if !entry.compressed {
+            return Some(raylib_alloc(stored, nul).map(|buffer| (buffer, stored.len())));
+        }
+        // `inflate` checks the decompressed length is the entry size
+        Some(inflate(stored, entry.size).and_then(|buffer| {
+            if nul {
+                let text = raylib_alloc(std::slice::from_raw_parts(buffer, entry.size), true);
+                ffi::MemFree(buffer as *mut _);
+                text.map(|text| (text, entry.size))
+            } else {
+                Ok((buffer, entry.size))
+            }
+        }))
+    }
+}
+
+#[derive(Debug, Copy, Clone)]
+struct RawEntry {
+    hash: u64,
+    offset: usize,
+    stored_size: usize,
+    size: usize,
+    name_offset: usize,
+    name_len: usize,
+    flags: u16,
+}
+
+/// Installed archive entry or file at `file_name` in raylib allocated memory. Null and a
+/// warning if neither can be read, like raylib does.
+unsafe fn load_file(file_name: *const c_char, nul: bool) -> (*mut c_uchar, usize) {
+    if file_name.is_null() {
+        return (std::ptr::null_mut(), 0);
+    }
+    let path = CStr::from_ptr(file_name).to_string_lossy();
+    let installed = Archive::installed();
+    let loaded = match installed.as_ref().and_then(|a| a.load(&path, nul)) {
+        Some(loaded) => loaded,
+        None => std::fs::read(&*path)
+            .map_err(|e| e.to_string())
+            .and_then(|data| raylib_alloc(&data, nul).map(|buffer| (buffer, data.len()))),
+    };
+    match loaded {
+        Ok(loaded) => loaded,
+        Err(error) => {
+            crate::core::logging::trace_log(
+                crate::consts::TraceLogLevel::LOG_WARNING,
+                &format!("FILEIO: [{}] Failed to open file: {}", path, error),
+            );
+            (std::ptr::null_mut(), 0)
+        }
+    }
+}
+
+unsafe extern "C" fn load_file_data(
+    file_name: *const c_char,
+    bytes_read: *mut c_uint,
+) -> *mut c_uchar {
+    let (data, size) = load_file(file_name, false);
+    if !bytes_read.is_null() {
+        *bytes_read = size as c_uint;
+    }
+    data
+}
+
+unsafe extern "C" fn load_file_text(file_name: *const c_char) -> *mut c_char {
+    load_file(file_name, true).0 as *mut c_char
+}
+
+#[cfg(test)]
+mod archive_test {
+    use super::*;
+
+    #[test]
+    fn test_archive() {
+        let mut builder = ArchiveBuilder::new().alignment(64);
+        let files: Vec<(String, Vec<u8>)> = (0..50)
+            .map(|i| (format!("dir{}/file_{}.bin", i % 3, i), vec![i as u8; i * 7]))
+            .collect();
+        for (path, data) in &files {
+            builder.add(path, data.clone(), false);
+        }
+        builder.add("./dir0//file_0.bin", b"replaced".to_vec(), false);
+        assert_eq!(builder.len(), 50);
+
+        let path = std::env::temp_dir().join(format!("raylib_archive_{}", std::process::id()));
+        builder.write_file(&path).unwrap();
+        let archive = unsafe { Archive::open(&path) }.unwrap();
+        std::fs::remove_file(&path).unwrap();
+
+        assert_eq!(archive.len(), 50);
+        for (path, data) in &files[1..] {
+            let entry = archive.entry(path).unwrap();
+            assert_eq!((entry.size, entry.compressed), (data.len(), false));
+            assert_eq!(entry.offset % 64, 0);
+            assert_eq!(archive.stored(path), Some(&data[..]));
+        }
+        let replaced = archive.read(".\\dir0\\file_0.bin").unwrap().unwrap();
+        assert_eq!(&replaced[..], b"replaced");
+        assert!(archive.entry("dir0/file_1.bin").is_none());
+        assert!(archive.entry("file_1.bin").is_none());
+
+        let hashes: Vec<u64> = (0..archive.len())
+            .map(|i| archive.entry_at(i).hash)
+            .collect();
+        assert!(hashes.windows(2).all(|w| w[0] <= w[1]));
+        assert_eq!(archive.entries().count(), 50);
+    }
+
+    #[test]
+    fn test_archive_invalid() {
+        let path = std::env::temp_dir().join(format!("raylib_archive_bad_{}", std::process::id()));
+        let mut data = Vec::new();
+        ArchiveBuilder::new().write(&mut data).unwrap();
+        data[8] = 3; // 3 entries, without index
+        std::fs::write(&path, &data).unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_err());
+        std::fs::write(&path, b"not an archive").unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_err());
+
+        // Compressed entries must fit the raylib decompression buffer
+        let mut builder = ArchiveBuilder::new();
+        builder.add("big.bin", vec![1; 16], false);
+        let mut data = Vec::new();
+        builder.write(&mut data).unwrap();
+        std::fs::write(&path, &data).unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_ok());
+        data[HEADER_SIZE + 24..HEADER_SIZE + 32]
+            .copy_from_slice(&(MAX_INFLATE_SIZE as u64 + 1).to_le_bytes());
+        data[HEADER_SIZE + 38..HEADER_SIZE + 40].copy_from_slice(&FLAG_DEFLATE.to_le_bytes());
+        std::fs::write(&path, &data).unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_err());
+
+        // Uncompressed entries are loaded as stored, their size must match
+        data[HEADER_SIZE + 38..HEADER_SIZE + 40].copy_from_slice(&0u16.to_le_bytes());
+        data[HEADER_SIZE + 24..HEADER_SIZE + 32].copy_from_slice(&17u64.to_le_bytes());
+        std::fs::write(&path, &data).unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_err());
+
+        // Lookups binary search the index
+        let mut builder = ArchiveBuilder::new();
+        builder.add("a.bin", vec![1; 16], false);
+        builder.add("b.bin", vec![2; 16], false);
+        let mut data = Vec::new();
+        builder.write(&mut data).unwrap();
+        let (first, second) =
+            data[HEADER_SIZE..HEADER_SIZE + 2 * ENTRY_SIZE].split_at_mut(ENTRY_SIZE);
+        first.swap_with_slice(second);
+        std::fs::write(&path, &data).unwrap();
+        assert!(unsafe { Archive::open(&path) }.is_err());
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_archive_builder_limits() {
+        let mut builder = ArchiveBuilder::new();
+        builder.add(&"a".repeat(u16::MAX as usize + 1), vec![1; 16], false);
+        let error = builder.write(&mut Vec::new()).unwrap_err();
+        assert_eq!(error.kind(), io::ErrorKind::InvalidInput);
+
+        // Alignment padding larger than a page
+        let mut builder = ArchiveBuilder::new().alignment(8192);
+        builder.add("a.bin", vec![1; 16], false);
+        builder.add("b.bin", vec![2; 16], false);
+        let mut data = Vec::new();
+        builder.write(&mut data).unwrap();
+        assert_eq!(data.len(), 8192 * 2 + 16);
+    }
+
+    #[test]
+    fn test_archive_load() {
+        let mut builder = ArchiveBuilder::new();
+        builder.add("raw.txt", b"raw text".to_vec(), false);
+        builder.add("packed.txt", vec![b'x'; 4096], true);
+        let path = std::env::temp_dir().join(format!("raylib_archive_load_{}", std::process::id()));
+        builder.write_file(&path).unwrap();
+        let archive = unsafe { Archive::open(&path) }.unwrap();
+        std::fs::remove_file(&path).unwrap();
+
+        for (name, data) in &[
+            ("raw.txt", b"raw text".to_vec()),
+            ("packed.txt", vec![b'x'; 4096]),
+        ] {
+            for nul in &[false, true] {
+                unsafe {
+                    let (buffer, len) = archive.load(name, *nul).unwrap().unwrap();
+                    assert_eq!(std::slice::from_raw_parts(buffer, len), &data[..]);
+                    if *nul {
+                        assert_eq!(*buffer.add(len), 0);
+                    }
+                    ffi::MemFree(buffer as *mut _);
+                }
+            }
+        }
+        assert!(unsafe { archive.load("missing.txt", false) }.is_none());
+    }
+}
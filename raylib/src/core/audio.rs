@@ -1,5 +1,6 @@
 //! Contains code related to audio. [`RaylibAudio`] plays sounds and music.
 
+use crate::core::file::lock_static_buffers;
 use crate::core::RaylibThread;
 use crate::ffi;
 use std::ffi::CString;
@@ -12,6 +13,9 @@ make_thin_wrapper!(AudioStream, ffi::AudioStream, ffi::CloseAudioStream);
 
 make_rslice!(WaveSamples, f32, ffi::UnloadWaveSamples);
 
+// Wave samples are in CPU memory, waves can be loaded on other threads
+unsafe impl Send for Wave {}
+
 /// A marker trait specifying an audio sample (`u8`, `i16`, or `f32`).
 pub trait AudioSample {}
 impl AudioSample for u8 {}
@@ -288,6 +292,7 @@ impl Wave {
     #[inline]
     pub fn load_wave(filename: &str) -> Result<Wave, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let w = unsafe { ffi::LoadWave(c_filename.as_ptr()) };
         if w.data.is_null() {
             return Err(format!("Cannot load wave {}", filename));
@@ -295,10 +300,27 @@ impl Wave {
         Ok(Wave(w))
     }
 
+    /// Decodes a wave file held in memory, `filetype` being its extension, e.g. `".wav"`.
+    pub fn load_wave_from_bytes(filetype: &str, bytes: &[u8]) -> Result<Wave, String> {
+        if bytes.len() > i32::MAX as usize {
+            return Err(format!("wave data of {} bytes is too large", bytes.len()));
+        }
+        let c_filetype = CString::new(filetype).unwrap();
+        let _lock = lock_static_buffers();
+        let w = unsafe {
+            ffi::LoadWaveFromMemory(c_filetype.as_ptr(), bytes.as_ptr(), bytes.len() as i32)
+        };
+        if w.data.is_null() {
+            return Err(format!("Cannot load {} wave from memory", filetype));
+        }
+        Ok(Wave(w))
+    }
+
     /// Export wave file. Extension must be .wav or .raw
     #[inline]
     pub fn export_wave(&self, filename: &str) -> bool {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe { ffi::ExportWave(self.0, c_filename.as_ptr()) }
     }
 
@@ -306,6 +328,7 @@ impl Wave {
     #[inline]
     pub fn export_wave_as_code(&self, filename: &str) -> bool {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe { ffi::ExportWaveAsCode(self.0, c_filename.as_ptr()) }
     }
 
@@ -371,6 +394,7 @@ impl Sound {
     /// Loads sound from file.
     pub fn load_sound(filename: &str) -> Result<Sound, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let s = unsafe { ffi::LoadSound(c_filename.as_ptr()) };
         if s.stream.buffer.is_null() {
             return Err(format!("failed to load sound {}", filename));
@@ -406,6 +430,7 @@ impl Music {
     // #[inline]
     pub fn load_music_stream(_: &RaylibThread, filename: &str) -> Result<Music, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let m = unsafe { ffi::LoadMusicStream(c_filename.as_ptr()) };
         if m.stream.buffer.is_null() {
             return Err(format!("music could not be loaded from file {}", filename));
@@ -0,0 +1,484 @@
+//! Render batch related functions
+use crate::core::color::Color;
+use crate::core::drawing::{RaylibDraw, RaylibDraw3D};
+use crate::core::math::{Rectangle, Vector2};
+use crate::core::{RaylibHandle, RaylibThread};
+use crate::ffi;
+
+/// Quads written per `rlVertexBatch` call by `draw_sprite_batch`.
+const SPRITE_CHUNK: usize = 256;
+
+make_thin_wrapper!(RenderBatch, ffi::RenderBatch, ffi::rlUnloadRenderBatch);
+make_thin_wrapper!(CommandList, ffi::CommandList, ffi::rlUnloadCommandList);
+
+impl RenderBatch {
+    /// Number of vertex buffers the batch cycles through.
+    pub fn buffers_count(&self) -> i32 {
+        self.0.buffersCount
+    }
+
+    /// Vertex data layout.
+    pub fn layout(&self) -> crate::consts::RenderBatchLayout {
+        let i: u32 = self.0.layout as u32;
+        unsafe { std::mem::transmute(i) }
+    }
+
+    /// Vertex data upload mode actually in use.
+    /// May differ from the requested one if persistent mapped buffers are not supported.
+    pub fn upload_mode(&self) -> crate::consts::RenderBatchUploadMode {
+        let i: u32 = self.0.uploadMode as u32;
+        unsafe { std::mem::transmute(i) }
+    }
+}
+
+impl CommandList {
+    /// Number of vertices recorded (quads are recorded as two triangles).
+    pub fn vertex_count(&self) -> i32 {
+        self.0.vertexCount
+    }
+
+    /// Number of draw calls issued every time the list is drawn.
+    pub fn draw_calls_count(&self) -> i32 {
+        self.0.drawsCount
+    }
+}
+
+impl RaylibHandle {
+    /// Creates an empty command list, record draws into it with `begin_command_list`.
+    pub fn load_command_list(&mut self, _: &RaylibThread) -> CommandList {
+        CommandList(ffi::CommandList {
+            vertexCount: 0,
+            drawsCount: 0,
+            draws: std::ptr::null_mut(),
+            vaoId: 0,
+            vboId: 0,
+        })
+    }
+
+    /// Loads a custom render batch.
+    /// `buffers` vertex buffers of `buffer_elements` quads each are cycled on every flush.
+    /// With `RL_BATCH_UPLOAD_PERSISTENT`, use 3 buffers so vertex data is written
+    /// while the GPU still reads the previous ones.
+    /// `RL_BATCH_LAYOUT_INTERLEAVED` keeps every vertex in a single buffer, one upload per flush.
+    pub fn load_render_batch(
+        &mut self,
+        _: &RaylibThread,
+        buffers: i32,
+        buffer_elements: i32,
+        upload_mode: crate::consts::RenderBatchUploadMode,
+        layout: crate::consts::RenderBatchLayout,
+    ) -> Result<RenderBatch, String> {
+        let b = unsafe {
+            ffi::rlLoadRenderBatchEx(buffers, buffer_elements, upload_mode as i32, layout as i32)
+        };
+        if b.vertexBuffer.is_null() {
+            return Err(format!("failed to load render batch."));
+        }
+        Ok(RenderBatch(b))
+    }
+
+    /// Returns the number of draw calls issued since the window was opened.
+    pub fn get_draw_calls_count(&self) -> u32 {
+        unsafe { ffi::rlGetDrawCallsCount() }
+    }
+
+    /// Returns the number of GL state calls (texture and shader binds, capabilities, blending)
+    /// issued and skipped as redundant since the window was opened, as `(issued, elided)`.
+    pub fn get_state_calls_count(&self) -> (u32, u32) {
+        unsafe { (ffi::rlGetStateCallsIssued(), ffi::rlGetStateCallsElided()) }
+    }
+
+    /// Returns the render statistics of the current frame so far.
+    /// Once the drawing handle is dropped, they cover the whole frame, up to the next `begin_drawing`.
+    pub fn render_stats(&self) -> crate::consts::RenderStats {
+        unsafe { ffi::rlGetRenderStats() }
+    }
+
+    /// Returns the render statistics of the previous frame.
+    pub fn render_stats_previous(&self) -> crate::consts::RenderStats {
+        unsafe { ffi::rlGetRenderStatsPrevious() }
+    }
+
+    /// Returns a copy of the commands recorded by the null backend since the current frame began
+    /// (or since initialization, before the first `begin_drawing`).
+    ///
+    /// The backend reuses its command buffer every frame, so the commands are copied out.
+    #[cfg(feature = "null_backend")]
+    pub fn null_commands(&self) -> Vec<crate::consts::NullCommand> {
+        let mut count = 0;
+        unsafe {
+            let commands = ffi::rlNullGetCommands(&mut count);
+            if commands.is_null() || count <= 0 {
+                return Vec::new();
+            }
+            std::slice::from_raw_parts(commands, count as usize).to_vec()
+        }
+    }
+
+    /// Returns the number of draw calls recorded by the null backend since the current frame began.
+    #[cfg(feature = "null_backend")]
+    pub fn null_draw_calls_count(&self) -> usize {
+        use crate::consts::NullCommandType::*;
+        self.null_commands()
+            .iter()
+            .filter(|c| {
+                c.type_ == RL_NULL_COMMAND_DRAW as i32
+                    || c.type_ == RL_NULL_COMMAND_DRAW_INSTANCED as i32
+            })
+            .count()
+    }
+
+    /// Forgets the cached GL state, so the next state calls are always issued.
+    /// Required after changing textures bindings, shader program or capabilities with raw GL calls.
+    pub fn reset_state_cache(&mut self, _: &RaylibThread) {
+        unsafe { ffi::rlResetStateCache() }
+    }
+}
+
+// Render Batch Mode
+
+pub struct RaylibRenderBatchMode<'a, T>(&'a mut T, &'a mut RenderBatch);
+impl<'a, T> Drop for RaylibRenderBatchMode<'a, T> {
+    fn drop(&mut self) {
+        // Draws what is left in the batch and goes back to the default one
+        unsafe { ffi::rlSetRenderBatchActive(std::ptr::null_mut()) }
+    }
+}
+impl<'a, T> std::ops::Deref for RaylibRenderBatchMode<'a, T> {
+    type Target = T;
+
+    fn deref(&self) -> &Self::Target {
+        &self.0
+    }
+}
+
+pub trait RaylibRenderBatchModeExt
+where
+    Self: Sized,
+{
+    /// Draws everything into `batch` instead of the default internal batch.
+    #[must_use]
+    fn begin_render_batch<'a>(
+        &'a mut self,
+        batch: &'a mut RenderBatch,
+    ) -> RaylibRenderBatchMode<'a, Self> {
+        unsafe { ffi::rlSetRenderBatchActive(&mut batch.0) }
+        RaylibRenderBatchMode(self, batch)
+    }
+}
+
+impl<D: RaylibDraw> RaylibRenderBatchModeExt for D {}
+impl<'a, T> RaylibDraw for RaylibRenderBatchMode<'a, T> {}
+impl<'a, T> RaylibDraw3D for RaylibRenderBatchMode<'a, T> {}
+
+// Command List Mode
+
+pub struct RaylibCommandListMode<'a, T>(&'a mut T, &'a mut CommandList);
+impl<'a, T> Drop for RaylibCommandListMode<'a, T> {
+    fn drop(&mut self) {
+        // Recorded vertex data replaces the list content and is uploaded once
+        unsafe { ffi::rlEndCommandList(&mut (self.1).0) }
+    }
+}
+impl<'a, T> std::ops::Deref for RaylibCommandListMode<'a, T> {
+    type Target = T;
+
+    fn deref(&self) -> &Self::Target {
+        &self.0
+    }
+}
+
+pub trait RaylibCommandListModeExt
+where
+    Self: Sized,
+{
+    /// Records batched draws into `list` instead of drawing them, replay it with `draw_command_list`.
+    /// Only draws going through the render batch (shapes, textures, text) are recorded,
+    /// with the modelview transform active when they are submitted.
+    #[must_use]
+    fn begin_command_list<'a>(
+        &'a mut self,
+        list: &'a mut CommandList,
+    ) -> RaylibCommandListMode<'a, Self> {
+        unsafe { ffi::rlBeginCommandList() }
+        RaylibCommandListMode(self, list)
+    }
+}
+
+impl<D: RaylibDraw> RaylibCommandListModeExt for D {}
+impl<'a, T> RaylibDraw for RaylibCommandListMode<'a, T> {}
+impl<'a, T> RaylibDraw3D for RaylibCommandListMode<'a, T> {}
+
+// Sorted Mode
+
+pub struct RaylibSortedMode<'a, T>(&'a mut T);
+impl<'a, T> RaylibSortedMode<'a, T> {
+    /// Sets the layer of the following draws, lower layers are drawn first.
+    pub fn set_draw_layer(&mut self, layer: i32) {
+        unsafe { ffi::rlSetDrawLayer(layer) }
+    }
+}
+impl<'a, T> Drop for RaylibSortedMode<'a, T> {
+    fn drop(&mut self) {
+        // Draws the sorted content, draw layer goes back to 0
+        unsafe { ffi::rlDisableSortedBatch() }
+    }
+}
+impl<'a, T> std::ops::Deref for RaylibSortedMode<'a, T> {
+    type Target = T;
+
+    fn deref(&self) -> &Self::Target {
+        &self.0
+    }
+}
+
+pub trait RaylibSortedModeExt
+where
+    Self: Sized,
+{
+    /// Reorders draws by layer, texture and mode when the render batch is drawn,
+    /// merging them into as few draw calls as possible.
+    /// Draws sharing those keep their order, other ones do not:
+    /// only use it for order-independent content (opaque or depth tested), use layers otherwise.
+    #[must_use]
+    fn begin_sorted_mode(&mut self) -> RaylibSortedMode<'_, Self> {
+        unsafe { ffi::rlEnableSortedBatch() }
+        RaylibSortedMode(self)
+    }
+}
+
+impl<D: RaylibDraw> RaylibSortedModeExt for D {}
+impl<'a, T> RaylibDraw for RaylibSortedMode<'a, T> {}
+impl<'a, T> RaylibDraw3D for RaylibSortedMode<'a, T> {}
+
+/// A textured quad for [`RaylibDraw::draw_sprite_batch`], same parameters as `draw_texture_pro`.
+#[repr(C)]
+#[derive(Default, Debug, Copy, Clone, PartialEq)]
+pub struct SpriteInstance {
+    pub dest: Rectangle,
+    pub source: Rectangle,
+    pub origin: Vector2,
+    pub rotation: f32,
+    pub tint: Color,
+}
+
+/// Computes the four vertex of a sprite quad (top-left, bottom-left, bottom-right, top-right),
+/// following `DrawTexturePro`.
+#[inline]
+fn sprite_quad(s: &SpriteInstance, width: f32, height: f32, z: f32, quad: &mut [ffi::BatchVertex]) {
+    let mut source = s.source;
+    let flip_x = source.width < 0.0;
+    if flip_x {
+        source.width = -source.width;
+    }
+    if source.height < 0.0 {
+        source.y -= source.height;
+    }
+
+    let (top_left, top_right, bottom_left, bottom_right) = if s.rotation == 0.0 {
+        let x = s.dest.x - s.origin.x;
+        let y = s.dest.y - s.origin.y;
+        (
+            (x, y),
+            (x + s.dest.width, y),
+            (x, y + s.dest.height),
+            (x + s.dest.width, y + s.dest.height),
+        )
+    } else {
+        let (sin, cos) = s.rotation.to_radians().sin_cos();
+        let (x, y) = (s.dest.x, s.dest.y);
+        let (dx, dy) = (-s.origin.x, -s.origin.y);
+        let (w, h) = (s.dest.width, s.dest.height);
+        (
+            (x + dx * cos - dy * sin, y + dx * sin + dy * cos),
+            (x + (dx + w) * cos - dy * sin, y + (dx + w) * sin + dy * cos),
+            (x + dx * cos - (dy + h) * sin, y + dx * sin + (dy + h) * cos),
+            (
+                x + (dx + w) * cos - (dy + h) * sin,
+                y + (dx + w) * sin + (dy + h) * cos,
+            ),
+        )
+    };
+
+    let (mut left, mut right) = (source.x / width, (source.x + source.width) / width);
+    if flip_x {
+        std::mem::swap(&mut left, &mut right);
+    }
+    let top = source.y / height;
+    let bottom = (source.y + source.height) / height;
+
+    let corners = [
+        (top_left, left, top),
+        (bottom_left, left, bottom),
+        (bottom_right, right, bottom),
+        (top_right, right, top),
+    ];
+    for (v, &((x, y), u, t)) in quad.iter_mut().zip(corners.iter()) {
+        *v = ffi::BatchVertex {
+            x,
+            y,
+            z,
+            u,
+            v: t,
+            r: s.tint.r,
+            g: s.tint.g,
+            b: s.tint.b,
+            a: s.tint.a,
+        };
+    }
+}
+
+/// Writes all `sprites` into the active render batch, see [`RaylibDraw::draw_sprite_batch`].
+pub(crate) fn draw_sprite_batch(texture: &ffi::Texture2D, sprites: &[SpriteInstance]) {
+    if texture.id == 0 || sprites.is_empty() {
+        return;
+    }
+
+    let width = texture.width as f32;
+    let height = texture.height as f32;
+    let mut quads = [ffi::BatchVertex::default(); SPRITE_CHUNK * 4];
+
+    unsafe {
+        // Keep some room for the vertex alignment rlSetTexture()/rlBegin() may add
+        let elements = (ffi::rlGetRenderBatchElements() - 2).max(1) as usize;
+
+        for chunk in sprites.chunks(elements.min(SPRITE_CHUNK)) {
+            let count = chunk.len() * 4;
+
+            ffi::rlCheckRenderBatchLimit(count as i32 + 4);
+            ffi::rlSetTexture(texture.id);
+            ffi::rlBegin(ffi::RL_QUADS as i32);
+
+            let z = ffi::rlGetRenderBatchDepth();
+            for (s, quad) in chunk.iter().zip(quads.chunks_exact_mut(4)) {
+                sprite_quad(s, width, height, z, quad);
+            }
+            ffi::rlVertexBatch(quads.as_ptr(), count as i32);
+
+            ffi::rlEnd();
+            ffi::rlSetTexture(0);
+        }
+    }
+}
+
+/// Draws all `sprites` with a single instanced draw call, see [`RaylibDraw::draw_sprites_instanced`].
+pub(crate) fn draw_sprites_instanced(texture: &ffi::Texture2D, sprites: &[SpriteInstance]) {
+    // SpriteInstance and ffi::SpriteInstance share the same layout
+    let drawn = unsafe {
+        ffi::rlDrawSpritesInstanced(
+            texture.id,
+            texture.width,
+            texture.height,
+            sprites.as_ptr() as *const ffi::SpriteInstance,
+            sprites.len() as i32,
+        )
+    };
+    if !drawn {
+        draw_sprite_batch(texture, sprites);
+    }
+}
+
+#[cfg(test)]
+mod batch_test {
+    use super::*;
+
+    #[test]
+    fn test_sprite_instance_layout() {
+        assert_eq!(
+            std::mem::size_of::<SpriteInstance>(),
+            std::mem::size_of::<ffi::SpriteInstance>()
+        );
+        assert_eq!(
+            std::mem::align_of::<SpriteInstance>(),
+            std::mem::align_of::<ffi::SpriteInstance>()
+        );
+    }
+
+    #[cfg(feature = "null_backend")]
+    #[test]
+    fn test_null_backend_command_list() {
+        use crate::consts::NullCommandType::*;
+        use crate::core::math::Matrix;
+        use crate::core::texture::Image;
+
+        let _window = crate::core::test_window_lock();
+        let (mut rl, thread) = crate::init().size(640, 480).build();
+        let image = Image::gen_image_color(8, 8, Color::WHITE);
+        let tiles = rl.load_texture_from_image(&thread, &image).unwrap();
+        let mut list = rl.load_command_list(&thread);
+
+        for frame in 0..3 {
+            {
+                let mut d = rl.begin_drawing(&thread);
+                if frame == 0 {
+                    let mut r = d.begin_command_list(&mut list);
+                    for i in 0..100 {
+                        r.draw_texture(&tiles, i % 10 * 8, i / 10 * 8, Color::WHITE);
+                    }
+                }
+                d.draw_command_list(&list, Matrix::translate(frame as f32, 0.0, 0.0));
+            }
+
+            // Quads recorded as triangles, merged into a single draw and never uploaded again
+            assert_eq!(list.vertex_count(), 600);
+            assert_eq!(list.draw_calls_count(), 1);
+            assert_eq!(rl.null_draw_calls_count(), 1);
+            let count = |t: ffi::NullCommandType| {
+                rl.null_commands()
+                    .iter()
+                    .filter(|c| c.type_ == t as i32)
+                    .count()
+            };
+            assert_eq!(count(RL_NULL_COMMAND_FLUSH), 0);
+            assert_eq!(
+                count(RL_NULL_COMMAND_BUFFER_UPLOAD),
+                if frame == 0 { 1 } else { 0 }
+            );
+        }
+    }
+
+    #[cfg(feature = "null_backend")]
+    #[test]
+    fn test_null_backend_draw_calls() {
+        use crate::consts::NullCommandType::*;
+        use crate::core::texture::Image;
+
+        let _window = crate::core::test_window_lock();
+        let (mut rl, thread) = crate::init().size(640, 480).build();
+        let image = Image::gen_image_color(8, 8, Color::WHITE);
+        let a = rl.load_texture_from_image(&thread, &image).unwrap();
+        let b = rl.load_texture_from_image(&thread, &image).unwrap();
+
+        for _ in 0..2 {
+            {
+                let mut d = rl.begin_drawing(&thread);
+                d.clear_background(Color::BLACK);
+                for i in 0..10 {
+                    d.draw_texture(&a, i, 0, Color::WHITE);
+                    d.draw_texture(&b, i, 8, Color::WHITE);
+                }
+            }
+
+            // Every texture switch starts a new draw call, all of them in a single flush
+            assert_eq!(rl.null_draw_calls_count(), 20);
+            let count = |t: ffi::NullCommandType| {
+                rl.null_commands()
+                    .iter()
+                    .filter(|c| c.type_ == t as i32)
+                    .count()
+            };
+            assert_eq!(count(RL_NULL_COMMAND_FLUSH), 1);
+            assert_eq!(count(RL_NULL_COMMAND_CLEAR), 1);
+            assert_eq!(count(RL_NULL_COMMAND_TEXTURE_UPLOAD), 0);
+
+            let commands = rl.null_commands();
+            let draws = commands
+                .iter()
+                .filter(|c| c.type_ == RL_NULL_COMMAND_DRAW as i32);
+            for (i, c) in draws.enumerate() {
+                assert_eq!(c.id, if i % 2 == 0 { a.id } else { b.id });
+                assert_eq!(c.count, 6);
+            }
+        }
+    }
+}
@@ -0,0 +1,537 @@
+//! 2D broad phase: find the pairs of rectangles and circles that may collide
+use crate::core::math::{Rectangle, Vector2};
+use std::collections::HashMap;
+use std::hash::{BuildHasherDefault, Hasher};
+
+/// Marks an id without body in the slots arrays.
+const NO_SLOT: u32 = u32::MAX;
+
+/// Broad phase over 2D bodies identified by `u32` ids.
+///
+/// Bodies are stored by their axis aligned bounds, kept from one frame to the next so only
+/// moved bodies cost an update. Ids index internal arrays: keep them dense, usually the index
+/// of the body in the game's own arrays.
+///
+/// [`BroadPhase2D::pairs`] only reports bodies whose bounds overlap, the narrow phase is left
+/// to the exact checks (`check_collision_recs`, `check_collision_circles`, ...).
+pub trait BroadPhase2D {
+    /// Inserts body `id`, or moves it if it already exists.
+    fn set(&mut self, id: u32, bounds: Rectangle);
+
+    /// Removes body `id`, does nothing if it does not exist.
+    fn remove(&mut self, id: u32);
+
+    /// Removes every body.
+    fn clear(&mut self);
+
+    /// Number of bodies.
+    fn len(&self) -> usize;
+
+    fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Overwrites `out` with the pairs of bodies whose bounds overlap, as `(a, b)` with
+    /// `a < b`, in no particular order.
+    fn pairs(&mut self, out: &mut Vec<(u32, u32)>);
+
+    /// Inserts or moves a circle, stored by its bounds.
+    fn set_circle(&mut self, id: u32, center: Vector2, radius: f32) {
+        self.set(id, circle_bounds(center, radius));
+    }
+
+    /// Sets bodies `0..rects.len()` to `rects`, and removes the bodies with a greater id.
+    fn update_rects(&mut self, rects: &[Rectangle]) {
+        for (id, r) in rects.iter().enumerate() {
+            self.set(id as u32, *r);
+        }
+        self.truncate(rects.len());
+    }
+
+    /// Sets bodies `0..centers.len()` to circles, and removes the bodies with a greater id.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `radii` is shorter than `centers`.
+    fn update_circles(&mut self, centers: &[Vector2], radii: &[f32]) {
+        let radii = &radii[..centers.len()];
+        for (id, (c, r)) in centers.iter().zip(radii.iter()).enumerate() {
+            self.set_circle(id as u32, *c, *r);
+        }
+        self.truncate(centers.len());
+    }
+
+    /// Removes the bodies with an id greater or equal to `len`.
+    fn truncate(&mut self, len: usize);
+}
+
+/// Bounds of a circle.
+#[inline]
+pub fn circle_bounds(center: Vector2, radius: f32) -> Rectangle {
+    Rectangle::new(
+        center.x - radius,
+        center.y - radius,
+        radius * 2.0,
+        radius * 2.0,
+    )
+}
+
+#[inline]
+fn overlaps(a: &Rectangle, b: &Rectangle) -> bool {
+    a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height
+}
+
+/// Multiplicative hash for the packed cell coordinates, the std SipHash is several times
+/// slower and its DoS resistance is not needed here.
+#[derive(Default)]
+struct CellHasher(u64);
+
+impl Hasher for CellHasher {
+    #[inline]
+    fn finish(&self) -> u64 {
+        self.0
+    }
+
+    fn write(&mut self, bytes: &[u8]) {
+        for b in bytes {
+            self.write_u64(*b as u64);
+        }
+    }
+
+    #[inline]
+    fn write_u64(&mut self, n: u64) {
+        self.0 = (self.0.rotate_left(5) ^ n).wrapping_mul(0x51_7c_c1_b7_27_22_0a_95);
+    }
+}
+
+type CellMap = HashMap<u64, Vec<u32>, BuildHasherDefault<CellHasher>>;
+
+/// Cells covered by a body, inclusive.
+#[derive(Debug, Copy, Clone, PartialEq, Eq)]
+struct CellRange {
+    x0: i32,
+    y0: i32,
+    x1: i32,
+    y1: i32,
+}
+
+#[inline]
+fn cell_key(x: i32, y: i32) -> u64 {
+    ((x as u32 as u64) << 32) | y as u32 as u64
+}
+
+/// Uniform grid hash: every body is listed in the cells its bounds cover.
+///
+/// Works best with a cell size around the size of the common bodies; bodies much larger
+/// than a cell are listed in many cells. The world is unbounded, only cells bodies went
+/// through use memory, [`SpatialHash::shrink`] releases the empty ones.
+#[derive(Debug, Clone)]
+pub struct SpatialHash {
+    inv_cell_size: f32,
+    cells: CellMap,
+    /// Bounds and cells of body `id`, `None` if it does not exist.
+    bodies: Vec<Option<(Rectangle, CellRange)>>,
+    count: usize,
+}
+
+impl SpatialHash {
+    /// Creates an empty grid of `cell_size` square cells.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `cell_size` is not strictly positive.
+    pub fn new(cell_size: f32) -> SpatialHash {
+        assert!(cell_size > 0.0, "cell size must be positive");
+        SpatialHash {
+            inv_cell_size: 1.0 / cell_size,
+            cells: CellMap::default(),
+            bodies: Vec::new(),
+            count: 0,
+        }
+    }
+
+    /// Cell size given to [`SpatialHash::new`].
+    pub fn cell_size(&self) -> f32 {
+        1.0 / self.inv_cell_size
+    }
+
+    /// Number of allocated cells, empty ones included.
+    pub fn cell_count(&self) -> usize {
+        self.cells.len()
+    }
+
+    /// Releases the empty cells.
+    pub fn shrink(&mut self) {
+        self.cells.retain(|_, cell| !cell.is_empty());
+    }
+
+    /// Bounds of body `id`.
+    pub fn get(&self, id: u32) -> Option<Rectangle> {
+        self.bodies.get(id as usize).and_then(|b| b.map(|b| b.0))
+    }
+
+    /// Overwrites `out` with the bodies whose bounds overlap `area`, in no particular order.
+    pub fn query(&self, area: Rectangle, out: &mut Vec<u32>) {
+        out.clear();
+        let range = self.range(&area);
+        for x in range.x0..=range.x1 {
+            for y in range.y0..=range.y1 {
+                let cell = match self.cells.get(&cell_key(x, y)) {
+                    Some(cell) => cell,
+                    None => continue,
+                };
+                for id in cell.iter() {
+                    let (bounds, cells) = self.bodies[*id as usize].unwrap();
+                    // Report a body once, from the first cell it shares with `area`
+                    if x == range.x0.max(cells.x0)
+                        && y == range.y0.max(cells.y0)
+                        && overlaps(&area, &bounds)
+                    {
+                        out.push(*id);
+                    }
+                }
+            }
+        }
+    }
+
+    #[inline]
+    fn cell(&self, v: f32) -> i32 {
+        (v * self.inv_cell_size).floor() as i32
+    }
+
+    #[inline]
+    fn range(&self, r: &Rectangle) -> CellRange {
+        CellRange {
+            x0: self.cell(r.x),
+            y0: self.cell(r.y),
+            x1: self.cell(r.x + r.width),
+            y1: self.cell(r.y + r.height),
+        }
+    }
+
+    fn link(&mut self, id: u32, range: CellRange) {
+        for x in range.x0..=range.x1 {
+            for y in range.y0..=range.y1 {
+                self.cells.entry(cell_key(x, y)).or_default().push(id);
+            }
+        }
+    }
+
+    fn unlink(&mut self, id: u32, range: CellRange) {
+        for x in range.x0..=range.x1 {
+            for y in range.y0..=range.y1 {
+                let key = cell_key(x, y);
+                // Emptied cells are kept, bodies moving around would keep reallocating them
+                if let Some(cell) = self.cells.get_mut(&key) {
+                    if let Some(i) = cell.iter().position(|b| *b == id) {
+                        cell.swap_remove(i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+impl BroadPhase2D for SpatialHash {
+    fn set(&mut self, id: u32, bounds: Rectangle) {
+        let range = self.range(&bounds);
+        let index = id as usize;
+        if index >= self.bodies.len() {
+            self.bodies.resize(index + 1, None);
+        }
+
+        match self.bodies[index] {
+            // Most bodies stay in the same cells from one frame to the next
+            Some((_, old)) if old == range => {}
+            Some((_, old)) => {
+                self.unlink(id, old);
+                self.link(id, range);
+            }
+            None => {
+                self.link(id, range);
+                self.count += 1;
+            }
+        }
+        self.bodies[index] = Some((bounds, range));
+    }
+
+    fn remove(&mut self, id: u32) {
+        if let Some((_, range)) = self.bodies.get_mut(id as usize).and_then(|b| b.take()) {
+            self.unlink(id, range);
+            self.count -= 1;
+        }
+    }
+
+    fn clear(&mut self) {
+        self.cells.clear();
+        self.bodies.clear();
+        self.count = 0;
+    }
+
+    fn len(&self) -> usize {
+        self.count
+    }
+
+    fn truncate(&mut self, len: usize) {
+        for id in len..self.bodies.len() {
+            self.remove(id as u32);
+        }
+        self.bodies.truncate(len);
+    }
+
+    fn pairs(&mut self, out: &mut Vec<(u32, u32)>) {
+        out.clear();
+        for (key, cell) in self.cells.iter() {
+            if cell.len() < 2 {
+                continue;
+            }
+            let (x, y) = ((key >> 32) as u32 as i32, *key as u32 as i32);
+            for (i, a) in cell.iter().enumerate() {
+                let (bounds_a, cells_a) = self.bodies[*a as usize].unwrap();
+                for b in cell[i + 1..].iter() {
+                    let (bounds_b, cells_b) = self.bodies[*b as usize].unwrap();
+                    // A pair sharing several cells is reported from the first one only
+                    if x == cells_a.x0.max(cells_b.x0)
+                        && y == cells_a.y0.max(cells_b.y0)
+                        && overlaps(&bounds_a, &bounds_b)
+                    {
+                        out.push(if a < b { (*a, *b) } else { (*b, *a) });
+                    }
+                }
+            }
+        }
+    }
+}
+
+#[derive(Debug, Copy, Clone)]
+struct Interval {
+    min_x: f32,
+    max_x: f32,
+    min_y: f32,
+    max_y: f32,
+    id: u32,
+}
+
+/// Sweep and prune: bodies sorted along the x axis, pairs are found by sweeping the sorted
+/// intervals.
+///
+/// Bodies barely move between frames so the order stays nearly sorted, and sorting it again
+/// is close to linear. Needs no tuning, unlike [`SpatialHash`], but degrades when many bodies
+/// share the same x range (e.g. a vertical wall of bodies).
+#[derive(Debug, Default, Clone)]
+pub struct SweepAndPrune {
+    intervals: Vec<Interval>,
+    /// Index of body `id` in `intervals`, `NO_SLOT` if it does not exist.
+    slots: Vec<u32>,
+    sorted: bool,
+}
+
+impl SweepAndPrune {
+    pub fn new() -> SweepAndPrune {
+        SweepAndPrune::default()
+    }
+
+    /// Bounds of body `id`.
+    pub fn get(&self, id: u32) -> Option<Rectangle> {
+        match self.slots.get(id as usize) {
+            Some(slot) if *slot != NO_SLOT => {
+                let i = self.intervals[*slot as usize];
+                Some(Rectangle::new(
+                    i.min_x,
+                    i.min_y,
+                    i.max_x - i.min_x,
+                    i.max_y - i.min_y,
+                ))
+            }
+            _ => None,
+        }
+    }
+
+    fn sort(&mut self) {
+        if self.sorted {
+            return;
+        }
+        // The std stable sort finds the already sorted runs, nearly sorted input is fast
+        self.intervals.sort_by(|a, b| a.min_x.total_cmp(&b.min_x));
+        for (i, interval) in self.intervals.iter().enumerate() {
+            self.slots[interval.id as usize] = i as u32;
+        }
+        self.sorted = true;
+    }
+}
+
+impl BroadPhase2D for SweepAndPrune {
+    fn set(&mut self, id: u32, bounds: Rectangle) {
+        let interval = Interval {
+            min_x: bounds.x,
+            max_x: bounds.x + bounds.width,
+            min_y: bounds.y,
+            max_y: bounds.y + bounds.height,
+            id,
+        };
+        let index = id as usize;
+        if index >= self.slots.len() {
+            self.slots.resize(index + 1, NO_SLOT);
+        }
+
+        let slot = self.slots[index];
+        if slot == NO_SLOT {
+            self.slots[index] = self.intervals.len() as u32;
+            self.intervals.push(interval);
+            self.sorted = false;
+        } else {
+            let old = &mut self.intervals[slot as usize];
+            self.sorted &= old.min_x == interval.min_x;
+            *old = interval;
+        }
+    }
+
+    fn remove(&mut self, id: u32) {
+        let slot = match self.slots.get(id as usize) {
+            Some(slot) if *slot != NO_SLOT => *slot as usize,
+            _ => return,
+        };
+        self.slots[id as usize] = NO_SLOT;
+        self.intervals.swap_remove(slot);
+        if let Some(moved) = self.intervals.get(slot) {
+            self.slots[moved.id as usize] = slot as u32;
+            self.sorted = false;
+        }
+    }
+
+    fn clear(&mut self) {
+        self.intervals.clear();
+        self.slots.clear();
+        self.sorted = true;
+    }
+
+    fn len(&self) -> usize {
+        self.intervals.len()
+    }
+
+    fn truncate(&mut self, len: usize) {
+        if len < self.slots.len() {
+            for id in len..self.slots.len() {
+                self.remove(id as u32);
+            }
+            self.slots.truncate(len);
+        }
+    }
+
+    fn pairs(&mut self, out: &mut Vec<(u32, u32)>) {
+        out.clear();
+        self.sort();
+        for (i, a) in self.intervals.iter().enumerate() {
+            for b in self.intervals[i + 1..].iter() {
+                if b.min_x > a.max_x {
+                    break;
+                }
+                if a.min_y <= b.max_y && b.min_y <= a.max_y {
+                    out.push((a.id.min(b.id), a.id.max(b.id)));
+                }
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod broadphase_test {
+    use super::*;
+
+    /// Deterministic pseudo random bodies.
+    fn bodies(count: usize, seed: u32) -> Vec<Rectangle> {
+        let mut state = seed;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            (state % 10_000) as f32 / 10.0
+        };
+        (0..count)
+            .map(|_| Rectangle::new(next() - 500.0, next() - 500.0, next() / 40.0, next() / 40.0))
+            .collect()
+    }
+
+    fn brute_force(rects: &[Rectangle]) -> Vec<(u32, u32)> {
+        let mut pairs = Vec::new();
+        for (i, a) in rects.iter().enumerate() {
+            for (j, b) in rects.iter().enumerate().skip(i + 1) {
+                if overlaps(a, b) {
+                    pairs.push((i as u32, j as u32));
+                }
+            }
+        }
+        pairs
+    }
+
+    fn sorted_pairs(broadphase: &mut impl BroadPhase2D) -> Vec<(u32, u32)> {
+        let mut pairs = Vec::new();
+        broadphase.pairs(&mut pairs);
+        pairs.sort_unstable();
+        pairs
+    }
+
+    fn check(broadphase: &mut impl BroadPhase2D) {
+        let mut rects = bodies(2000, 7);
+        broadphase.update_rects(&rects);
+        assert_eq!(broadphase.len(), rects.len());
+        let expected = brute_force(&rects);
+        assert!(!expected.is_empty());
+        assert_eq!(sorted_pairs(broadphase), expected);
+
+        // Move a few bodies, remove the last ones
+        for (i, r) in rects.iter_mut().enumerate().step_by(3) {
+            r.x += (i % 7) as f32 * 3.0 - 9.0;
+            r.y -= (i % 5) as f32 * 4.0;
+        }
+        rects.truncate(1500);
+        broadphase.update_rects(&rects);
+        assert_eq!(broadphase.len(), rects.len());
+        assert_eq!(sorted_pairs(broadphase), brute_force(&rects));
+
+        broadphase.remove(3);
+        assert_eq!(broadphase.len(), rects.len() - 1);
+        assert!(sorted_pairs(broadphase)
+            .iter()
+            .all(|(a, b)| *a != 3 && *b != 3));
+
+        broadphase.clear();
+        assert!(broadphase.is_empty());
+        assert!(sorted_pairs(broadphase).is_empty());
+    }
+
+    #[test]
+    fn test_spatial_hash() {
+        check(&mut SpatialHash::new(20.0));
+
+        let mut hash = SpatialHash::new(10.0);
+        hash.set_circle(0, Vector2::new(0.0, 0.0), 5.0);
+        hash.set_circle(1, Vector2::new(8.0, 0.0), 5.0);
+        hash.set(2, Rectangle::new(-100.0, -100.0, 200.0, 1.0));
+        let mut found = Vec::new();
+        hash.query(Rectangle::new(-1.0, -1.0, 2.0, 2.0), &mut found);
+        assert_eq!(found, vec![0]);
+        hash.query(Rectangle::new(-50.0, -99.5, 100.0, 100.0), &mut found);
+        found.sort_unstable();
+        assert_eq!(found, vec![0, 1, 2]);
+        assert_eq!(sorted_pairs(&mut hash), vec![(0, 1)]);
+        hash.remove(2);
+        let cells = hash.cell_count();
+        hash.shrink();
+        assert!(hash.cell_count() < cells);
+        assert_eq!(sorted_pairs(&mut hash), vec![(0, 1)]);
+    }
+
+    #[test]
+    fn test_sweep_and_prune() {
+        check(&mut SweepAndPrune::new());
+
+        let mut sap = SweepAndPrune::new();
+        let centers = [Vector2::new(0.0, 0.0), Vector2::new(8.0, 0.0)];
+        sap.update_circles(&centers, &[5.0, 5.0]);
+        assert_eq!(sorted_pairs(&mut sap), vec![(0, 1)]);
+        sap.set_circle(1, Vector2::new(8.0, 20.0), 5.0);
+        assert!(sorted_pairs(&mut sap).is_empty());
+        assert_eq!(sap.get(0), Some(Rectangle::new(-5.0, -5.0, 10.0, 10.0)));
+    }
+}
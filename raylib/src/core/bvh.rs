@@ -0,0 +1,734 @@
+//! Bounding volume hierarchy over mesh triangles, for ray picking and overlap queries
+use crate::core::math::{Matrix, Ray, RayHitInfo, Vector3};
+use crate::ffi;
+
+/// Bins evaluated along each axis when looking for a split.
+const SAH_BINS: usize = 12;
+/// Nodes with this many triangles or less are not split.
+const MAX_LEAF_TRIANGLES: usize = 4;
+/// Same epsilon as `GetCollisionRayTriangle`.
+const EPSILON: f32 = 0.000001;
+
+#[derive(Debug, Copy, Clone)]
+struct Aabb {
+    min: Vector3,
+    max: Vector3,
+}
+
+impl Aabb {
+    const EMPTY: Aabb = Aabb {
+        min: Vector3 {
+            x: f32::INFINITY,
+            y: f32::INFINITY,
+            z: f32::INFINITY,
+        },
+        max: Vector3 {
+            x: f32::NEG_INFINITY,
+            y: f32::NEG_INFINITY,
+            z: f32::NEG_INFINITY,
+        },
+    };
+
+    #[inline]
+    fn grow(&mut self, p: Vector3) {
+        self.min = self.min.min(p);
+        self.max = self.max.max(p);
+    }
+
+    #[inline]
+    fn union(&mut self, b: &Aabb) {
+        self.min = self.min.min(b.min);
+        self.max = self.max.max(b.max);
+    }
+
+    #[inline]
+    fn half_area(&self) -> f32 {
+        let e = self.max - self.min;
+        if e.x < 0.0 {
+            return 0.0;
+        }
+        e.x * e.y + e.y * e.z + e.z * e.x
+    }
+}
+
+/// 32 bytes node, two per cache line.
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+struct Node {
+    min: Vector3,
+    /// First triangle of a leaf, first child of an inner node (the second child follows it).
+    start: u32,
+    max: Vector3,
+    /// Triangles of a leaf, 0 for inner nodes.
+    count: u32,
+}
+
+impl Node {
+    /// Entry distance of `ray` into the node box, `f32::INFINITY` if it misses it.
+    #[inline]
+    fn ray_entry(&self, origin: Vector3, inv_dir: Vector3) -> f32 {
+        let tx1 = (self.min.x - origin.x) * inv_dir.x;
+        let tx2 = (self.max.x - origin.x) * inv_dir.x;
+        let ty1 = (self.min.y - origin.y) * inv_dir.y;
+        let ty2 = (self.max.y - origin.y) * inv_dir.y;
+        let tz1 = (self.min.z - origin.z) * inv_dir.z;
+        let tz2 = (self.max.z - origin.z) * inv_dir.z;
+
+        let tmin = tx1.min(tx2).max(ty1.min(ty2)).max(tz1.min(tz2));
+        let tmax = tx1.max(tx2).min(ty1.max(ty2)).min(tz1.max(tz2));
+        if tmax >= tmin.max(0.0) {
+            tmin
+        } else {
+            f32::INFINITY
+        }
+    }
+
+    #[inline]
+    fn overlaps_sphere(&self, center: Vector3, radius: f32) -> bool {
+        let closest = center.max(self.min).min(self.max);
+        let d = closest - center;
+        d.dot(d) <= radius * radius
+    }
+}
+
+/// Bounding volume hierarchy over the triangles of a mesh or model, built once and queried
+/// many times.
+///
+/// Built with binned SAH splits into a flat node array, triangles are copied in leaves order so
+/// traversal reads contiguous memory. Triangles are identified by their index in the source:
+/// mesh after mesh for models, then triangle order within each mesh.
+/// Call `refit_*` after moving vertices (e.g. animations) to update the boxes without
+/// rebuilding, queries stay correct but slow down as vertices move away from the built pose.
+#[derive(Debug, Clone)]
+pub struct MeshBvh {
+    nodes: Vec<Node>,
+    triangles: Vec<[Vector3; 3]>,
+    /// Source index of every triangle of `triangles`.
+    indices: Vec<u32>,
+}
+
+impl MeshBvh {
+    /// Builds a hierarchy over `mesh` triangles, animated vertices are used when present.
+    pub fn from_mesh(mesh: impl AsRef<ffi::Mesh>) -> MeshBvh {
+        let mut triangles = Vec::new();
+        mesh_triangles(mesh.as_ref(), None, &mut triangles);
+        MeshBvh::from_triangles(&triangles)
+    }
+
+    /// Builds a hierarchy over every mesh of `model`, with the model transform applied like
+    /// `get_collision_ray_model` does.
+    pub fn from_model(model: impl AsRef<ffi::Model>) -> MeshBvh {
+        MeshBvh::from_triangles(&model_triangles(model.as_ref()))
+    }
+
+    /// Builds a hierarchy over `triangles`.
+    pub fn from_triangles(triangles: &[[Vector3; 3]]) -> MeshBvh {
+        let count = triangles.len();
+        let mut bounds = Vec::with_capacity(count);
+        let mut centroids = Vec::with_capacity(count);
+        for t in triangles {
+            let mut b = Aabb::EMPTY;
+            t.iter().for_each(|v| b.grow(*v));
+            bounds.push(b);
+            centroids.push((b.min + b.max) * 0.5);
+        }
+
+        let mut indices: Vec<u32> = (0..count as u32).collect();
+        let mut nodes = Vec::with_capacity(2 * count / MAX_LEAF_TRIANGLES + 1);
+        nodes.push(Node {
+            min: Aabb::EMPTY.min,
+            start: 0,
+            max: Aabb::EMPTY.max,
+            count: count as u32,
+        });
+
+        let mut stack = vec![0];
+        while let Some(n) = stack.pop() {
+            let start = nodes[n].start as usize;
+            let end = start + nodes[n].count as usize;
+
+            let mut node_bounds = Aabb::EMPTY;
+            let mut centroid_bounds = Aabb::EMPTY;
+            for i in &indices[start..end] {
+                node_bounds.union(&bounds[*i as usize]);
+                centroid_bounds.grow(centroids[*i as usize]);
+            }
+            nodes[n].min = node_bounds.min;
+            nodes[n].max = node_bounds.max;
+
+            if end - start <= MAX_LEAF_TRIANGLES {
+                continue;
+            }
+            let (axis, bin) = match find_split(
+                &indices[start..end],
+                &bounds,
+                &centroids,
+                &centroid_bounds,
+                node_bounds.half_area(),
+            ) {
+                Some(split) => split,
+                None => continue,
+            };
+
+            // Partition triangles with the same binning find_split used
+            let (cmin, scale) = bin_params(&centroid_bounds, axis);
+            let mut mid = start;
+            for i in start..end {
+                if bin_index(axis_of(centroids[indices[i] as usize], axis), cmin, scale) < bin {
+                    indices.swap(i, mid);
+                    mid += 1;
+                }
+            }
+            if mid == start || mid == end {
+                continue;
+            }
+
+            let left = nodes.len();
+            for (s, e) in [(start, mid), (mid, end)].iter() {
+                nodes.push(Node {
+                    min: Aabb::EMPTY.min,
+                    start: *s as u32,
+                    max: Aabb::EMPTY.max,
+                    count: (e - s) as u32,
+                });
+            }
+            nodes[n].start = left as u32;
+            nodes[n].count = 0;
+            stack.push(left + 1);
+            stack.push(left);
+        }
+
+        MeshBvh {
+            nodes,
+            triangles: indices.iter().map(|i| triangles[*i as usize]).collect(),
+            indices,
+        }
+    }
+
+    /// Number of triangles.
+    #[inline]
+    pub fn triangle_count(&self) -> usize {
+        self.triangles.len()
+    }
+
+    /// Number of nodes.
+    #[inline]
+    pub fn node_count(&self) -> usize {
+        self.nodes.len()
+    }
+
+    /// Gets collision info between ray and the closest triangle, same as
+    /// `get_collision_ray_model`.
+    pub fn raycast(&self, ray: Ray) -> RayHitInfo {
+        self.raycast_triangle(ray)
+            .map_or(RayHitInfo::default(), |(_, hit)| hit)
+    }
+
+    /// Gets collision info between ray and the closest triangle, and its source index.
+    pub fn raycast_triangle(&self, ray: Ray) -> Option<(usize, RayHitInfo)> {
+        let mut closest = f32::INFINITY;
+        let mut hit = None;
+        self.traverse_ray(ray, |i, t| {
+            if t < closest {
+                closest = t;
+                hit = Some(i);
+            }
+            closest
+        });
+
+        hit.map(|i| {
+            let [a, b, c] = self.triangles[i];
+            let hit = RayHitInfo {
+                hit: true,
+                distance: closest,
+                position: ray.position + ray.direction * closest,
+                normal: (b - a).cross(c - a).normalized(),
+            };
+            (self.indices[i] as usize, hit)
+        })
+    }
+
+    /// Checks if ray hits any triangle closer than `max_distance` (in `ray.direction` units).
+    /// Stops at the first hit found, faster than `raycast` for occlusion tests.
+    pub fn raycast_any(&self, ray: Ray, max_distance: f32) -> bool {
+        let mut found = false;
+        self.traverse_ray(ray, |_, t| {
+            if t < max_distance {
+                found = true;
+                return f32::NEG_INFINITY;
+            }
+            max_distance
+        });
+        found
+    }
+
+    /// Writes the source index of every triangle touching the sphere into `out`, cleared first.
+    pub fn sphere_overlap(&self, center: Vector3, radius: f32, out: &mut Vec<usize>) {
+        out.clear();
+        if self.triangles.is_empty() {
+            return;
+        }
+
+        let mut stack = Vec::with_capacity(64);
+        stack.push(0);
+        while let Some(n) = stack.pop() {
+            let node = &self.nodes[n];
+            if !node.overlaps_sphere(center, radius) {
+                continue;
+            }
+            if node.count == 0 {
+                stack.push(node.start as usize + 1);
+                stack.push(node.start as usize);
+                continue;
+            }
+
+            let range = node.start as usize..(node.start + node.count) as usize;
+            for i in range {
+                let [a, b, c] = self.triangles[i];
+                let d = closest_point_triangle(center, a, b, c) - center;
+                if d.dot(d) <= radius * radius {
+                    out.push(self.indices[i] as usize);
+                }
+            }
+        }
+    }
+
+    /// Updates the hierarchy after `mesh` vertices moved, topology must be unchanged.
+    pub fn refit_mesh(&mut self, mesh: impl AsRef<ffi::Mesh>) {
+        let mut triangles = Vec::with_capacity(self.triangles.len());
+        mesh_triangles(mesh.as_ref(), None, &mut triangles);
+        self.refit(&triangles);
+    }
+
+    /// Updates the hierarchy after `model` vertices or transform changed, topology must be
+    /// unchanged.
+    pub fn refit_model(&mut self, model: impl AsRef<ffi::Model>) {
+        self.refit(&model_triangles(model.as_ref()));
+    }
+
+    /// Updates the hierarchy with new triangles positions, in the same order as the ones it was
+    /// built from.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `triangles` has less triangles than the hierarchy.
+    pub fn refit(&mut self, triangles: &[[Vector3; 3]]) {
+        assert!(
+            triangles.len() >= self.triangles.len(),
+            "refit with less triangles than built"
+        );
+        if self.triangles.is_empty() {
+            return;
+        }
+        for (t, i) in self.triangles.iter_mut().zip(self.indices.iter()) {
+            *t = triangles[*i as usize];
+        }
+
+        // Children are always stored after their parent
+        for n in (0..self.nodes.len()).rev() {
+            let node = self.nodes[n];
+            let mut b = Aabb::EMPTY;
+            if node.count == 0 {
+                for child in &self.nodes[node.start as usize..node.start as usize + 2] {
+                    b.union(&Aabb {
+                        min: child.min,
+                        max: child.max,
+                    });
+                }
+            } else {
+                let range = node.start as usize..(node.start + node.count) as usize;
+                for t in &self.triangles[range] {
+                    t.iter().for_each(|v| b.grow(*v));
+                }
+            }
+            self.nodes[n].min = b.min;
+            self.nodes[n].max = b.max;
+        }
+    }
+
+    /// Visits triangles hit by `ray`, nearest nodes first. `hit(triangle, distance)` returns the
+    /// distance beyond which nodes are skipped.
+    #[inline]
+    fn traverse_ray(&self, ray: Ray, mut hit: impl FnMut(usize, f32) -> f32) {
+        if self.triangles.is_empty() {
+            return;
+        }
+
+        let origin = ray.position;
+        let dir = ray.direction;
+        // Zero components would give NaN slab distances (0 * inf) for origins on a box plane
+        let inv = |d: f32| {
+            1.0 / if d.abs() < 1e-20 {
+                1e-20f32.copysign(d)
+            } else {
+                d
+            }
+        };
+        let inv_dir = Vector3::new(inv(dir.x), inv(dir.y), inv(dir.z));
+        let mut limit = f32::INFINITY;
+
+        let mut stack = Vec::with_capacity(64);
+        if self.nodes[0].ray_entry(origin, inv_dir) < limit {
+            stack.push(0);
+        }
+        while let Some(n) = stack.pop() {
+            let node = &self.nodes[n];
+            if node.ray_entry(origin, inv_dir) >= limit {
+                continue;
+            }
+
+            if node.count == 0 {
+                let (l, r) = (node.start as usize, node.start as usize + 1);
+                let tl = self.nodes[l].ray_entry(origin, inv_dir);
+                let tr = self.nodes[r].ray_entry(origin, inv_dir);
+                let ((near, tn), (far, tf)) = if tl <= tr {
+                    ((l, tl), (r, tr))
+                } else {
+                    ((r, tr), (l, tl))
+                };
+                if tf < limit {
+                    stack.push(far);
+                }
+                if tn < limit {
+                    stack.push(near);
+                }
+                continue;
+            }
+
+            let range = node.start as usize..(node.start + node.count) as usize;
+            for i in range {
+                if let Some(t) = ray_triangle(origin, dir, &self.triangles[i]) {
+                    limit = hit(i, t);
+                    if limit == f32::NEG_INFINITY {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+#[inline]
+fn axis_of(v: Vector3, axis: usize) -> f32 {
+    match axis {
+        0 => v.x,
+        1 => v.y,
+        _ => v.z,
+    }
+}
+
+#[inline]
+fn bin_params(centroid_bounds: &Aabb, axis: usize) -> (f32, f32) {
+    let min = axis_of(centroid_bounds.min, axis);
+    let extent = axis_of(centroid_bounds.max, axis) - min;
+    (min, SAH_BINS as f32 / extent)
+}
+
+#[inline]
+fn bin_index(c: f32, min: f32, scale: f32) -> usize {
+    (((c - min) * scale) as usize).min(SAH_BINS - 1)
+}
+
+/// Returns the axis and bin of the cheapest split, `None` if keeping a leaf is cheaper.
+fn find_split(
+    indices: &[u32],
+    bounds: &[Aabb],
+    centroids: &[Vector3],
+    centroid_bounds: &Aabb,
+    half_area: f32,
+) -> Option<(usize, usize)> {
+    let mut best: Option<(usize, usize)> = None;
+    let mut best_cost = indices.len() as f32 * half_area;
+
+    for axis in 0..3 {
+        if axis_of(centroid_bounds.max, axis) <= axis_of(centroid_bounds.min, axis) {
+            continue;
+        }
+        let (cmin, scale) = bin_params(centroid_bounds, axis);
+
+        let mut bins = [(Aabb::EMPTY, 0usize); SAH_BINS];
+        for i in indices {
+            let b = &mut bins[bin_index(axis_of(centroids[*i as usize], axis), cmin, scale)];
+            b.0.union(&bounds[*i as usize]);
+            b.1 += 1;
+        }
+
+        // Right side costs, swept from the last bin
+        let mut right_cost = [0.0; SAH_BINS];
+        let mut right = (Aabb::EMPTY, 0);
+        for i in (1..SAH_BINS).rev() {
+            right.0.union(&bins[i].0);
+            right.1 += bins[i].1;
+            right_cost[i] = right.1 as f32 * right.0.half_area();
+        }
+
+        let mut left = (Aabb::EMPTY, 0);
+        for i in 1..SAH_BINS {
+            left.0.union(&bins[i - 1].0);
+            left.1 += bins[i - 1].1;
+            let cost = left.1 as f32 * left.0.half_area() + right_cost[i];
+            if cost < best_cost {
+                best_cost = cost;
+                best = Some((axis, i));
+            }
+        }
+    }
+    best
+}
+
+/// Möller–Trumbore ray triangle intersection, two sided like `GetCollisionRayTriangle`.
+#[inline]
+fn ray_triangle(origin: Vector3, dir: Vector3, t: &[Vector3; 3]) -> Option<f32> {
+    let e1 = t[1] - t[0];
+    let e2 = t[2] - t[0];
+    let p = dir.cross(e2);
+    let det = e1.dot(p);
+    if det > -EPSILON && det < EPSILON {
+        return None;
+    }
+
+    let inv_det = 1.0 / det;
+    let s = origin - t[0];
+    let u = s.dot(p) * inv_det;
+    if u < 0.0 || u > 1.0 {
+        return None;
+    }
+    let q = s.cross(e1);
+    let v = dir.dot(q) * inv_det;
+    if v < 0.0 || u + v > 1.0 {
+        return None;
+    }
+
+    let distance = e2.dot(q) * inv_det;
+    if distance > EPSILON {
+        Some(distance)
+    } else {
+        None
+    }
+}
+
+/// Closest point to `p` on triangle `abc` (Real-Time Collision Detection, 5.1.5).
+fn closest_point_triangle(p: Vector3, a: Vector3, b: Vector3, c: Vector3) -> Vector3 {
+    let ab = b - a;
+    let ac = c - a;
+    let ap = p - a;
+    let d1 = ab.dot(ap);
+    let d2 = ac.dot(ap);
+    if d1 <= 0.0 && d2 <= 0.0 {
+        return a;
+    }
+
+    let bp = p - b;
+    let d3 = ab.dot(bp);
+    let d4 = ac.dot(bp);
+    if d3 >= 0.0 && d4 <= d3 {
+        return b;
+    }
+
+    let vc = d1 * d4 - d3 * d2;
+    if vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    let cp = p - c;
+    let d5 = ab.dot(cp);
+    let d6 = ac.dot(cp);
+    if d6 >= 0.0 && d5 <= d6 {
+        return c;
+    }
+
+    let vb = d5 * d2 - d1 * d6;
+    if vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    let va = d3 * d6 - d5 * d4;
+    if va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0 {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    let denom = 1.0 / (va + vb + vc);
+    a + ab * (vb * denom) + ac * (vc * denom)
+}
+
+/// Appends `mesh` triangles to `out`, transformed by `transform` if set.
+pub(crate) fn mesh_triangles(
+    mesh: &ffi::Mesh,
+    transform: Option<&Matrix>,
+    out: &mut Vec<[Vector3; 3]>,
+) {
+    let vertices = if mesh.animVertices.is_null() {
+        mesh.vertices
+    } else {
+        mesh.animVertices
+    };
+    if vertices.is_null() {
+        return;
+    }
+
+    let vertices = unsafe {
+        std::slice::from_raw_parts(vertices as *const Vector3, mesh.vertexCount as usize)
+    };
+    let vertex = |i: usize| match transform {
+        Some(mat) => vertices[i].transform_with(*mat),
+        None => vertices[i],
+    };
+
+    let triangles = mesh.triangleCount as usize;
+    if mesh.indices.is_null() {
+        out.extend((0..triangles).map(|t| [vertex(3 * t), vertex(3 * t + 1), vertex(3 * t + 2)]));
+    } else {
+        let indices = unsafe { std::slice::from_raw_parts(mesh.indices, 3 * triangles) };
+        out.extend(indices.chunks_exact(3).map(|t| {
+            [
+                vertex(t[0] as usize),
+                vertex(t[1] as usize),
+                vertex(t[2] as usize),
+            ]
+        }));
+    }
+}
+
+/// Triangles of every mesh of `model`, with the model transform applied.
+pub(crate) fn model_triangles(model: &ffi::Model) -> Vec<[Vector3; 3]> {
+    if model.meshes.is_null() || model.meshCount <= 0 {
+        return Vec::new();
+    }
+    let transform = Matrix::from(model.transform);
+    let meshes = unsafe { std::slice::from_raw_parts(model.meshes, model.meshCount as usize) };
+
+    let mut triangles = Vec::new();
+    for mesh in meshes {
+        mesh_triangles(mesh, Some(&transform), &mut triangles);
+    }
+    triangles
+}
+
+#[cfg(test)]
+mod bvh_test {
+    use super::*;
+
+    /// Bumpy grid of `side * side * 2` triangles.
+    fn test_triangles(side: usize) -> Vec<[Vector3; 3]> {
+        let vertex = |x: usize, z: usize| {
+            let (x, z) = (x as f32, z as f32);
+            Vector3::new(x, (x * 0.7).sin() + (z * 0.3).cos(), z)
+        };
+        let mut triangles = Vec::new();
+        for z in 0..side {
+            for x in 0..side {
+                triangles.push([vertex(x, z), vertex(x, z + 1), vertex(x + 1, z)]);
+                triangles.push([vertex(x + 1, z), vertex(x, z + 1), vertex(x + 1, z + 1)]);
+            }
+        }
+        triangles
+    }
+
+    fn test_rays(side: usize) -> Vec<Ray> {
+        (0..200)
+            .map(|i| {
+                let f = i as f32;
+                Ray {
+                    position: Vector3::new((f * 7.3) % side as f32, 10.0, (f * 3.1) % side as f32),
+                    direction: Vector3::new((f * 0.37).sin() * 0.5, -1.0, (f * 0.11).cos() * 0.5),
+                }
+            })
+            .collect()
+    }
+
+    fn brute_force(triangles: &[[Vector3; 3]], ray: Ray) -> Option<(usize, f32)> {
+        let mut best: Option<(usize, f32)> = None;
+        for (i, t) in triangles.iter().enumerate() {
+            if let Some(d) = ray_triangle(ray.position, ray.direction, t) {
+                if best.map_or(true, |(_, b)| d < b) {
+                    best = Some((i, d));
+                }
+            }
+        }
+        best
+    }
+
+    #[test]
+    fn test_bvh_raycast() {
+        let triangles = test_triangles(40);
+        let bvh = MeshBvh::from_triangles(&triangles);
+        assert!(bvh.node_count() > 1);
+
+        for ray in test_rays(40) {
+            let expected = brute_force(&triangles, ray);
+            let hit = bvh.raycast_triangle(ray);
+            assert_eq!(hit.map(|(_, h)| h.distance), expected.map(|(_, d)| d));
+            assert_eq!(bvh.raycast(ray).hit, expected.is_some());
+            assert_eq!(bvh.raycast_any(ray, f32::INFINITY), expected.is_some());
+            if let Some((_, d)) = expected {
+                assert!(!bvh.raycast_any(ray, d * 0.5));
+            }
+        }
+
+        let up = Ray {
+            position: Vector3::new(5.0, 10.0, 5.0),
+            direction: Vector3::up(),
+        };
+        assert!(!bvh.raycast(up).hit);
+        assert!(!MeshBvh::from_triangles(&[]).raycast(up).hit);
+    }
+
+    #[test]
+    fn test_bvh_sphere_overlap() {
+        let triangles = test_triangles(30);
+        let bvh = MeshBvh::from_triangles(&triangles);
+
+        let mut found = Vec::new();
+        for (center, radius) in [
+            (Vector3::new(10.0, 1.0, 10.0), 2.0),
+            (Vector3::new(3.0, 1.5, 25.0), 0.5),
+        ]
+        .iter()
+        {
+            bvh.sphere_overlap(*center, *radius, &mut found);
+            found.sort_unstable();
+            let expected: Vec<usize> = (0..triangles.len())
+                .filter(|i| {
+                    let [a, b, c] = triangles[*i];
+                    let d = closest_point_triangle(*center, a, b, c) - *center;
+                    d.dot(d) <= radius * radius
+                })
+                .collect();
+            assert!(!expected.is_empty());
+            assert_eq!(found, expected);
+        }
+    }
+
+    #[test]
+    fn test_bvh_refit() {
+        let triangles = test_triangles(30);
+        let mut bvh = MeshBvh::from_triangles(&triangles);
+
+        let moved: Vec<[Vector3; 3]> = triangles
+            .iter()
+            .map(|t| {
+                let mut t = *t;
+                t.iter_mut()
+                    .for_each(|v| v.y += (v.x * 0.2).sin() * 3.0 - 5.0);
+                t
+            })
+            .collect();
+        bvh.refit(&moved);
+
+        for ray in test_rays(30) {
+            let expected = brute_force(&moved, ray);
+            let hit = bvh.raycast_triangle(ray);
+            assert_eq!(hit.map(|(i, h)| (i, h.distance)), expected);
+        }
+    }
+
+    #[test]
+    fn test_bvh_empty() {
+        let model: ffi::Model = unsafe { std::mem::zeroed() };
+        assert!(model_triangles(&model).is_empty());
+        let mut bvh = MeshBvh::from_triangles(&[]);
+        assert_eq!(bvh.triangle_count(), 0);
+        bvh.refit(&[]);
+        assert!(bvh.raycast_triangle(test_rays(1)[0]).is_none());
+    }
+}
@@ -1,14 +1,15 @@
 //! Contains code related to drawing. Types that can be set as a surface to draw will implement the [`RaylibDraw`] trait
 use crate::core::camera::Camera3D;
+use crate::core::frustum::Frustum;
 use crate::core::math::Ray;
-use crate::core::math::{Vector2, Vector3};
+use crate::core::math::{BoundingBox, Matrix, Vector2, Vector3};
 
+use crate::core::text;
 use crate::core::texture::Texture2D;
 use crate::core::vr::VrStereoConfig;
 use crate::core::{RaylibHandle, RaylibThread};
 use crate::ffi;
 use std::convert::AsRef;
-use std::ffi::CString;
 
 /// Seems like all draw commands must be issued from the main thread
 impl RaylibHandle {
@@ -16,7 +17,16 @@ impl RaylibHandle {
     #[must_use]
     pub fn begin_drawing(&mut self, _: &RaylibThread) -> RaylibDrawHandle {
         unsafe {
+            // Render statistics of the frame that ended become the previous ones
+            ffi::rlResetRenderStats();
+            #[cfg(not(feature = "null_backend"))]
             ffi::BeginDrawing();
+            // No window to draw to, only the frame commands are kept
+            #[cfg(feature = "null_backend")]
+            {
+                ffi::rlNullClearCommands();
+                ffi::rlLoadIdentity();
+            }
         };
         let d = RaylibDrawHandle(self);
         d
@@ -27,9 +37,14 @@ pub struct RaylibDrawHandle<'a>(&'a mut RaylibHandle);
 
 impl<'a> Drop for RaylibDrawHandle<'a> {
     fn drop(&mut self) {
+        #[cfg(not(feature = "null_backend"))]
         unsafe {
             ffi::EndDrawing();
         }
+        #[cfg(feature = "null_backend")]
+        unsafe {
+            ffi::rlDrawRenderBatchActive();
+        }
     }
 }
 
@@ -953,6 +968,49 @@ pub trait RaylibDraw {
         }
     }
 
+    /// Draw many sprites from `texture` at once, each one as `draw_texture_pro` would.
+    /// Quads are written in chunks straight into the render batch, with a single capacity check
+    /// and texture switch per chunk instead of one `rlBegin`/`rlVertex` chain per sprite.
+    #[inline]
+    fn draw_sprite_batch(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        sprites: &[crate::core::batch::SpriteInstance],
+    ) {
+        crate::core::batch::draw_sprite_batch(texture.as_ref(), sprites);
+    }
+
+    /// Draws many textured quads with a single instanced draw call, same result as `draw_sprite_batch`.
+    /// Only the sprite parameters are uploaded, quads are built on the GPU, which draws the render batch first.
+    /// Falls back to `draw_sprite_batch` when instancing is not supported or a custom shader is active.
+    #[inline]
+    fn draw_sprites_instanced(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        sprites: &[crate::core::batch::SpriteInstance],
+    ) {
+        crate::core::batch::draw_sprites_instanced(texture.as_ref(), sprites);
+    }
+
+    /// Draws the commands recorded by `encoders` into the active render batch.
+    /// Encoders are drawn in slice order, each one in recording order, whatever thread filled them:
+    /// the result is the same as recording everything into a single encoder.
+    #[inline]
+    fn draw_command_encoders(&mut self, encoders: &[crate::core::encoder::CommandEncoder]) {
+        for encoder in encoders {
+            encoder.submit();
+        }
+    }
+
+    /// Draws a recorded command list with `transform` applied on top of the current modelview matrix.
+    /// Vertex data already lives on the GPU, nothing is uploaded: one draw call per recorded texture switch.
+    #[inline]
+    fn draw_command_list(&mut self, list: &crate::core::batch::CommandList, transform: Matrix) {
+        unsafe {
+            ffi::rlDrawCommandList(list.0, transform.into());
+        }
+    }
+
     /// Draw part of a texture (defined by a rectangle) with rotation and scale tiled into dest.
     #[inline]
     fn draw_texture_tiled(
@@ -1032,7 +1090,39 @@ pub trait RaylibDraw {
         }
     }
 
+    /// Shows render statistics of the previous frame (flushes, draw calls, vertices, uploads, state calls).
+    /// Lines are formatted into a reused buffer, nothing is allocated per frame.
+    fn draw_render_stats(&mut self, x: i32, y: i32) {
+        let stats = unsafe { ffi::rlGetRenderStatsPrevious() };
+        let uploaded_kb = stats.bytesUploaded / 1024;
+        let lines = [
+            format_args!(
+                "FLUSHES: {} ({} OVERFLOW)",
+                stats.flushes, stats.overflowFlushes
+            ),
+            format_args!("DRAW CALLS: {}", stats.drawCalls),
+            format_args!("VERTICES: {}", stats.vertices),
+            format_args!("UPLOADED: {} KB", uploaded_kb),
+            format_args!(
+                "STATE CALLS: {} ({} ELIDED)",
+                stats.stateCallsIssued, stats.stateCallsElided
+            ),
+        ];
+        for (i, line) in lines.iter().enumerate() {
+            text::with_text_format(*line, |line| {
+                self.draw_text(
+                    line,
+                    x,
+                    y + i as i32 * 12,
+                    10,
+                    crate::core::color::Color::LIME,
+                )
+            });
+        }
+    }
+
     /// Draws text (using default font).
+    /// Glyphs are written straight into the render batch, `text` is not copied.
     #[inline]
     fn draw_text(
         &mut self,
@@ -1042,13 +1132,20 @@ pub trait RaylibDraw {
         font_size: i32,
         color: impl Into<ffi::Color>,
     ) {
-        let c_text = CString::new(text).unwrap();
-        unsafe {
-            ffi::DrawText(c_text.as_ptr(), x, y, font_size, color.into());
-        }
+        let font = unsafe { ffi::GetFontDefault() };
+        let (font_size, spacing) = text::default_font_size(font_size);
+        text::draw_text_font(
+            &font,
+            text,
+            Vector2::new(x as f32, y as f32).into(),
+            font_size,
+            spacing,
+            color.into(),
+        );
     }
 
     /// Draws text using `font` and additional parameters.
+    /// Glyphs are written straight into the render batch, `text` is not copied.
     #[inline]
     fn draw_text_ex(
         &mut self,
@@ -1059,17 +1156,14 @@ pub trait RaylibDraw {
         spacing: f32,
         tint: impl Into<ffi::Color>,
     ) {
-        let c_text = CString::new(text).unwrap();
-        unsafe {
-            ffi::DrawTextEx(
-                *font.as_ref(),
-                c_text.as_ptr(),
-                position.into(),
-                font_size,
-                spacing,
-                tint.into(),
-            );
-        }
+        text::draw_text_font(
+            font.as_ref(),
+            text,
+            position.into(),
+            font_size,
+            spacing,
+            tint.into(),
+        );
     }
 
     /// Draws text using `font` and additional parameters.
@@ -1084,18 +1178,17 @@ pub trait RaylibDraw {
         word_wrap: bool,
         tint: impl Into<ffi::Color>,
     ) {
-        let c_text = CString::new(text).unwrap();
-        unsafe {
+        text::with_c_text(text, |c_text| unsafe {
             ffi::DrawTextRec(
                 *font.as_ref(),
-                c_text.as_ptr(),
+                c_text,
                 rec.into(),
                 font_size,
                 spacing,
                 word_wrap,
                 tint.into(),
             );
-        }
+        });
     }
 
     /// Draws text using `font` and additional parameters.
@@ -1114,11 +1207,10 @@ pub trait RaylibDraw {
         select_text: impl Into<ffi::Color>,
         select_back: impl Into<ffi::Color>,
     ) {
-        let c_text = CString::new(text).unwrap();
-        unsafe {
+        text::with_c_text(text, |c_text| unsafe {
             ffi::DrawTextRecEx(
                 *font.as_ref(),
-                c_text.as_ptr(),
+                c_text,
                 rec.into(),
                 font_size,
                 spacing,
@@ -1129,7 +1221,7 @@ pub trait RaylibDraw {
                 select_text.into(),
                 select_back.into(),
             );
-        }
+        });
     }
 
     /// Draw one character (codepoint)
@@ -1445,6 +1537,93 @@ pub trait RaylibDraw3D {
         }
     }
 
+    /// Draws a model only if it is at least partly inside `frustum`, see [`Frustum::from_camera`].
+    /// `bounds` are the model bounds before its transform, e.g. from `mesh_bounding_box`.
+    /// Returns whether the model was drawn.
+    #[inline]
+    fn draw_model_culled(
+        &mut self,
+        frustum: &Frustum,
+        model: impl AsRef<ffi::Model>,
+        bounds: &BoundingBox,
+        position: impl Into<ffi::Vector3>,
+        scale: f32,
+        tint: impl Into<ffi::Color>,
+    ) -> bool {
+        self.draw_model_ex_culled(
+            frustum,
+            model,
+            bounds,
+            position,
+            Vector3::up(),
+            0.0,
+            Vector3::new(scale, scale, scale),
+            tint,
+        )
+    }
+
+    /// Draws a model with extended parameters only if it is at least partly inside `frustum`.
+    /// `bounds` are the model bounds before its transform, e.g. from `mesh_bounding_box`.
+    /// Returns whether the model was drawn.
+    #[inline]
+    fn draw_model_ex_culled(
+        &mut self,
+        frustum: &Frustum,
+        model: impl AsRef<ffi::Model>,
+        bounds: &BoundingBox,
+        position: impl Into<ffi::Vector3>,
+        rotation_axis: impl Into<ffi::Vector3>,
+        rotation_angle: f32,
+        scale: impl Into<ffi::Vector3>,
+        tint: impl Into<ffi::Color>,
+    ) -> bool {
+        let model = *model.as_ref();
+        let position: Vector3 = position.into().into();
+        let rotation_axis: Vector3 = rotation_axis.into().into();
+        let scale: Vector3 = scale.into().into();
+
+        // Same transform as DrawModelEx
+        let transform = Matrix::from(model.transform)
+            * Matrix::scale(scale.x, scale.y, scale.z)
+            * Matrix::rotate(rotation_axis, rotation_angle.to_radians())
+            * Matrix::translate(position.x, position.y, position.z);
+        if !frustum.intersects_box(&bounds.transformed(&transform)) {
+            return false;
+        }
+
+        unsafe {
+            ffi::DrawModelEx(
+                model,
+                position.into(),
+                rotation_axis.into(),
+                rotation_angle,
+                scale.into(),
+                tint.into(),
+            );
+        }
+        true
+    }
+
+    /// Draws a mesh once per transform with a single instanced draw call.
+    /// The material shader needs its `SHADER_LOC_MATRIX_MODEL` location set to the instance transform attribute.
+    /// Transforms are uploaded into a buffer reused across calls and frames.
+    #[inline]
+    fn draw_mesh_instanced(
+        &mut self,
+        mesh: impl AsRef<ffi::Mesh>,
+        material: impl AsRef<ffi::Material>,
+        transforms: &[Matrix],
+    ) {
+        unsafe {
+            ffi::rlDrawMeshInstanced(
+                *mesh.as_ref(),
+                *material.as_ref(),
+                transforms.as_ptr() as *const ffi::Matrix,
+                transforms.len() as i32,
+            );
+        }
+    }
+
     /// Draws a model with wires (with texture if set).
     #[inline]
     fn draw_model_wires(
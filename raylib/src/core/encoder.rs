@@ -0,0 +1,515 @@
+//! Command encoders: draws recorded on any thread, submitted on the main thread
+use crate::core::batch::{draw_sprite_batch, SpriteInstance};
+use crate::core::color::Color;
+use crate::core::math::{Rectangle, Vector2};
+use crate::core::text;
+use crate::ffi;
+
+/// Triangles written per `rlVertexBatch` call on submission.
+const TRIANGLE_CHUNK: usize = 256;
+
+/// Circles segments, same as `draw_circle`.
+const CIRCLE_SEGMENTS: usize = 36;
+
+#[derive(Debug, Copy, Clone)]
+enum Command {
+    /// `count` quads from `sprites`, drawn with `texture` (shapes texture if `None`).
+    Sprites {
+        texture: Option<ffi::Texture2D>,
+        start: usize,
+        count: usize,
+    },
+    /// `count` vertices from `vertices`, drawn as triangles with the shapes texture.
+    Triangles { start: usize, count: usize },
+    /// `len` bytes from `text`, drawn with the default font.
+    Text {
+        start: usize,
+        len: usize,
+        position: Vector2,
+        font_size: i32,
+        color: Color,
+    },
+}
+
+/// Records draws without touching the GPU, so it can be filled from worker threads.
+///
+/// Each encoder owns its arenas (sprites, vertices, text): create one per worker, `clear` it
+/// every frame to reuse its memory, and submit all of them on the main thread with
+/// [`RaylibDraw::draw_command_encoders`](crate::core::drawing::RaylibDraw::draw_command_encoders).
+/// Consecutive draws sharing a texture are merged into a single sprite batch run.
+#[derive(Debug, Default, Clone)]
+pub struct CommandEncoder {
+    commands: Vec<Command>,
+    sprites: Vec<SpriteInstance>,
+    vertices: Vec<ffi::BatchVertex>,
+    text: String,
+}
+
+impl CommandEncoder {
+    pub fn new() -> CommandEncoder {
+        CommandEncoder::default()
+    }
+
+    /// Forgets every recorded draw, memory is kept for the next frame.
+    pub fn clear(&mut self) {
+        self.commands.clear();
+        self.sprites.clear();
+        self.vertices.clear();
+        self.text.clear();
+    }
+
+    /// Returns true if nothing has been recorded since the last `clear`.
+    pub fn is_empty(&self) -> bool {
+        self.commands.is_empty()
+    }
+
+    /// Number of commands recorded, runs of sprites sharing a texture count as one.
+    pub fn commands_count(&self) -> usize {
+        self.commands.len()
+    }
+
+    fn push_sprites(&mut self, texture: Option<ffi::Texture2D>, sprites: &[SpriteInstance]) {
+        let id = texture.map_or(0, |t| t.id);
+        if let Some(Command::Sprites {
+            texture: last,
+            count,
+            ..
+        }) = self.commands.last_mut()
+        {
+            if last.map_or(0, |t| t.id) == id {
+                *count += sprites.len();
+                self.sprites.extend_from_slice(sprites);
+                return;
+            }
+        }
+
+        self.commands.push(Command::Sprites {
+            texture,
+            start: self.sprites.len(),
+            count: sprites.len(),
+        });
+        self.sprites.extend_from_slice(sprites);
+    }
+
+    fn push_triangle(&mut self, v1: Vector2, v2: Vector2, v3: Vector2, color: Color) {
+        match self.commands.last_mut() {
+            Some(Command::Triangles { count, .. }) => *count += 3,
+            _ => self.commands.push(Command::Triangles {
+                start: self.vertices.len(),
+                count: 3,
+            }),
+        }
+
+        for v in [v1, v2, v3].iter() {
+            self.vertices.push(ffi::BatchVertex {
+                x: v.x,
+                y: v.y,
+                z: 0.0,
+                u: 0.0,
+                v: 0.0,
+                r: color.r,
+                g: color.g,
+                b: color.b,
+                a: color.a,
+            });
+        }
+    }
+
+    /// Records a `Texture2D`.
+    #[inline]
+    pub fn draw_texture(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        x: i32,
+        y: i32,
+        tint: impl Into<ffi::Color>,
+    ) {
+        self.draw_texture_v(texture, Vector2::new(x as f32, y as f32), tint);
+    }
+
+    /// Records a `Texture2D` with position defined as `Vector2`.
+    #[inline]
+    pub fn draw_texture_v(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        position: impl Into<ffi::Vector2>,
+        tint: impl Into<ffi::Color>,
+    ) {
+        let t = texture.as_ref();
+        let source = Rectangle::new(0.0, 0.0, t.width as f32, t.height as f32);
+        self.draw_texture_rec(texture, source, position, tint);
+    }
+
+    /// Records a part of a texture defined by a rectangle.
+    #[inline]
+    pub fn draw_texture_rec(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        source_rec: impl Into<ffi::Rectangle>,
+        position: impl Into<ffi::Vector2>,
+        tint: impl Into<ffi::Color>,
+    ) {
+        let source: Rectangle = source_rec.into().into();
+        let position: Vector2 = position.into().into();
+        let dest = Rectangle::new(
+            position.x,
+            position.y,
+            source.width.abs(),
+            source.height.abs(),
+        );
+        self.draw_texture_pro(texture, source, dest, Vector2::default(), 0.0, tint);
+    }
+
+    /// Records a part of a texture defined by a rectangle with 'pro' parameters, see `draw_texture_pro`.
+    #[inline]
+    pub fn draw_texture_pro(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        source_rec: impl Into<ffi::Rectangle>,
+        dest_rec: impl Into<ffi::Rectangle>,
+        origin: impl Into<ffi::Vector2>,
+        rotation: f32,
+        tint: impl Into<ffi::Color>,
+    ) {
+        let sprite = SpriteInstance {
+            dest: dest_rec.into().into(),
+            source: source_rec.into().into(),
+            origin: origin.into().into(),
+            rotation,
+            tint: tint.into().into(),
+        };
+        self.push_sprites(Some(*texture.as_ref()), &[sprite]);
+    }
+
+    /// Records many sprites from `texture`, see `draw_sprite_batch`.
+    #[inline]
+    pub fn draw_sprite_batch(
+        &mut self,
+        texture: impl AsRef<ffi::Texture2D>,
+        sprites: &[SpriteInstance],
+    ) {
+        if !sprites.is_empty() {
+            self.push_sprites(Some(*texture.as_ref()), sprites);
+        }
+    }
+
+    /// Records a color-filled rectangle.
+    #[inline]
+    pub fn draw_rectangle(
+        &mut self,
+        x: i32,
+        y: i32,
+        width: i32,
+        height: i32,
+        color: impl Into<ffi::Color>,
+    ) {
+        let rec = Rectangle::new(x as f32, y as f32, width as f32, height as f32);
+        self.draw_rectangle_pro(rec, Vector2::default(), 0.0, color);
+    }
+
+    /// Records a color-filled rectangle.
+    #[inline]
+    pub fn draw_rectangle_rec(
+        &mut self,
+        rec: impl Into<ffi::Rectangle>,
+        color: impl Into<ffi::Color>,
+    ) {
+        self.draw_rectangle_pro(rec, Vector2::default(), 0.0, color);
+    }
+
+    /// Records a color-filled rectangle with 'pro' parameters.
+    #[inline]
+    pub fn draw_rectangle_pro(
+        &mut self,
+        rec: impl Into<ffi::Rectangle>,
+        origin: impl Into<ffi::Vector2>,
+        rotation: f32,
+        color: impl Into<ffi::Color>,
+    ) {
+        let sprite = SpriteInstance {
+            dest: rec.into().into(),
+            source: Rectangle::new(0.0, 0.0, 1.0, 1.0),
+            origin: origin.into().into(),
+            rotation,
+            tint: color.into().into(),
+        };
+        self.push_sprites(None, &[sprite]);
+    }
+
+    /// Records a line defining thickness.
+    #[inline]
+    pub fn draw_line_ex(
+        &mut self,
+        start_pos: impl Into<ffi::Vector2>,
+        end_pos: impl Into<ffi::Vector2>,
+        thick: f32,
+        color: impl Into<ffi::Color>,
+    ) {
+        let start: Vector2 = start_pos.into().into();
+        let end: Vector2 = end_pos.into().into();
+        let (dx, dy) = (end.x - start.x, end.y - start.y);
+        let rec = Rectangle::new(start.x, start.y, (dx * dx + dy * dy).sqrt(), thick);
+        let rotation = dy.atan2(dx).to_degrees();
+        self.draw_rectangle_pro(rec, Vector2::new(0.0, thick / 2.0), rotation, color);
+    }
+
+    /// Records a color-filled triangle (vertex in counter-clockwise order!).
+    #[inline]
+    pub fn draw_triangle(
+        &mut self,
+        v1: impl Into<ffi::Vector2>,
+        v2: impl Into<ffi::Vector2>,
+        v3: impl Into<ffi::Vector2>,
+        color: impl Into<ffi::Color>,
+    ) {
+        let color: Color = color.into().into();
+        self.push_triangle(v1.into().into(), v2.into().into(), v3.into().into(), color);
+    }
+
+    /// Records a color-filled circle.
+    #[inline]
+    pub fn draw_circle(
+        &mut self,
+        center_x: i32,
+        center_y: i32,
+        radius: f32,
+        color: impl Into<ffi::Color>,
+    ) {
+        self.draw_circle_v(
+            Vector2::new(center_x as f32, center_y as f32),
+            radius,
+            color,
+        );
+    }
+
+    /// Records a color-filled circle (Vector version).
+    #[inline]
+    pub fn draw_circle_v(
+        &mut self,
+        center: impl Into<ffi::Vector2>,
+        radius: f32,
+        color: impl Into<ffi::Color>,
+    ) {
+        let center: Vector2 = center.into().into();
+        let color: Color = color.into().into();
+        let step = 360.0 / CIRCLE_SEGMENTS as f32;
+        let point = |angle: f32| {
+            let (sin, cos) = angle.to_radians().sin_cos();
+            Vector2::new(center.x + sin * radius, center.y + cos * radius)
+        };
+
+        for i in 0..CIRCLE_SEGMENTS {
+            let angle = i as f32 * step;
+            self.push_triangle(center, point(angle), point(angle + step), color);
+        }
+    }
+
+    /// Records text (using default font).
+    #[inline]
+    pub fn draw_text(
+        &mut self,
+        text: &str,
+        x: i32,
+        y: i32,
+        font_size: i32,
+        color: impl Into<ffi::Color>,
+    ) {
+        self.commands.push(Command::Text {
+            start: self.text.len(),
+            len: text.len(),
+            position: Vector2::new(x as f32, y as f32),
+            font_size,
+            color: color.into().into(),
+        });
+        self.text.push_str(text);
+    }
+
+    /// Draws the recorded commands into the active render batch, in recording order.
+    pub(crate) fn submit(&self) {
+        for command in self.commands.iter() {
+            match *command {
+                Command::Sprites {
+                    texture,
+                    start,
+                    count,
+                } => {
+                    let texture = texture.unwrap_or_else(|| unsafe { ffi::rlGetTextureDefault() });
+                    draw_sprite_batch(&texture, &self.sprites[start..start + count]);
+                }
+                Command::Triangles { start, count } => {
+                    draw_triangles(&self.vertices[start..start + count]);
+                }
+                Command::Text {
+                    start,
+                    len,
+                    position,
+                    font_size,
+                    color,
+                } => {
+                    let font = unsafe { ffi::GetFontDefault() };
+                    let (font_size, spacing) = text::default_font_size(font_size);
+                    text::draw_text_font(
+                        &font,
+                        &self.text[start..start + len],
+                        position.into(),
+                        font_size,
+                        spacing,
+                        color.into(),
+                    );
+                }
+            }
+        }
+    }
+}
+
+/// Writes `vertices` into the active render batch as triangles, using the shapes texture.
+fn draw_triangles(vertices: &[ffi::BatchVertex]) {
+    let mut chunk_vertices = [ffi::BatchVertex::default(); TRIANGLE_CHUNK * 3];
+
+    unsafe {
+        // Keep some room for the vertex alignment rlBegin() may add
+        let elements = ((ffi::rlGetRenderBatchElements() - 2).max(1) * 4 / 3) as usize;
+
+        for chunk in vertices.chunks(elements.min(TRIANGLE_CHUNK) * 3) {
+            ffi::rlCheckRenderBatchLimit(chunk.len() as i32 + 4);
+            ffi::rlBegin(ffi::RL_TRIANGLES as i32);
+
+            let z = ffi::rlGetRenderBatchDepth();
+            for (v, dest) in chunk.iter().zip(chunk_vertices.iter_mut()) {
+                *dest = ffi::BatchVertex { z, ..*v };
+            }
+            ffi::rlVertexBatch(chunk_vertices.as_ptr(), chunk.len() as i32);
+
+            ffi::rlEnd();
+        }
+    }
+}
+
+#[cfg(test)]
+mod encoder_test {
+    use super::*;
+
+    use crate::core::texture::WeakTexture2D;
+
+    fn texture(id: u32) -> WeakTexture2D {
+        WeakTexture2D(ffi::Texture2D {
+            id,
+            width: 16,
+            height: 16,
+            mipmaps: 1,
+            format: 7,
+        })
+    }
+
+    #[test]
+    fn test_encoder_send() {
+        fn assert_send<T: Send>() {}
+        assert_send::<CommandEncoder>();
+    }
+
+    #[test]
+    fn test_encoder_merges_runs() {
+        let mut e = CommandEncoder::new();
+        for i in 0..10 {
+            e.draw_texture(texture(3), i, 0, Color::WHITE);
+        }
+        e.draw_rectangle(0, 0, 10, 10, Color::RED);
+        e.draw_line_ex(
+            Vector2::new(0.0, 0.0),
+            Vector2::new(10.0, 0.0),
+            2.0,
+            Color::RED,
+        );
+        e.draw_circle(5, 5, 3.0, Color::BLUE);
+        e.draw_triangle(
+            Vector2::new(0.0, 0.0),
+            Vector2::new(0.0, 1.0),
+            Vector2::new(1.0, 1.0),
+            Color::BLUE,
+        );
+        e.draw_text("hello", 0, 0, 10, Color::BLACK);
+        e.draw_texture(texture(4), 0, 0, Color::WHITE);
+
+        // Texture run, shapes run, triangles run, text, texture
+        assert_eq!(e.commands_count(), 5);
+        assert_eq!(e.sprites.len(), 13);
+        assert_eq!(e.vertices.len(), CIRCLE_SEGMENTS * 3 + 3);
+        assert_eq!(e.text, "hello");
+
+        e.clear();
+        assert!(e.is_empty());
+    }
+
+    #[cfg(feature = "null_backend")]
+    #[test]
+    fn test_encoder_deterministic_order() {
+        use crate::core::drawing::RaylibDraw;
+        use std::sync::mpsc;
+
+        let record = |e: &mut CommandEncoder, worker: i32| {
+            for i in 0..100 {
+                let x = worker * 100 + i;
+                e.draw_texture(texture(1 + (x / 10 % 2) as u32), x, 0, Color::WHITE);
+            }
+        };
+        let mut serial = CommandEncoder::new();
+        (0..4).for_each(|w| record(&mut serial, w));
+
+        // Workers complete in a shuffled order, each encoder goes back to its worker slot
+        let order = [2, 0, 3, 1];
+        let (done_sender, done) = mpsc::channel();
+        let (starts, workers): (Vec<_>, Vec<_>) = (0..4)
+            .map(|w| {
+                let (start, started) = mpsc::channel::<()>();
+                let done = done_sender.clone();
+                let worker = std::thread::spawn(move || {
+                    let mut e = CommandEncoder::new();
+                    record(&mut e, w);
+                    started.recv().unwrap();
+                    done.send((w, e)).unwrap();
+                });
+                (start, worker)
+            })
+            .unzip();
+        let mut slots: Vec<Option<CommandEncoder>> = (0..4).map(|_| None).collect();
+        let mut completed = Vec::new();
+        for &w in order.iter() {
+            starts[w].send(()).unwrap();
+            let (w, e) = done.recv().unwrap();
+            completed.push(w as usize);
+            slots[w as usize] = Some(e);
+        }
+        workers.into_iter().for_each(|w| w.join().unwrap());
+        assert_eq!(completed, order);
+        let encoders: Vec<CommandEncoder> = slots.into_iter().map(Option::unwrap).collect();
+
+        // Positions and draw calls left in a render batch by draw_command_encoders
+        let _window = crate::core::test_window_lock();
+        let (mut rl, thread) = crate::init().size(640, 480).build();
+        let mut batch = unsafe { ffi::rlLoadRenderBatch(1, 4096) };
+        let mut submit = |encoders: &[CommandEncoder]| {
+            let mut d = rl.begin_drawing(&thread);
+            unsafe { ffi::rlSetRenderBatchActive(&mut batch) };
+            d.draw_command_encoders(encoders);
+            unsafe {
+                let buffer = &*batch.vertexBuffer;
+                let count = buffer.vCounter as usize * 3;
+                let vertices = std::slice::from_raw_parts(buffer.vertices, count).to_vec();
+                let draws: Vec<_> =
+                    std::slice::from_raw_parts(batch.draws, batch.drawsCounter as usize)
+                        .iter()
+                        .map(|c| (c.mode, c.vertexCount, c.textureId))
+                        .collect();
+                ffi::rlSetRenderBatchActive(std::ptr::null_mut());
+                (vertices, draws)
+            }
+        };
+        let (vertices, draws) = submit(&encoders);
+        let expected = submit(std::slice::from_ref(&serial));
+        unsafe { ffi::rlUnloadRenderBatch(batch) };
+
+        assert_eq!(vertices.len(), 400 * 4 * 3);
+        assert_eq!(draws.len(), 40);
+        assert_eq!((vertices, draws), expected);
+    }
+}
@@ -3,6 +3,23 @@ use crate::ffi;
 
 use crate::core::RaylibHandle;
 use std::ffi::CStr;
+use std::sync::{Mutex, MutexGuard};
+
+lazy_static::lazy_static! {
+    static ref STATIC_BUFFERS: Mutex<()> = Mutex::new(());
+}
+
+/// Locks raylib's static text buffers for the duration of a file call.
+///
+/// raylib functions taking a file name or type (`LoadImage`, `ExportImage`, `LoadWave`,
+/// `LoadImageFromMemory`...) pick the format through `IsFileExtension`, `GetFileExtension`,
+/// `TextToLower` or `TextSplit`, which all return the same static buffers, so two such calls
+/// must never run at once. Every wrapper of these functions holds this lock, whichever thread
+/// it runs on, e.g. `AssetLoader` and `FrameRecorder` workers.
+pub(crate) fn lock_static_buffers() -> MutexGuard<'static, ()> {
+    // Nothing is guarded but the C buffers, a panic while holding the lock leaves them usable
+    STATIC_BUFFERS.lock().unwrap_or_else(|e| e.into_inner())
+}
 
 impl RaylibHandle {
     /// Checks if a file has been dropped into the window.
@@ -0,0 +1,318 @@
+//! View frustum culling: test bounding boxes and spheres against the camera frustum
+use crate::consts::CameraProjection;
+use crate::core::camera::Camera3D;
+use crate::core::math::{BoundingBox, Matrix, Vector3, Vector4};
+
+/// Near and far planes used by `begin_mode3D` (rlgl `RL_CULL_DISTANCE_NEAR/FAR`).
+const CULL_DISTANCE_NEAR: f32 = 0.01;
+const CULL_DISTANCE_FAR: f32 = 1000.0;
+
+/// Lanes of the planes arrays: 6 planes padded with planes containing everything.
+const LANES: usize = 8;
+
+/// Camera view volume, as six planes.
+///
+/// Tests are conservative: a box or sphere outside the frustum but close to one of its edges
+/// can be reported visible, a visible one is never culled.
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub struct Frustum {
+    planes: [Vector4; 6],
+    /// Planes as arrays of normal `x`, `y`, `z`, distance and absolute normal `x`, `y`, `z`,
+    /// so every test is a straight 8 lanes loop the compiler vectorizes.
+    lanes: [[f32; LANES]; 7],
+}
+
+impl Frustum {
+    /// Returns the frustum of a view-projection matrix (`view * projection`), clip space
+    /// matching OpenGL conventions.
+    pub fn from_matrix(mat: &Matrix) -> Frustum {
+        let r0 = [mat.m0, mat.m4, mat.m8, mat.m12];
+        let r1 = [mat.m1, mat.m5, mat.m9, mat.m13];
+        let r2 = [mat.m2, mat.m6, mat.m10, mat.m14];
+        let r3 = [mat.m3, mat.m7, mat.m11, mat.m15];
+        let plane = |r: [f32; 4], sign: f32| {
+            Vector4::new(
+                r3[0] + sign * r[0],
+                r3[1] + sign * r[1],
+                r3[2] + sign * r[2],
+                r3[3] + sign * r[3],
+            )
+        };
+
+        Frustum::from_planes([
+            plane(r0, 1.0),
+            plane(r0, -1.0),
+            plane(r1, 1.0),
+            plane(r1, -1.0),
+            plane(r2, 1.0),
+            plane(r2, -1.0),
+        ])
+    }
+
+    /// Returns the frustum `begin_mode3D` uses for `camera`, `aspect` being the render width
+    /// divided by its height.
+    pub fn from_camera(camera: &Camera3D, aspect: f32) -> Frustum {
+        let view = Matrix::look_at(camera.position, camera.target, camera.up);
+        let projection = match camera.camera_type() {
+            CameraProjection::CAMERA_PERSPECTIVE => Matrix::perspective(
+                camera.fovy.to_radians(),
+                aspect,
+                CULL_DISTANCE_NEAR,
+                CULL_DISTANCE_FAR,
+            ),
+            CameraProjection::CAMERA_ORTHOGRAPHIC => {
+                let top = camera.fovy / 2.0;
+                let right = top * aspect;
+                Matrix::ortho(
+                    -right,
+                    right,
+                    -top,
+                    top,
+                    CULL_DISTANCE_NEAR,
+                    CULL_DISTANCE_FAR,
+                )
+            }
+        };
+        Frustum::from_matrix(&(view * projection))
+    }
+
+    /// Returns a frustum from six planes, see [`Frustum::planes`]. Planes are normalized.
+    pub fn from_planes(planes: [Vector4; 6]) -> Frustum {
+        let mut frustum = Frustum {
+            planes,
+            lanes: [[0.0; LANES]; 7],
+        };
+        frustum.lanes[3] = [f32::MAX; LANES];
+
+        for (i, p) in frustum.planes.iter_mut().enumerate() {
+            let length = (p.x * p.x + p.y * p.y + p.z * p.z).sqrt();
+            if length != 0.0 {
+                *p = Vector4::new(p.x / length, p.y / length, p.z / length, p.w / length);
+            }
+
+            let lane = [p.x, p.y, p.z, p.w, p.x.abs(), p.y.abs(), p.z.abs()];
+            for (l, v) in frustum.lanes.iter_mut().zip(lane.iter()) {
+                l[i] = *v;
+            }
+        }
+        frustum
+    }
+
+    /// Left, right, bottom, top, near and far planes, normalized. `x, y, z` is the normal
+    /// (pointing inside) and `w` the distance: point `p` is inside a plane if
+    /// `x*p.x + y*p.y + z*p.z + w >= 0`. Build a new frustum with `from_planes` to change them.
+    #[inline]
+    pub fn planes(&self) -> &[Vector4; 6] {
+        &self.planes
+    }
+
+    /// Checks if `point` is inside the frustum.
+    #[inline]
+    pub fn contains_point(&self, point: Vector3) -> bool {
+        self.intersects_sphere(point, 0.0)
+    }
+
+    /// Checks if a sphere is at least partly inside the frustum.
+    #[inline]
+    pub fn intersects_sphere(&self, center: Vector3, radius: f32) -> bool {
+        let [nx, ny, nz, d, ..] = &self.lanes;
+        let mut outside = false;
+        for k in 0..LANES {
+            let distance = nx[k] * center.x + ny[k] * center.y + nz[k] * center.z + d[k];
+            outside |= distance + radius < 0.0;
+        }
+        !outside
+    }
+
+    /// Checks if a bounding box is at least partly inside the frustum.
+    #[inline]
+    pub fn intersects_box(&self, bounds: &BoundingBox) -> bool {
+        let center = (bounds.min + bounds.max) * 0.5;
+        let extents = (bounds.max - bounds.min) * 0.5;
+
+        // Distance of the box corner furthest along each plane normal
+        let [nx, ny, nz, d, ax, ay, az] = &self.lanes;
+        let mut outside = false;
+        for k in 0..LANES {
+            let distance = nx[k] * center.x + ny[k] * center.y + nz[k] * center.z + d[k];
+            let radius = ax[k] * extents.x + ay[k] * extents.y + az[k] * extents.z;
+            outside |= distance + radius < 0.0;
+        }
+        !outside
+    }
+
+    /// Tests every box, `visible` is overwritten with one bit per box.
+    pub fn cull_boxes(&self, boxes: &[BoundingBox], visible: &mut VisibilitySet) {
+        visible.fill(boxes.len(), |i| self.intersects_box(&boxes[i]));
+    }
+
+    /// Tests every sphere, `visible` is overwritten with one bit per sphere.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `radii` is shorter than `centers`.
+    pub fn cull_spheres(&self, centers: &[Vector3], radii: &[f32], visible: &mut VisibilitySet) {
+        let radii = &radii[..centers.len()];
+        visible.fill(centers.len(), |i| {
+            self.intersects_sphere(centers[i], radii[i])
+        });
+    }
+}
+
+/// Visibility bitset filled by [`Frustum::cull_boxes`] and [`Frustum::cull_spheres`],
+/// one bit per tested item.
+///
+/// Keep it across frames to reuse its memory.
+#[derive(Debug, Default, Clone, PartialEq)]
+pub struct VisibilitySet {
+    words: Vec<u64>,
+    len: usize,
+}
+
+impl VisibilitySet {
+    pub fn new() -> VisibilitySet {
+        VisibilitySet::default()
+    }
+
+    /// Number of tested items.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Checks if item `index` is visible.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `index` is out of bounds.
+    #[inline]
+    pub fn is_visible(&self, index: usize) -> bool {
+        assert!(index < self.len, "index out of bounds");
+        self.words[index / 64] & (1 << (index % 64)) != 0
+    }
+
+    /// Number of visible items.
+    pub fn count_visible(&self) -> usize {
+        self.words.iter().map(|w| w.count_ones() as usize).sum()
+    }
+
+    /// Iterates over visible items indices, in increasing order.
+    pub fn iter_visible(&self) -> impl Iterator<Item = usize> + '_ {
+        self.words.iter().enumerate().flat_map(|(i, word)| {
+            let mut word = *word;
+            std::iter::from_fn(move || {
+                if word == 0 {
+                    return None;
+                }
+                let bit = word.trailing_zeros() as usize;
+                word &= word - 1;
+                Some(i * 64 + bit)
+            })
+        })
+    }
+
+    /// Raw bits, item `i` is bit `i % 64` of word `i / 64`. Bits past `len` are zero.
+    #[inline]
+    pub fn words(&self) -> &[u64] {
+        &self.words
+    }
+
+    fn fill(&mut self, len: usize, visible: impl Fn(usize) -> bool) {
+        self.len = len;
+        self.words.clear();
+        self.words.extend((0..len).step_by(64).map(|start| {
+            let mut word = 0;
+            for i in start..len.min(start + 64) {
+                word |= (visible(i) as u64) << (i - start);
+            }
+            word
+        }));
+    }
+}
+
+#[cfg(test)]
+mod frustum_test {
+    use super::*;
+
+    fn test_frustum() -> Frustum {
+        // Looking towards -z from the origin
+        let camera = Camera3D::perspective(
+            Vector3::zero(),
+            Vector3::new(0.0, 0.0, -1.0),
+            Vector3::up(),
+            90.0,
+        );
+        Frustum::from_camera(&camera, 1.0)
+    }
+
+    fn unit_box(center: Vector3) -> BoundingBox {
+        BoundingBox::new(center - Vector3::one() * 0.5, center + Vector3::one() * 0.5)
+    }
+
+    #[test]
+    fn test_frustum_planes() {
+        let frustum = test_frustum();
+
+        assert!(frustum.contains_point(Vector3::new(0.0, 0.0, -10.0)));
+        assert!(frustum.contains_point(Vector3::new(9.0, -9.0, -10.0)));
+        assert!(!frustum.contains_point(Vector3::new(11.0, 0.0, -10.0)));
+        assert!(!frustum.contains_point(Vector3::new(0.0, 0.0, 10.0)));
+        assert!(!frustum.contains_point(Vector3::new(0.0, 0.0, -2000.0)));
+
+        assert!(frustum.intersects_box(&unit_box(Vector3::new(0.0, 0.0, -5.0))));
+        assert!(frustum.intersects_box(&unit_box(Vector3::new(10.4, 0.0, -10.0))));
+        assert!(!frustum.intersects_box(&unit_box(Vector3::new(0.0, 0.0, 5.0))));
+        assert!(!frustum.intersects_box(&unit_box(Vector3::new(12.0, 0.0, -10.0))));
+
+        assert!(frustum.intersects_sphere(Vector3::new(0.0, 0.0, 1.0), 1.5));
+        assert!(!frustum.intersects_sphere(Vector3::new(0.0, 0.0, 2.0), 1.5));
+    }
+
+    #[test]
+    fn test_frustum_bulk() {
+        let frustum = test_frustum();
+        let centers: Vec<Vector3> = (0..1000)
+            .map(|i| Vector3::new((i % 10) as f32 * 3.0 - 15.0, 0.0, (i / 10) as f32 - 50.0))
+            .collect();
+        let radii = vec![0.5; centers.len()];
+        let boxes: Vec<BoundingBox> = centers.iter().map(|c| unit_box(*c)).collect();
+
+        let mut visible = VisibilitySet::new();
+        frustum.cull_boxes(&boxes, &mut visible);
+        assert_eq!(visible.len(), boxes.len());
+        for (i, b) in boxes.iter().enumerate() {
+            assert_eq!(visible.is_visible(i), frustum.intersects_box(b));
+        }
+        let indices: Vec<usize> = visible.iter_visible().collect();
+        assert_eq!(indices.len(), visible.count_visible());
+        assert!(indices.iter().all(|i| visible.is_visible(*i)));
+        assert!(indices.len() > 0 && indices.len() < boxes.len());
+
+        frustum.cull_spheres(&centers, &radii, &mut visible);
+        for (i, c) in centers.iter().enumerate() {
+            assert_eq!(visible.is_visible(i), frustum.intersects_sphere(*c, 0.5));
+        }
+    }
+
+    #[test]
+    fn test_bounding_box_transformed() {
+        let bounds = unit_box(Vector3::zero());
+        let moved = bounds.transformed(
+            &(Matrix::scale(2.0, 1.0, 1.0)
+                * Matrix::rotate_y(std::f32::consts::FRAC_PI_2)
+                * Matrix::translate(0.0, 0.0, -10.0)),
+        );
+
+        let expected = BoundingBox::new(
+            Vector3::new(-0.5, -0.5, -11.0),
+            Vector3::new(0.5, 0.5, -9.0),
+        );
+        assert!((moved.min - expected.min).length() < 1e-5, "{:?}", moved);
+        assert!((moved.max - expected.max).length() < 1e-5, "{:?}", moved);
+    }
+}
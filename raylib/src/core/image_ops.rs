@@ -0,0 +1,592 @@
+//! In place RGBA8 pixel kernels behind the `Image` color adjustments and mipmaps
+//!
+//! Color adjustments match the raylib C functions byte for byte. Kernels work on `Color`
+//! slices and split the work across threads above `PARALLEL_THRESHOLD` pixels.
+use crate::core::color::Color;
+use crate::core::math_batch::{par_chunks, PARALLEL_THRESHOLD};
+
+/// Pixel bytes, `r, g, b, a` for every pixel.
+#[inline]
+fn bytes_mut(pixels: &mut [Color]) -> &mut [u8] {
+    // Color is 4 u8 fields, `repr(C)`
+    unsafe { std::slice::from_raw_parts_mut(pixels.as_mut_ptr() as *mut u8, pixels.len() * 4) }
+}
+
+#[inline]
+fn color_bytes(pixels: &[Color]) -> &[u8] {
+    unsafe { std::slice::from_raw_parts(pixels.as_ptr() as *const u8, pixels.len() * 4) }
+}
+
+/// Replaces every channel by its entry in the matching table, `luts` being `r, g, b, a`.
+fn apply_luts(pixels: &mut [Color], luts: &[[u8; 256]; 4]) {
+    par_chunks(pixels, PARALLEL_THRESHOLD, |_, pixels| {
+        let [r, g, b, a] = luts;
+        for p in pixels.iter_mut() {
+            p.r = r[p.r as usize];
+            p.g = g[p.g as usize];
+            p.b = b[p.b as usize];
+            p.a = a[p.a as usize];
+        }
+    });
+}
+
+fn lut(f: impl Fn(u8) -> u8) -> [u8; 256] {
+    let mut lut = [0; 256];
+    for (i, v) in lut.iter_mut().enumerate() {
+        *v = f(i as u8);
+    }
+    lut
+}
+
+fn identity_lut() -> [u8; 256] {
+    lut(|v| v)
+}
+
+/// Multiplies every channel by `color`, same as `ImageColorTint`.
+pub fn tint_pixels(pixels: &mut [Color], color: Color) {
+    let channel = |c: u8| {
+        let c = c as f32 / 255.0;
+        lut(move |v| ((v as f32 / 255.0 * c) * 255.0) as u8)
+    };
+    apply_luts(
+        pixels,
+        &[
+            channel(color.r),
+            channel(color.g),
+            channel(color.b),
+            channel(color.a),
+        ],
+    );
+}
+
+/// Inverts `r, g, b`, same as `ImageColorInvert`.
+pub fn invert_pixels(pixels: &mut [Color]) {
+    par_chunks(pixels, PARALLEL_THRESHOLD, |_, pixels| {
+        // Whole 16 bytes blocks first, a straight loop the compiler vectorizes
+        const MASK: [u8; 16] = [
+            255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0,
+        ];
+        let mut blocks = bytes_mut(pixels).chunks_exact_mut(16);
+        for block in &mut blocks {
+            for (b, m) in block.iter_mut().zip(MASK.iter()) {
+                *b ^= m;
+            }
+        }
+        for (b, m) in blocks.into_remainder().iter_mut().zip(MASK.iter()) {
+            *b ^= m;
+        }
+    });
+}
+
+/// Writes the luminance of every pixel to `out`, same conversion as `ImageColorGrayscale`.
+///
+/// # Panics
+///
+/// Panics if `out` is shorter than `pixels`.
+pub fn grayscale_pixels(pixels: &[Color], out: &mut [u8]) {
+    par_chunks(
+        &mut out[..pixels.len()],
+        PARALLEL_THRESHOLD,
+        |offset, out| {
+            let pixels = &pixels[offset..offset + out.len()];
+            for (o, p) in out.iter_mut().zip(pixels) {
+                let (r, g, b) = (p.r as f32 / 255.0, p.g as f32 / 255.0, p.b as f32 / 255.0);
+                *o = ((r * 0.299 + g * 0.587 + b * 0.114) * 255.0) as u8;
+            }
+        },
+    );
+}
+
+/// Scales `r, g, b` contrast by `contrast` in `[-100, 100]`, same as `ImageColorContrast`.
+pub fn contrast_pixels(pixels: &mut [Color], contrast: f32) {
+    let contrast = (100.0 + contrast.max(-100.0).min(100.0)) / 100.0;
+    let contrast = contrast * contrast;
+    let channel = lut(|v| {
+        let v = ((v as f32 / 255.0 - 0.5) * contrast + 0.5) * 255.0;
+        v.max(0.0).min(255.0) as u8
+    });
+    apply_luts(pixels, &[channel, channel, channel, identity_lut()]);
+}
+
+/// Adds `brightness` in `[-255, 255]` to `r, g, b`, same as `ImageColorBrightness`.
+pub fn brightness_pixels(pixels: &mut [Color], brightness: i32) {
+    let brightness = brightness.max(-255).min(255);
+    let channel = lut(|v| {
+        let v = v as i32 + brightness;
+        // The C function clamps negative values to 1, 0 stays 0
+        if v < 0 {
+            1
+        } else {
+            v.min(255) as u8
+        }
+    });
+    apply_luts(pixels, &[channel, channel, channel, identity_lut()]);
+}
+
+/// Multiplies `r, g, b` by alpha, same as `ImageAlphaPremultiply`.
+pub fn premultiply_pixels(pixels: &mut [Color]) {
+    let premultiply = |v: u8, a: u8| (v as f32 * (a as f32 / 255.0)) as u8;
+    if pixels.len() < PARALLEL_THRESHOLD {
+        for p in pixels.iter_mut() {
+            p.r = premultiply(p.r, p.a);
+            p.g = premultiply(p.g, p.a);
+            p.b = premultiply(p.b, p.a);
+        }
+        return;
+    }
+
+    // Large images: a 64 KiB table indexed by alpha then value, twice as fast as the floats
+    let mut table = vec![0; 256 * 256];
+    for (i, t) in table.iter_mut().enumerate() {
+        *t = premultiply((i & 255) as u8, (i >> 8) as u8);
+    }
+    let table = &table;
+    par_chunks(pixels, PARALLEL_THRESHOLD, |_, pixels| {
+        for p in pixels.iter_mut() {
+            let row = &table[(p.a as usize) << 8..][..256];
+            p.r = row[p.r as usize];
+            p.g = row[p.g as usize];
+            p.b = row[p.b as usize];
+        }
+    });
+}
+
+/// Floyd-Steinberg dithers `pixels` to `r_bpp, g_bpp, b_bpp, a_bpp` bits per channel, same as
+/// `ImageDither`: `out` gets one 16 bits `RGBA` value per pixel, `pixels` is used as the error
+/// buffer. Runs on the calling thread, every pixel depends on the previous ones.
+///
+/// # Panics
+///
+/// Panics if a bit depth is not in `[0, 8]`, if `out` or `pixels` are shorter than
+/// `width * height`.
+pub fn dither_pixels(
+    pixels: &mut [Color],
+    width: usize,
+    height: usize,
+    (r_bpp, g_bpp, b_bpp, a_bpp): (u32, u32, u32, u32),
+    out: &mut [u16],
+) {
+    assert!(
+        r_bpp <= 8 && g_bpp <= 8 && b_bpp <= 8 && a_bpp <= 8,
+        "bit depths must be in [0, 8]"
+    );
+    let (pixels, out) = (&mut pixels[..width * height], &mut out[..width * height]);
+    // `>> 8` overflows on u8, the shifts are done on u32
+    let quantize = |v: u8, bpp: u32| {
+        (
+            (v as u32) >> (8 - bpp),
+            (v as u32) >> (8 - bpp) << (8 - bpp),
+        )
+    };
+    let diffuse = |p: &mut Color, error: [i32; 3], weight: f32| {
+        let add =
+            |v: &mut u8, e: i32| *v = (*v as i32 + (e as f32 * weight) as i32).min(0xff) as u8;
+        add(&mut p.r, error[0]);
+        add(&mut p.g, error[1]);
+        add(&mut p.b, error[2]);
+    };
+
+    for y in 0..height {
+        for x in 0..width {
+            let i = y * width + x;
+            let old = pixels[i];
+            let (r, r_rounded) = quantize(old.r, r_bpp);
+            let (g, g_rounded) = quantize(old.g, g_bpp);
+            let (b, b_rounded) = quantize(old.b, b_bpp);
+            let (a, _) = quantize(old.a, a_bpp);
+            let error = [
+                old.r as i32 - r_rounded as i32,
+                old.g as i32 - g_rounded as i32,
+                old.b as i32 - b_rounded as i32,
+            ];
+
+            if x + 1 < width {
+                diffuse(&mut pixels[i + 1], error, 7.0 / 16.0);
+            }
+            if y + 1 < height {
+                if x > 0 {
+                    diffuse(&mut pixels[i + width - 1], error, 3.0 / 16.0);
+                }
+                diffuse(&mut pixels[i + width], error, 5.0 / 16.0);
+                if x + 1 < width {
+                    diffuse(&mut pixels[i + width + 1], error, 1.0 / 16.0);
+                }
+            }
+
+            out[i] = (r << (g_bpp + b_bpp + a_bpp) | g << (b_bpp + a_bpp) | b << a_bpp | a) as u16;
+        }
+    }
+}
+
+/// Number of mipmap levels of a `width * height` image down to 1x1, same count as
+/// `ImageMipmaps`, and the pixel count of the whole chain.
+pub fn mipmap_chain_size(width: usize, height: usize) -> (usize, usize) {
+    let (mut w, mut h) = (width.max(1), height.max(1));
+    let (mut levels, mut pixels) = (1, w * h);
+    while w > 1 || h > 1 {
+        w = (w / 2).max(1);
+        h = (h / 2).max(1);
+        levels += 1;
+        pixels += w * h;
+    }
+    (levels, pixels)
+}
+
+/// Taps of one axis of a mipmap level: destination `i` is the sum of `weights[k]` times
+/// source `2 * i + k`.
+fn mip_taps(src: usize, i: usize) -> ([f32; 3], usize) {
+    if src == 1 {
+        ([1.0, 0.0, 0.0], 1)
+    } else if src % 2 == 0 {
+        ([0.5, 0.5, 0.0], 2)
+    } else {
+        // Odd size: box filter over 2 + 1 / dst pixels, so every source pixel counts the same
+        let dst = (src / 2) as f32;
+        let scale = 1.0 / src as f32;
+        let i = i as f32;
+        ([(dst - i) * scale, dst * scale, (i + 1.0) * scale], 3)
+    }
+}
+
+/// Generates every mipmap level of the `width * height` image at the start of `pixels`, one
+/// level after the other, as `Image` stores them. Each level is a box filter of the previous
+/// one, odd sizes included. With `srgb` colors are averaged in linear space, alpha is always
+/// linear. Returns the number of levels.
+///
+/// # Panics
+///
+/// Panics if `pixels` is shorter than [`mipmap_chain_size`] pixels.
+pub fn gen_mipmap_chain(pixels: &mut [Color], width: usize, height: usize, srgb: bool) -> usize {
+    let (levels, len) = mipmap_chain_size(width, height);
+    let mut pixels = &mut pixels[..len];
+    let luts = if srgb { Some(SrgbLuts::new()) } else { None };
+
+    let (mut w, mut h) = (width.max(1), height.max(1));
+    for _ in 1..levels {
+        let (src, rest) = pixels.split_at_mut(w * h);
+        let (dst_w, dst_h) = ((w / 2).max(1), (h / 2).max(1));
+        let dst = &mut rest[..dst_w * dst_h];
+
+        let mut rows: Vec<&mut [Color]> = dst.chunks_mut(dst_w).collect();
+        let min_rows = (PARALLEL_THRESHOLD / dst_w).max(1);
+        par_chunks(&mut rows, min_rows, |offset, rows| match &luts {
+            None if w % 2 == 0 && h % 2 == 0 => {
+                for (y, row) in rows.iter_mut().enumerate() {
+                    let y = (offset + y) * 2;
+                    average_2x2(&src[y * w..][..w], &src[(y + 1) * w..][..w], row);
+                }
+            }
+            Some(luts) if w % 2 == 0 && h % 2 == 0 => {
+                for (y, row) in rows.iter_mut().enumerate() {
+                    let y = (offset + y) * 2;
+                    average_2x2_srgb(&src[y * w..][..w], &src[(y + 1) * w..][..w], luts, row);
+                }
+            }
+            luts => {
+                let mut line = vec![0.0; w * 4];
+                for (y, row) in rows.iter_mut().enumerate() {
+                    let y = offset + y;
+                    let (weights, taps) = mip_taps(h, y);
+                    for v in line.iter_mut() {
+                        *v = 0.0;
+                    }
+                    for (k, weight) in weights[..taps].iter().enumerate() {
+                        let src_row = &src[(2 * y + k).min(h - 1) * w..][..w];
+                        accumulate_row(src_row, *weight, luts.as_ref(), &mut line);
+                    }
+                    filter_row(&line, w, luts.as_ref(), row);
+                }
+            }
+        });
+
+        pixels = rest;
+        w = dst_w;
+        h = dst_h;
+    }
+    levels
+}
+
+/// `(a + b + c + d + 2) / 4` of every 2x2 block of two rows.
+fn average_2x2(top: &[Color], bottom: &[Color], dst: &mut [Color]) {
+    let (top, bottom) = (color_bytes(top), color_bytes(bottom));
+    // Vertical sums first, contiguous so the compiler vectorizes them
+    let sums: Vec<u16> = top
+        .iter()
+        .zip(bottom)
+        .map(|(a, b)| *a as u16 + *b as u16)
+        .collect();
+    for (d, s) in bytes_mut(dst).chunks_exact_mut(4).zip(sums.chunks_exact(8)) {
+        for c in 0..4 {
+            d[c] = ((s[c] + s[c + 4] + 2) >> 2) as u8;
+        }
+    }
+}
+
+/// [`average_2x2`] in linear space.
+fn average_2x2_srgb(top: &[Color], bottom: &[Color], luts: &SrgbLuts, dst: &mut [Color]) {
+    let (top, bottom) = (color_bytes(top), color_bytes(bottom));
+    let decode = |b: u8| luts.decode[b as usize];
+    for ((d, t), b) in bytes_mut(dst)
+        .chunks_exact_mut(4)
+        .zip(top.chunks_exact(8))
+        .zip(bottom.chunks_exact(8))
+    {
+        for c in 0..3 {
+            let sum = decode(t[c]) + decode(t[c + 4]) + decode(b[c]) + decode(b[c + 4]);
+            d[c] = luts.encode(sum * 0.25);
+        }
+        d[3] = ((t[3] as u16 + t[7] as u16 + b[3] as u16 + b[7] as u16 + 2) >> 2) as u8;
+    }
+}
+
+/// Adds `weight` times `row`, decoded to linear floats, to `line`.
+fn accumulate_row(row: &[Color], weight: f32, luts: Option<&SrgbLuts>, line: &mut [f32]) {
+    let bytes = color_bytes(row);
+    match luts {
+        Some(luts) => {
+            let alpha = weight / 255.0;
+            for (l, b) in line.chunks_exact_mut(4).zip(bytes.chunks_exact(4)) {
+                l[0] += weight * luts.decode[b[0] as usize];
+                l[1] += weight * luts.decode[b[1] as usize];
+                l[2] += weight * luts.decode[b[2] as usize];
+                l[3] += alpha * b[3] as f32;
+            }
+        }
+        None => {
+            let weight = weight / 255.0;
+            for (l, b) in line.iter_mut().zip(bytes) {
+                *l += weight * *b as f32;
+            }
+        }
+    }
+}
+
+/// Horizontal filter of a line of `width` vertically filtered pixels, encoded into `dst`.
+fn filter_row(line: &[f32], width: usize, luts: Option<&SrgbLuts>, dst: &mut [Color]) {
+    let encode = |acc: [f32; 4]| match luts {
+        Some(luts) => Color::new(
+            luts.encode(acc[0]),
+            luts.encode(acc[1]),
+            luts.encode(acc[2]),
+            (acc[3] * 255.0 + 0.5) as u8,
+        ),
+        None => Color::new(
+            (acc[0] * 255.0 + 0.5) as u8,
+            (acc[1] * 255.0 + 0.5) as u8,
+            (acc[2] * 255.0 + 0.5) as u8,
+            (acc[3] * 255.0 + 0.5) as u8,
+        ),
+    };
+
+    if width % 2 == 0 {
+        for (d, p) in dst.iter_mut().zip(line.chunks_exact(8)) {
+            let mut acc = [0.0; 4];
+            for c in 0..4 {
+                acc[c] = (p[c] + p[c + 4]) * 0.5;
+            }
+            *d = encode(acc);
+        }
+        return;
+    }
+    for (x, d) in dst.iter_mut().enumerate() {
+        let (weights, taps) = mip_taps(width, x);
+        let mut acc = [0.0; 4];
+        for (k, weight) in weights[..taps].iter().enumerate() {
+            let p = &line[(2 * x + k).min(width - 1) * 4..][..4];
+            for c in 0..4 {
+                acc[c] += weight * p[c];
+            }
+        }
+        *d = encode(acc);
+    }
+}
+
+/// sRGB transfer function tables.
+struct SrgbLuts {
+    /// sRGB byte to linear value in `[0, 1]`.
+    decode: [f32; 256],
+    /// Linear value quantized to `SRGB_ENCODE_STEPS` steps, to sRGB byte.
+    encode: Vec<u8>,
+}
+
+/// Encode table size: fine enough near black, where the sRGB curve is steepest, to round
+/// like the exact function.
+const SRGB_ENCODE_STEPS: usize = 1 << 14;
+
+impl SrgbLuts {
+    fn new() -> SrgbLuts {
+        let mut decode = [0.0; 256];
+        for (i, d) in decode.iter_mut().enumerate() {
+            let v = i as f32 / 255.0;
+            *d = if v <= 0.04045 {
+                v / 12.92
+            } else {
+                ((v + 0.055) / 1.055).powf(2.4)
+            };
+        }
+        let encode = (0..SRGB_ENCODE_STEPS)
+            .map(|i| {
+                let v = i as f32 / (SRGB_ENCODE_STEPS - 1) as f32;
+                let v = if v <= 0.003_130_8 {
+                    v * 12.92
+                } else {
+                    1.055 * v.powf(1.0 / 2.4) - 0.055
+                };
+                (v * 255.0 + 0.5) as u8
+            })
+            .collect();
+        SrgbLuts { decode, encode }
+    }
+
+    #[inline]
+    fn encode(&self, v: f32) -> u8 {
+        let i = (v * (SRGB_ENCODE_STEPS - 1) as f32 + 0.5) as usize;
+        self.encode[i.min(SRGB_ENCODE_STEPS - 1)]
+    }
+}
+
+#[cfg(test)]
+mod image_ops_test {
+    use super::*;
+
+    /// Above `PARALLEL_THRESHOLD`, so the large images paths run.
+    fn test_pixels() -> Vec<Color> {
+        (0..256 * 300)
+            .map(|i: u32| {
+                let v = i.wrapping_mul(2_654_435_761);
+                Color::new(v as u8, (v >> 8) as u8, (v >> 16) as u8, (v >> 24) as u8)
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_color_kernels() {
+        let pixels = test_pixels();
+
+        let mut out = pixels.clone();
+        tint_pixels(&mut out, Color::new(255, 128, 0, 255));
+        for (p, o) in pixels.iter().zip(&out) {
+            assert_eq!(o.r, p.r);
+            assert_eq!(o.g, ((p.g as f32 / 255.0 * (128.0 / 255.0)) * 255.0) as u8);
+            assert_eq!((o.b, o.a), (0, p.a));
+        }
+
+        let mut out = pixels.clone();
+        invert_pixels(&mut out);
+        for (p, o) in pixels.iter().zip(&out) {
+            assert_eq!(*o, Color::new(255 - p.r, 255 - p.g, 255 - p.b, p.a));
+        }
+
+        let mut gray = vec![0; pixels.len()];
+        grayscale_pixels(&pixels, &mut gray);
+        assert_eq!(gray[0], 0);
+        assert!(pixels
+            .iter()
+            .zip(&gray)
+            .all(|(p, g)| *g <= p.r.max(p.g).max(p.b)));
+
+        let mut out = pixels.clone();
+        contrast_pixels(&mut out, 0.0);
+        // Float rounding of the C formula can lose 1
+        assert!(pixels
+            .iter()
+            .zip(&out)
+            .all(|(p, o)| p.r - o.r <= 1 && p.a == o.a));
+        let mut out = pixels.clone();
+        contrast_pixels(&mut out, 100.0);
+        for (p, o) in pixels.iter().zip(&out) {
+            assert_eq!(o.a, p.a);
+            assert!(if p.r < 128 { o.r <= p.r } else { o.r >= p.r });
+        }
+
+        let mut out = pixels.clone();
+        brightness_pixels(&mut out, -40);
+        for (p, o) in pixels.iter().zip(&out) {
+            let expected = match p.r as i32 - 40 {
+                v if v < 0 => 1,
+                v => v as u8,
+            };
+            assert_eq!((o.r, o.a), (expected, p.a));
+        }
+
+        let mut out = pixels.clone();
+        premultiply_pixels(&mut out);
+        let mut small = pixels[..1000].to_vec();
+        premultiply_pixels(&mut small);
+        assert_eq!(small, out[..1000]);
+        for (p, o) in pixels.iter().zip(&out) {
+            assert!(o.r <= p.r && o.g <= p.g && o.a == p.a);
+            if p.a == 255 {
+                assert_eq!(o, p);
+            }
+        }
+    }
+
+    #[test]
+    fn test_dither() {
+        let (width, height) = (16, 8);
+        let mut pixels: Vec<Color> = (0..width * height)
+            .map(|i| Color::new((i * 2) as u8, 100, 255, 255))
+            .collect();
+        let mut out = vec![0; pixels.len()];
+        dither_pixels(&mut pixels, width, height, (5, 6, 5, 0), &mut out);
+
+        // Constant channels stay constant, no error to spread
+        assert!(out.iter().all(|p| p & 0x1f == 0x1f));
+        assert!(out.iter().all(|p| (p >> 5) & 0x3f == 100 >> 2));
+        // The red ramp goes up with the dither noise
+        assert_eq!(out[0] >> 11, 0);
+        assert_eq!(
+            out[width * height - 1] >> 11,
+            ((width * height - 1) * 2) as u16 >> 3
+        );
+    }
+
+    #[test]
+    fn test_mipmap_chain() {
+        assert_eq!(mipmap_chain_size(1, 1), (1, 1));
+        assert_eq!(mipmap_chain_size(4, 2), (3, 8 + 2 + 1));
+        assert_eq!(mipmap_chain_size(5, 3), (3, 15 + 2 + 1));
+
+        // Even sizes: plain 2x2 averages
+        let (width, height) = (8, 4);
+        let base = test_pixels()[..width * height].to_vec();
+        let mut chain = base.clone();
+        chain.resize(mipmap_chain_size(width, height).1, Color::default());
+        assert_eq!(gen_mipmap_chain(&mut chain, width, height, false), 4);
+        assert_eq!(chain[..width * height], base[..]);
+        let average = |a: u8, b: u8, c: u8, d: u8| {
+            ((a as u16 + b as u16 + c as u16 + d as u16 + 2) / 4) as u8
+        };
+        let level1 = &chain[width * height..];
+        assert_eq!(
+            level1[1].g,
+            average(base[2].g, base[3].g, base[10].g, base[11].g)
+        );
+
+        // Every source pixel weighs the same, odd sizes included: a constant stays constant
+        for (width, height, srgb) in [(7, 5, false), (7, 5, true), (6, 4, true)].iter() {
+            let (width, height) = (*width, *height);
+            let color = Color::new(200, 30, 128, 77);
+            let mut chain = vec![color; mipmap_chain_size(width, height).1];
+            chain[width * height..]
+                .iter_mut()
+                .for_each(|p| *p = Color::default());
+            gen_mipmap_chain(&mut chain, width, height, *srgb);
+            assert!(chain.iter().all(|p| *p == color), "{:?}", chain);
+        }
+
+        // 3x1 to 1x1 averages the 3 pixels
+        let mut chain = vec![
+            Color::new(0, 0, 0, 0),
+            Color::new(30, 30, 30, 30),
+            Color::new(90, 90, 90, 90),
+            Color::default(),
+        ];
+        gen_mipmap_chain(&mut chain, 3, 1, false);
+        assert_eq!(chain[3], Color::new(40, 40, 40, 40));
+        gen_mipmap_chain(&mut chain, 3, 1, true);
+        assert_eq!(chain[3].a, 40);
+        assert!(chain[3].r > 40, "linear average is brighter");
+    }
+}
@@ -0,0 +1,654 @@
+//! Asynchronous asset loading: decoded on worker threads, uploaded on the main thread
+use crate::core::audio::{Sound, Wave};
+use crate::core::models::{Mesh, MeshData};
+use crate::core::text::Font;
+use crate::core::texture::{Image, Texture2D};
+use crate::core::{RaylibHandle, RaylibThread};
+use crate::ffi;
+use std::any::Any;
+use std::cell::RefCell;
+use std::collections::{HashMap, VecDeque};
+use std::panic::{self, AssertUnwindSafe};
+use std::path::{Path, PathBuf};
+use std::rc::Rc;
+use std::sync::atomic::{AtomicBool, AtomicU8, AtomicUsize, Ordering};
+use std::sync::mpsc::{self, Receiver, Sender};
+use std::sync::{Arc, Mutex};
+use std::thread::{self, JoinHandle};
+use std::time::{Duration, Instant};
+
+/// CPU side asset data, decoded on a worker thread before its upload.
+pub trait AssetData: Send + 'static {
+    /// Size of the data in bytes, for loader statistics.
+    fn size_bytes(&self) -> usize;
+}
+
+impl AssetData for Image {
+    fn size_bytes(&self) -> usize {
+        self.get_pixel_data_size()
+    }
+}
+
+impl AssetData for Wave {
+    fn size_bytes(&self) -> usize {
+        self.0.sampleCount as usize * self.0.sampleSize as usize / 8
+    }
+}
+
+impl AssetData for MeshData {
+    fn size_bytes(&self) -> usize {
+        MeshData::size_bytes(self)
+    }
+}
+
+impl AssetData for Vec<u8> {
+    fn size_bytes(&self) -> usize {
+        self.len()
+    }
+}
+
+/// Font glyphs and atlas decoded from a TTF/OTF file, waiting for the atlas upload.
+struct FontData {
+    base_size: i32,
+    padding: i32,
+    atlas: Image,
+    chars: *mut ffi::CharInfo,
+    recs: *mut ffi::Rectangle,
+    count: i32,
+}
+
+// Glyph images and rectangles are in CPU memory, owned by the font data
+unsafe impl Send for FontData {}
+
+impl Drop for FontData {
+    fn drop(&mut self) {
+        unsafe {
+            ffi::UnloadFontData(self.chars, self.count);
+            ffi::MemFree(self.recs as *mut _);
+        }
+    }
+}
+
+impl AssetData for FontData {
+    fn size_bytes(&self) -> usize {
+        self.atlas.get_pixel_data_size()
+    }
+}
+
+impl FontData {
+    /// Does what `LoadFontEx` does for the default 95 characters, but the atlas upload.
+    fn load(path: &str, font_size: i32) -> Result<FontData, String> {
+        const CHARS_COUNT: i32 = 95;
+        const CHARS_PADDING: i32 = 4;
+
+        let bytes = std::fs::read(path).map_err(|e| format!("{}: {}", path, e))?;
+        unsafe {
+            let chars = ffi::LoadFontData(
+                bytes.as_ptr(),
+                bytes.len() as i32,
+                font_size,
+                std::ptr::null_mut(),
+                CHARS_COUNT,
+                0, // FONT_DEFAULT
+            );
+            if chars.is_null() {
+                return Err(format!(
+                    "Error loading font {}. Is it the right type?",
+                    path
+                ));
+            }
+            let mut recs = std::ptr::null_mut();
+            let atlas = Image(ffi::GenImageFontAtlas(
+                chars,
+                &mut recs,
+                CHARS_COUNT,
+                font_size,
+                CHARS_PADDING,
+                0,
+            ));
+            if atlas.data.is_null() || recs.is_null() {
+                ffi::UnloadFontData(chars, CHARS_COUNT);
+                ffi::MemFree(recs as *mut _);
+                return Err(format!("Error generating font atlas of {}", path));
+            }
+            // Glyph images are replaced by their atlas part, with alpha, like LoadFontEx does
+            for i in 0..CHARS_COUNT as usize {
+                let char_info = &mut *chars.add(i);
+                ffi::UnloadImage(char_info.image);
+                char_info.image = ffi::ImageFromImage(atlas.0, *recs.add(i));
+            }
+            Ok(FontData {
+                base_size: font_size,
+                padding: CHARS_PADDING,
+                atlas,
+                chars,
+                recs,
+                count: CHARS_COUNT,
+            })
+        }
+    }
+
+    fn upload(mut self, rl: &mut RaylibHandle, thread: &RaylibThread) -> Result<Font, String> {
+        let texture = rl.load_texture_from_image(thread, &self.atlas)?;
+        let font = Font(ffi::Font {
+            baseSize: self.base_size,
+            charsCount: self.count,
+            charsPadding: self.padding,
+            texture: unsafe { texture.unwrap() },
+            recs: self.recs,
+            chars: self.chars,
+        });
+        // Glyphs are owned by the font now
+        self.chars = std::ptr::null_mut();
+        self.recs = std::ptr::null_mut();
+        self.count = 0;
+        Ok(font)
+    }
+}
+
+/// Loading step an asset is at.
+#[derive(Debug, Copy, Clone, PartialEq, Eq, Hash)]
+pub enum AssetState {
+    /// Waiting for a worker thread.
+    Queued = 0,
+    /// Being read and decoded on a worker thread.
+    Decoding = 1,
+    /// Decoded, waiting for its upload on the main thread.
+    Uploading = 2,
+    /// Loaded, or failed to: the result can be taken.
+    Ready = 3,
+}
+
+impl AssetState {
+    fn from_u8(state: u8) -> AssetState {
+        match state {
+            0 => AssetState::Queued,
+            1 => AssetState::Decoding,
+            2 => AssetState::Uploading,
+            _ => AssetState::Ready,
+        }
+    }
+}
+
+struct Slot<T> {
+    state: Arc<AtomicU8>,
+    result: RefCell<Option<Result<T, String>>>,
+}
+
+/// Asset being loaded by an [`AssetLoader`], resolved by `AssetLoader::update`.
+///
+/// Dropping the handle before it resolves cancels the upload, decoded data is dropped.
+pub struct AssetHandle<T> {
+    slot: Rc<Slot<T>>,
+}
+
+impl<T> AssetHandle<T> {
+    pub fn state(&self) -> AssetState {
+        AssetState::from_u8(self.slot.state.load(Ordering::Acquire))
+    }
+
+    /// Returns true once the asset is loaded or failed to.
+    pub fn is_ready(&self) -> bool {
+        self.state() == AssetState::Ready
+    }
+
+    /// Takes the loaded asset or its loading error, once ready. Returns `None` before, and
+    /// after the result has been taken.
+    pub fn take(&mut self) -> Option<Result<T, String>> {
+        self.slot.result.borrow_mut().take()
+    }
+}
+
+impl<T> std::fmt::Debug for AssetHandle<T> {
+    fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.debug_struct("AssetHandle")
+            .field("state", &self.state())
+            .finish()
+    }
+}
+
+/// Counters of an [`AssetLoader`], bytes are decoded data sizes.
+#[derive(Debug, Default, Copy, Clone, PartialEq, Eq)]
+pub struct LoaderStats {
+    pub queued: usize,
+    pub decoding: usize,
+    pub uploading: usize,
+    pub uploading_bytes: usize,
+    /// Assets loaded since the loader was created.
+    pub loaded: usize,
+    pub loaded_bytes: usize,
+    /// Assets that failed to load since the loader was created.
+    pub failed: usize,
+    /// Assets whose handle was dropped before their upload, since the loader was created.
+    pub cancelled: usize,
+}
+
+type Decoded = Result<(Box<dyn Any + Send>, usize), String>;
+/// Uploads a decoded asset, returns whether it loaded, `None` if its handle was dropped.
+type Upload = Box<
+    dyn FnOnce(
+        &mut RaylibHandle,
+        &RaylibThread,
+        Result<Box<dyn Any + Send>, String>,
+    ) -> Option<bool>,
+>;
+
+struct Job {
+    id: u64,
+    state: Arc<AtomicU8>,
+    decode: Box<dyn FnOnce() -> Decoded + Send>,
+}
+
+struct Shared {
+    jobs: Mutex<Receiver<Job>>,
+    closing: AtomicBool,
+    queued: AtomicUsize,
+    /// Jobs a worker is decoding.
+    decoding: AtomicUsize,
+}
+
+/// Loads assets without hitches: files are read and decoded on worker threads, GPU uploads
+/// happen on the main thread in `update`, within a time budget per frame.
+///
+/// Workers read files in parallel, but images and waves are decoded by raylib functions sharing
+/// static buffers, so only one worker at a time decodes them. Fonts and meshes are not limited.
+///
+/// ```ignore
+/// let mut loader = AssetLoader::new(2);
+/// let mut tiles = loader.load_texture("tiles.png");
+/// while !rl.window_should_close() {
+///     loader.update(&mut rl, &thread, Duration::from_millis(2));
+///     if let Some(Ok(texture)) = tiles.take() { /* ... */ }
+/// }
+/// ```
+pub struct AssetLoader {
+    jobs: Option<Sender<Job>>,
+    decoded_sender: Sender<(u64, Decoded)>,
+    decoded: Receiver<(u64, Decoded)>,
+    shared: Arc<Shared>,
+    workers: Vec<JoinHandle<()>>,
+    uploads: HashMap<u64, (Arc<AtomicU8>, Upload)>,
+    /// Decoded assets in decoding completion order, with their size.
+    ready: VecDeque<(u64, Result<(Box<dyn Any + Send>, usize), String>)>,
+    next_id: u64,
+    stats: LoaderStats,
+}
+
+impl AssetLoader {
+    /// Creates a loader decoding on `workers` threads (at least one).
+    pub fn new(workers: usize) -> AssetLoader {
+        let (jobs, receiver) = mpsc::channel();
+        let (decoded_sender, decoded) = mpsc::channel();
+        let shared = Arc::new(Shared {
+            jobs: Mutex::new(receiver),
+            closing: AtomicBool::new(false),
+            queued: AtomicUsize::new(0),
+            decoding: AtomicUsize::new(0),
+        });
+        let workers = (0..workers.max(1))
+            .map(|i| {
+                let shared = shared.clone();
+                let decoded = decoded_sender.clone();
+                thread::Builder::new()
+                    .name(format!("asset decoder {}", i))
+                    .spawn(move || decode_assets(&shared, &decoded))
+                    .expect("could not spawn asset decoder thread")
+            })
+            .collect();
+
+        AssetLoader {
+            jobs: Some(jobs),
+            decoded_sender,
+            decoded,
+            shared,
+            workers,
+            uploads: HashMap::new(),
+            ready: VecDeque::new(),
+            next_id: 0,
+            stats: LoaderStats::default(),
+        }
+    }
+
+    /// Loads an asset decoded by `decode` on a worker thread, then turned into `T` by `upload`
+    /// on the main thread.
+    pub fn load_with<D: AssetData, T: 'static>(
+        &mut self,
+        decode: impl FnOnce() -> Result<D, String> + Send + 'static,
+        upload: impl FnOnce(&mut RaylibHandle, &RaylibThread, D) -> Result<T, String> + 'static,
+    ) -> AssetHandle<T> {
+        let id = self.next_id;
+        self.next_id += 1;
+        let slot = Rc::new(Slot {
+            state: Arc::new(AtomicU8::new(AssetState::Queued as u8)),
+            result: RefCell::new(None),
+        });
+
+        let handle = slot.clone();
+        let upload: Upload = Box::new(move |rl, thread, decoded| {
+            // Nobody waits for the asset anymore
+            if Rc::strong_count(&handle) == 1 {
+                return None;
+            }
+            let result = decoded.and_then(|data| match data.downcast::<D>() {
+                Ok(data) => upload(rl, thread, *data),
+                Err(_) => Err("asset decoded to an unexpected type".to_owned()),
+            });
+            let loaded = result.is_ok();
+            *handle.result.borrow_mut() = Some(result);
+            handle
+                .state
+                .store(AssetState::Ready as u8, Ordering::Release);
+            Some(loaded)
+        });
+        self.uploads.insert(id, (slot.state.clone(), upload));
+
+        let job = Job {
+            id,
+            state: slot.state.clone(),
+            decode: Box::new(move || {
+                decode().map(|data| {
+                    let size = data.size_bytes();
+                    (Box::new(data) as Box<dyn Any + Send>, size)
+                })
+            }),
+        };
+        self.shared.queued.fetch_add(1, Ordering::AcqRel);
+        if let Some(jobs) = &self.jobs {
+            let _ = jobs.send(job);
+        }
+        AssetHandle { slot }
+    }
+
+    /// Loads an image, nothing to upload.
+    pub fn load_image(&mut self, filename: &str) -> AssetHandle<Image> {
+        let filename = filename.to_owned();
+        self.load_with(move || decode_image(&filename), |_, _, image| Ok(image))
+    }
+
+    /// Loads a texture, its image decoded on a worker thread.
+    pub fn load_texture(&mut self, filename: &str) -> AssetHandle<Texture2D> {
+        let filename = filename.to_owned();
+        self.load_with(
+            move || decode_image(&filename),
+            |rl, thread, image| rl.load_texture_from_image(thread, &image),
+        )
+    }
+
+    /// Loads a font from a TTF/OTF file with the default 95 characters, like
+    /// `RaylibHandle::load_font_ex`, glyphs rasterized on a worker thread.
+    pub fn load_font(&mut self, filename: &str, font_size: i32) -> AssetHandle<Font> {
+        let filename = filename.to_owned();
+        self.load_with(
+            move || FontData::load(&filename, font_size),
+            |rl, thread, data| data.upload(rl, thread),
+        )
+    }
+
+    /// Loads a wave, nothing to upload.
+    pub fn load_wave(&mut self, filename: &str) -> AssetHandle<Wave> {
+        let filename = filename.to_owned();
+        self.load_with(move || decode_wave(&filename), |_, _, wave| Ok(wave))
+    }
+
+    /// Loads a sound, its wave decoded on a worker thread. The audio device must be
+    /// initialized before the upload.
+    pub fn load_sound(&mut self, filename: &str) -> AssetHandle<Sound> {
+        let filename = filename.to_owned();
+        self.load_with(
+            move || decode_wave(&filename),
+            |_, _, wave| Sound::load_sound_from_wave(&wave),
+        )
+    }
+
+    /// Loads a mesh built or parsed by `decode` on a worker thread.
+    pub fn load_mesh(
+        &mut self,
+        decode: impl FnOnce() -> Result<MeshData, String> + Send + 'static,
+    ) -> AssetHandle<Mesh> {
+        self.load_with(decode, |rl, thread, data| {
+            rl.load_mesh_from_data(thread, &data)
+        })
+    }
+
+    /// Loads a file content into memory, `upload` turns it into the asset on the main thread.
+    pub fn load_file<T: 'static>(
+        &mut self,
+        filename: impl Into<PathBuf>,
+        upload: impl FnOnce(&mut RaylibHandle, &RaylibThread, Vec<u8>) -> Result<T, String> + 'static,
+    ) -> AssetHandle<T> {
+        let filename = filename.into();
+        self.load_with(
+            move || std::fs::read(&filename).map_err(|e| format!("{}: {}", filename.display(), e)),
+            upload,
+        )
+    }
+
+    fn receive_decoded(&mut self) {
+        while let Ok((id, decoded)) = self.decoded.try_recv() {
+            self.push_decoded(id, decoded);
+        }
+    }
+
+    fn push_decoded(&mut self, id: u64, decoded: Decoded) {
+        if let Some((state, _)) = self.uploads.get(&id) {
+            state.store(AssetState::Uploading as u8, Ordering::Release);
+        }
+        self.ready.push_back((id, decoded));
+    }
+
+    /// Uploads decoded assets until `budget` is spent, at least one if any is ready.
+    /// Call it once per frame. Returns the number of assets resolved.
+    pub fn update(
+        &mut self,
+        rl: &mut RaylibHandle,
+        thread: &RaylibThread,
+        budget: Duration,
+    ) -> usize {
+        self.receive_decoded();
+
+        let start = Instant::now();
+        let mut resolved = 0;
+        while let Some((id, decoded)) = self.ready.pop_front() {
+            let (_, upload) = match self.uploads.remove(&id) {
+                Some(upload) => upload,
+                None => continue,
+            };
+            let size = decoded.as_ref().map_or(0, |(_, size)| *size);
+            match upload(rl, thread, decoded.map(|(data, _)| data)) {
+                Some(true) => {
+                    self.stats.loaded += 1;
+                    self.stats.loaded_bytes += size;
+                }
+                Some(false) => self.stats.failed += 1,
+                None => self.stats.cancelled += 1,
+            }
+            resolved += 1;
+            if start.elapsed() >= budget {
+                break;
+            }
+        }
+        resolved
+    }
+
+    /// Loads every queued asset, waiting for the workers, e.g. behind a loading screen.
+    pub fn flush(&mut self, rl: &mut RaylibHandle, thread: &RaylibThread) {
+        while !self.uploads.is_empty() {
+            self.update(rl, thread, Duration::from_secs(3600));
+            if self.ready.is_empty() && !self.uploads.is_empty() {
+                match self.decoded.recv_timeout(Duration::from_millis(100)) {
+                    Ok((id, decoded)) => self.push_decoded(id, decoded),
+                    Err(_) => continue,
+                }
+            }
+        }
+    }
+
+    /// Returns true if no asset is being loaded.
+    pub fn is_idle(&self) -> bool {
+        self.uploads.is_empty()
+    }
+
+    pub fn stats(&self) -> LoaderStats {
+        LoaderStats {
+            queued: self.shared.queued.load(Ordering::Acquire),
+            decoding: self.shared.decoding.load(Ordering::Acquire),
+            uploading: self.ready.len(),
+            uploading_bytes: self
+                .ready
+                .iter()
+                .map(|(_, d)| d.as_ref().map_or(0, |(_, size)| *size))
+                .sum(),
+            ..self.stats
+        }
+    }
+}
+
+impl Drop for AssetLoader {
+    fn drop(&mut self) {
+        // Queued jobs are skipped, the ones being decoded complete
+        self.shared.closing.store(true, Ordering::Release);
+        self.jobs = None;
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
+
+impl std::fmt::Debug for AssetLoader {
+    fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.debug_struct("AssetLoader")
+            .field("workers", &self.workers.len())
+            .field("stats", &self.stats())
+            .finish()
+    }
+}
+
+/// Reads `filename` and its type, e.g. `".png"`, for the `Load*FromMemory` functions. Files are
+/// read without holding the raylib file lock, only their decoding is serialized.
+fn read_asset(filename: &str) -> Result<(String, Vec<u8>), String> {
+    let bytes = std::fs::read(filename).map_err(|e| format!("{}: {}", filename, e))?;
+    let filetype = Path::new(filename)
+        .extension()
+        .map_or_else(String::new, |ext| format!(".{}", ext.to_string_lossy()));
+    Ok((filetype, bytes))
+}
+
+fn decode_image(filename: &str) -> Result<Image, String> {
+    let (filetype, bytes) = read_asset(filename)?;
+    Image::load_image_from_bytes(&filetype, &bytes).map_err(|e| format!("{}: {}", filename, e))
+}
+
+fn decode_wave(filename: &str) -> Result<Wave, String> {
+    let (filetype, bytes) = read_asset(filename)?;
+    Wave::load_wave_from_bytes(&filetype, &bytes).map_err(|e| format!("{}: {}", filename, e))
+}
+
+/// Decoder thread: decodes jobs until the loader is dropped.
+fn decode_assets(shared: &Shared, decoded: &Sender<(u64, Decoded)>) {
+    loop {
+        let job = match shared.jobs.lock() {
+            Ok(jobs) => jobs.recv(),
+            Err(_) => return,
+        };
+        let job = match job {
+            Ok(job) => job,
+            Err(_) => return,
+        };
+        if shared.closing.load(Ordering::Acquire) {
+            shared.queued.fetch_sub(1, Ordering::AcqRel);
+            continue;
+        }
+
+        // Counted as decoding before leaving the queue, so stats never miss it
+        shared.decoding.fetch_add(1, Ordering::AcqRel);
+        shared.queued.fetch_sub(1, Ordering::AcqRel);
+        job.state
+            .store(AssetState::Decoding as u8, Ordering::Release);
+        let result = panic::catch_unwind(AssertUnwindSafe(job.decode))
+            .unwrap_or_else(|_| Err("asset decoding panicked".to_owned()));
+        shared.decoding.fetch_sub(1, Ordering::AcqRel);
+        if decoded.send((job.id, result)).is_err() {
+            return;
+        }
+    }
+}
+
+#[cfg(test)]
+mod loader_test {
+    use super::*;
+
+    #[test]
+    fn test_loader_decoding() {
+        let mut loader = AssetLoader::new(2);
+        let handles: Vec<_> = (0..8)
+            .map(|i| {
+                loader.load_with(
+                    move || {
+                        if i == 3 {
+                            Err("missing".to_owned())
+                        } else {
+                            Ok(vec![i as u8; i * 10])
+                        }
+                    },
+                    |_, _, data| Ok(data.len()),
+                )
+            })
+            .collect();
+        assert!(!loader.is_idle());
+
+        // Decoded assets wait for `update` to be uploaded
+        let start = Instant::now();
+        while loader.stats().uploading < 8 {
+            loader.receive_decoded();
+            assert!(start.elapsed() < Duration::from_secs(10));
+            thread::yield_now();
+        }
+        let stats = loader.stats();
+        assert_eq!((stats.queued, stats.decoding), (0, 0));
+        assert_eq!(
+            stats.uploading_bytes,
+            (0..8).filter(|i| *i != 3).map(|i| i * 10).sum()
+        );
+        assert!(handles.iter().all(|h| h.state() == AssetState::Uploading));
+    }
+
+    #[test]
+    fn test_loader_decoding_count() {
+        let mut loader = AssetLoader::new(1);
+        let (release, blocked) = mpsc::channel::<()>();
+        let _slow = loader.load_with(
+            move || {
+                blocked.recv().unwrap();
+                Ok(vec![0u8])
+            },
+            |_, _, _| Ok(()),
+        );
+        let _next = loader.load_with(|| Ok(vec![0u8]), |_, _, _| Ok(()));
+
+        let start = Instant::now();
+        while loader.stats().decoding < 1 {
+            assert!(start.elapsed() < Duration::from_secs(10));
+            thread::yield_now();
+        }
+        let stats = loader.stats();
+        assert_eq!((stats.queued, stats.decoding, stats.uploading), (1, 1, 0));
+
+        // Both decoded, still in the channel: neither queued nor decoding
+        release.send(()).unwrap();
+        while loader.stats().queued + loader.stats().decoding > 0 {
+            assert!(start.elapsed() < Duration::from_secs(10));
+            thread::yield_now();
+        }
+        assert_eq!(loader.stats().uploading, 0);
+    }
+
+    #[test]
+    fn test_read_asset() {
+        let path = std::env::temp_dir().join(format!("raylib_loader_{}.PNG", std::process::id()));
+        std::fs::write(&path, b"data").unwrap();
+        let read = read_asset(&path.to_string_lossy());
+        std::fs::remove_file(&path).unwrap();
+        assert_eq!(read, Ok((".PNG".to_owned(), b"data".to_vec())));
+        assert!(decode_image(&path.to_string_lossy()).is_err());
+    }
+}
@@ -0,0 +1,347 @@
+//! Memory-mapped files and zero-copy image views
+use crate::consts::PixelFormat;
+use crate::core::color::Color;
+use crate::core::math::{Vector2, Vector3, Vector4};
+use crate::core::texture::{get_pixel_data_size, mem_alloc, Image, Texture2D};
+use crate::core::{RaylibHandle, RaylibThread};
+use crate::ffi;
+use std::fs::File;
+use std::ops::Range;
+use std::path::Path;
+
+/// Read-only file mapped in memory, pages are read from disk when first touched.
+///
+/// On platforms without `mmap` the file is read into memory instead.
+pub struct MappedFile {
+    ptr: *const u8,
+    len: usize,
+    #[cfg(not(unix))]
+    _data: Box<[u8]>,
+}
+
+// The mapping is read-only and unmapped on drop only
+unsafe impl Send for MappedFile {}
+unsafe impl Sync for MappedFile {}
+
+impl MappedFile {
+    /// Maps the file at `path`.
+    ///
+    /// # Safety
+    ///
+    /// The file must not be written to nor truncated while mapped. The mapping is private, but
+    /// pages not read yet still show later writes, breaking the immutability of the returned
+    /// slices, and reading pages past a truncation raises `SIGBUS`.
+    #[cfg(unix)]
+    pub unsafe fn open(path: impl AsRef<Path>) -> std::io::Result<MappedFile> {
+        use std::os::unix::io::AsRawFd;
+
+        let file = File::open(path)?;
+        let len = file.metadata()?.len() as usize;
+        if len == 0 {
+            return Ok(MappedFile {
+                ptr: std::ptr::NonNull::dangling().as_ptr(),
+                len,
+            });
+        }
+        let ptr = libc::mmap(
+            std::ptr::null_mut(),
+            len,
+            libc::PROT_READ,
+            libc::MAP_PRIVATE,
+            file.as_raw_fd(),
+            0,
+        );
+        if ptr == libc::MAP_FAILED {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(MappedFile {
+            ptr: ptr as *const u8,
+            len,
+        })
+    }
+
+    /// Reads the file at `path`.
+    ///
+    /// # Safety
+    ///
+    /// Always safe here, `unsafe` keeps the signature of the mapping version.
+    #[cfg(not(unix))]
+    pub unsafe fn open(path: impl AsRef<Path>) -> std::io::Result<MappedFile> {
+        use std::io::Read;
+
+        let mut data = Vec::new();
+        File::open(path)?.read_to_end(&mut data)?;
+        let data = data.into_boxed_slice();
+        Ok(MappedFile {
+            ptr: data.as_ptr(),
+            len: data.len(),
+            _data: data,
+        })
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    pub fn as_bytes(&self) -> &[u8] {
+        unsafe { std::slice::from_raw_parts(self.ptr, self.len) }
+    }
+
+    /// Bytes in `range`, `None` if out of bounds.
+    pub fn bytes(&self, range: Range<usize>) -> Option<&[u8]> {
+        self.as_bytes().get(range)
+    }
+
+    /// `count` values at byte `offset`, `None` if out of bounds or misaligned.
+    pub fn slice<T: Plain>(&self, offset: usize, count: usize) -> Option<&[T]> {
+        let size = count.checked_mul(std::mem::size_of::<T>())?;
+        cast_slice(self.bytes(offset..offset.checked_add(size)?)?)
+    }
+
+    /// Hints the OS that `range` is about to be read, so its pages are read ahead from disk.
+    pub fn prefetch(&self, range: Range<usize>) {
+        #[cfg(unix)]
+        unsafe {
+            let end = range.end.min(self.len);
+            if range.start >= end {
+                return;
+            }
+            // madvise wants a page aligned address
+            let page = libc::sysconf(libc::_SC_PAGESIZE).max(1) as usize;
+            let start = range.start / page * page;
+            libc::madvise(
+                self.ptr.add(start) as *mut libc::c_void,
+                end - start,
+                libc::MADV_WILLNEED,
+            );
+        }
+        #[cfg(not(unix))]
+        let _ = range;
+    }
+}
+
+impl Drop for MappedFile {
+    fn drop(&mut self) {
+        #[cfg(unix)]
+        unsafe {
+            if self.len > 0 {
+                libc::munmap(self.ptr as *mut libc::c_void, self.len);
+            }
+        }
+    }
+}
+
+impl AsRef<[u8]> for MappedFile {
+    fn as_ref(&self) -> &[u8] {
+        self.as_bytes()
+    }
+}
+
+impl std::fmt::Debug for MappedFile {
+    fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.debug_struct("MappedFile")
+            .field("len", &self.len)
+            .finish()
+    }
+}
+
+/// Plain data types any bit pattern is valid for, which can be viewed from raw bytes.
+pub unsafe trait Plain: Copy {}
+
+unsafe impl Plain for u8 {}
+unsafe impl Plain for u16 {}
+unsafe impl Plain for u32 {}
+unsafe impl Plain for i32 {}
+unsafe impl Plain for f32 {}
+unsafe impl Plain for Color {}
+unsafe impl Plain for Vector2 {}
+unsafe impl Plain for Vector3 {}
+unsafe impl Plain for Vector4 {}
+
+/// Views `bytes` as values of `T`, `None` if misaligned or not a whole number of values.
+pub fn cast_slice<T: Plain>(bytes: &[u8]) -> Option<&[T]> {
+    let size = std::mem::size_of::<T>();
+    if size == 0
+        || bytes.len() % size != 0
+        || bytes.as_ptr() as usize % std::mem::align_of::<T>() != 0
+    {
+        return None;
+    }
+    Some(unsafe { std::slice::from_raw_parts(bytes.as_ptr() as *const T, bytes.len() / size) })
+}
+
+/// Image borrowing its pixel data, e.g. from a [`MappedFile`], uploaded without copies with
+/// [`RaylibHandle::load_texture_from_view`].
+#[derive(Debug, Copy, Clone, PartialEq)]
+pub struct ImageView<'a> {
+    data: &'a [u8],
+    width: i32,
+    height: i32,
+    mipmaps: i32,
+    format: PixelFormat,
+}
+
+impl<'a> ImageView<'a> {
+    /// Views `data` as a `width` x `height` image of `format` with `mipmaps` levels, the
+    /// levels following each other like raylib lays them out. Extra data is ignored.
+    pub fn new(
+        data: &'a [u8],
+        width: i32,
+        height: i32,
+        mipmaps: i32,
+        format: PixelFormat,
+    ) -> Result<ImageView<'a>, String> {
+        if width <= 0 || height <= 0 || mipmaps <= 0 {
+            return Err(format!(
+                "invalid image view size {}x{}, {} mipmaps",
+                width, height, mipmaps
+            ));
+        }
+        let size = mipmaps_size(width, height, mipmaps, format);
+        if data.len() < size {
+            return Err(format!(
+                "image view needs {} bytes, {} provided",
+                size,
+                data.len()
+            ));
+        }
+        Ok(ImageView {
+            data: &data[..size],
+            width,
+            height,
+            mipmaps,
+            format,
+        })
+    }
+
+    pub fn data(&self) -> &'a [u8] {
+        self.data
+    }
+
+    pub fn width(&self) -> i32 {
+        self.width
+    }
+
+    pub fn height(&self) -> i32 {
+        self.height
+    }
+
+    pub fn mipmaps(&self) -> i32 {
+        self.mipmaps
+    }
+
+    pub fn format(&self) -> PixelFormat {
+        self.format
+    }
+
+    /// Copies the view into an owned image.
+    pub fn to_image(&self) -> Result<Image, String> {
+        let data = mem_alloc::<u8>(self.data.len())
+            .ok_or_else(|| format!("could not allocate {} bytes of image", self.data.len()))?;
+        unsafe {
+            std::ptr::copy_nonoverlapping(self.data.as_ptr(), data, self.data.len());
+            Ok(Image(ffi::Image {
+                data: data as *mut _,
+                width: self.width,
+                height: self.height,
+                mipmaps: self.mipmaps,
+                format: self.format as i32,
+            }))
+        }
+    }
+}
+
+impl Image {
+    /// Borrows the image pixel data.
+    pub fn view(&self) -> ImageView<'_> {
+        let size = mipmaps_size(self.width, self.height, self.mipmaps, self.format());
+        let data = if self.data.is_null() {
+            &[][..]
+        } else {
+            unsafe { std::slice::from_raw_parts(self.data as *const u8, size) }
+        };
+        ImageView {
+            data,
+            width: self.width,
+            height: self.height,
+            mipmaps: self.mipmaps,
+            format: self.format(),
+        }
+    }
+}
+
+/// Size in bytes of an image and its `mipmaps - 1` smaller levels.
+fn mipmaps_size(width: i32, height: i32, mipmaps: i32, format: PixelFormat) -> usize {
+    (0..mipmaps)
+        .map(|level| {
+            let width = (width >> level).max(1);
+            let height = (height >> level).max(1);
+            get_pixel_data_size(width, height, format) as usize
+        })
+        .sum()
+}
+
+impl RaylibHandle {
+    /// Uploads an image view straight to the GPU, without an intermediate copy.
+    pub fn load_texture_from_view(
+        &mut self,
+        _: &RaylibThread,
+        view: &ImageView,
+    ) -> Result<Texture2D, String> {
+        if view.data.is_empty() {
+            return Err("failed to load image view as a texture.".to_owned());
+        }
+        // rlLoadTexture only reads the data
+        let id = unsafe {
+            ffi::rlLoadTexture(
+                view.data.as_ptr() as *mut _,
+                view.width,
+                view.height,
+                view.format as i32,
+                view.mipmaps,
+            )
+        };
+        if id == 0 {
+            return Err("failed to load image view as a texture.".to_owned());
+        }
+        Ok(Texture2D(ffi::Texture2D {
+            id,
+            width: view.width,
+            height: view.height,
+            mipmaps: view.mipmaps,
+            format: view.format as i32,
+        }))
+    }
+}
+
+#[cfg(test)]
+mod mapped_test {
+    use super::*;
+    use std::io::Write;
+
+    #[test]
+    fn test_mapped_file() {
+        let path = std::env::temp_dir().join(format!("raylib_mapped_{}", std::process::id()));
+        let mut file = File::create(&path).unwrap();
+        let values: Vec<u8> = (0..64).collect();
+        file.write_all(&values).unwrap();
+        drop(file);
+
+        let map = unsafe { MappedFile::open(&path) }.unwrap();
+        std::fs::remove_file(&path).unwrap();
+        assert_eq!(map.as_bytes(), &values[..]);
+        assert_eq!(map.bytes(60..64), Some(&values[60..64]));
+        assert_eq!(map.bytes(60..65), None);
+        map.prefetch(0..64);
+
+        let colors = map.slice::<Color>(4, 2).unwrap();
+        assert_eq!(colors[1], Color::new(8, 9, 10, 11));
+        assert!(map.slice::<u32>(2, 1).is_none());
+        assert!(map.slice::<Vector4>(0, 5).is_none());
+        assert_eq!(cast_slice::<u16>(&values[..3]), None);
+    }
+}
@@ -14,6 +14,7 @@ Permission is granted to anyone to use this software for any purpose, including
   3. This notice may not be removed or altered from any source distribution.
 */
 
+use crate::core::simd;
 use crate::ffi;
 use crate::misc::AsF32;
 use std::f32::consts::PI;
@@ -620,10 +621,11 @@ impl Vector3 {
 
     /// Returns a new `Vector3` containing components transformed by Matrix `mat`.
     pub fn transform_with(&self, mat: Matrix) -> Vector3 {
+        let v = simd::matrix_transform(&mat, Vector4::new(self.x, self.y, self.z, 1.0));
         Vector3 {
-            x: mat.m0 * self.x + mat.m4 * self.y + mat.m8 * self.z + mat.m12,
-            y: mat.m1 * self.x + mat.m5 * self.y + mat.m9 * self.z + mat.m13,
-            z: mat.m2 * self.x + mat.m6 * self.y + mat.m10 * self.z + mat.m14,
+            x: v.x,
+            y: v.y,
+            z: v.z,
         }
     }
 
@@ -1195,12 +1197,7 @@ impl Quaternion {
 
     /// Calculates linear interpolation between current and `q` quaternions.
     pub fn lerp(&self, q: Quaternion, amount: f32) -> Quaternion {
-        Quaternion {
-            x: self.x + amount * (q.x - self.x),
-            y: self.y + amount * (q.y - self.y),
-            z: self.z + amount * (q.z - self.z),
-            w: self.w + amount * (q.w - self.w),
-        }
+        simd::vector4_lerp(*self, q, amount)
     }
 
     /// Calculates slerp-optimized interpolation between current and `q` quaternions.
@@ -1210,7 +1207,7 @@ impl Quaternion {
 
     /// Calculates spherical linear interpolation between current and `q` quaternions.
     pub fn slerp(&self, q: Quaternion, amount: f32) -> Quaternion {
-        let cos_half_theta = self.x * q.x + self.y * q.y + self.z * q.z + self.w * q.w;
+        let cos_half_theta = simd::vector4_dot(*self, q);
 
         if cos_half_theta.abs() >= 1.0 {
             *self
@@ -1221,34 +1218,19 @@ impl Quaternion {
             let sin_half_theta = (1.0 - cos_half_theta * cos_half_theta).sqrt();
 
             if sin_half_theta.abs() < 0.001 {
-                Quaternion {
-                    x: (self.x * 0.5 + q.x * 0.5),
-                    y: (self.y * 0.5 + q.y * 0.5),
-                    z: (self.z * 0.5 + q.z * 0.5),
-                    w: (self.w * 0.5 + q.w * 0.5),
-                }
+                simd::vector4_blend(*self, 0.5, q, 0.5)
             } else {
                 let ratio_a = ((1.0 - amount) * half_theta).sin() / sin_half_theta;
                 let ratio_b = (amount * half_theta).sin() / sin_half_theta;
 
-                Quaternion {
-                    x: (self.x * ratio_a + q.x * ratio_b),
-                    y: (self.y * ratio_a + q.y * ratio_b),
-                    z: (self.z * ratio_a + q.z * ratio_b),
-                    w: (self.w * ratio_a + q.w * ratio_b),
-                }
+                simd::vector4_blend(*self, ratio_a, q, ratio_b)
             }
         }
     }
 
     /// Returns a transformed version of the current quaternion given a transformation matrix.
     pub fn transform(&self, mat: Matrix) -> Quaternion {
-        Quaternion {
-            x: mat.m0 * self.x + mat.m4 * self.y + mat.m8 * self.z + mat.m12 * self.w,
-            y: mat.m1 * self.x + mat.m5 * self.y + mat.m9 * self.z + mat.m13 * self.w,
-            z: mat.m2 * self.x + mat.m6 * self.y + mat.m10 * self.z + mat.m14 * self.w,
-            w: mat.m3 * self.x + mat.m7 * self.y + mat.m11 * self.z + mat.m15 * self.w,
-        }
+        simd::matrix_transform(&mat, *self)
     }
 
     /// Returns a new `Quaternion` with componenets clamp to a certain interval.
@@ -1310,21 +1292,7 @@ impl From<(f32, f32, f32, f32)> for Quaternion {
 impl Mul for Quaternion {
     type Output = Quaternion;
     fn mul(self, q: Quaternion) -> Quaternion {
-        let qax = self.x;
-        let qay = self.y;
-        let qaz = self.z;
-        let qaw = self.w;
-        let qbx = q.x;
-        let qby = q.y;
-        let qbz = q.z;
-        let qbw = q.w;
-
-        Quaternion {
-            x: (qax * qbw) + (qaw * qbx) + (qay * qbz) - (qaz * qby),
-            y: (qay * qbw) + (qaw * qby) + (qaz * qbx) - (qax * qbz),
-            z: (qaz * qbw) + (qaw * qbz) + (qax * qby) - (qay * qbx),
-            w: (qaw * qbw) - (qax * qbx) - (qay * qby) - (qaz * qbz),
-        }
+        simd::quaternion_mul(self, q)
     }
 }
 
@@ -1727,79 +1695,12 @@ impl Matrix {
 
     /// Returns a new `Matrix` transposed from the current one.
     pub fn transposed(&self) -> Matrix {
-        Matrix {
-            m0: self.m0,
-            m1: self.m4,
-            m2: self.m8,
-            m3: self.m12,
-            m4: self.m1,
-            m5: self.m5,
-            m6: self.m9,
-            m7: self.m13,
-            m8: self.m2,
-            m9: self.m6,
-            m10: self.m10,
-            m11: self.m14,
-            m12: self.m3,
-            m13: self.m7,
-            m14: self.m11,
-            m15: self.m15,
-        }
+        simd::matrix_transpose(self)
     }
 
     /// Returns a new `Matrix` inverted from the current one.
     pub fn inverted(&self) -> Matrix {
-        let a00 = self.m0;
-        let a01 = self.m1;
-        let a02 = self.m2;
-        let a03 = self.m3;
-        let a10 = self.m4;
-        let a11 = self.m5;
-        let a12 = self.m6;
-        let a13 = self.m7;
-        let a20 = self.m8;
-        let a21 = self.m9;
-        let a22 = self.m10;
-        let a23 = self.m11;
-        let a30 = self.m12;
-        let a31 = self.m13;
-        let a32 = self.m14;
-        let a33 = self.m15;
-
-        let b00 = (a00 * a11) - (a01 * a10);
-        let b01 = (a00 * a12) - (a02 * a10);
-        let b02 = (a00 * a13) - (a03 * a10);
-        let b03 = (a01 * a12) - (a02 * a11);
-        let b04 = (a01 * a13) - (a03 * a11);
-        let b05 = (a02 * a13) - (a03 * a12);
-        let b06 = (a20 * a31) - (a21 * a30);
-        let b07 = (a20 * a32) - (a22 * a30);
-        let b08 = (a20 * a33) - (a23 * a30);
-        let b09 = (a21 * a32) - (a22 * a31);
-        let b10 = (a21 * a33) - (a23 * a31);
-        let b11 = (a22 * a33) - (a23 * a32);
-
-        let inv_det = 1.0
-            / ((b00 * b11) - (b01 * b10) + (b02 * b09) + (b03 * b08) - (b04 * b07) + (b05 * b06));
-
-        Matrix {
-            m0: ((a11 * b11) - (a12 * b10) + (a13 * b09)) * inv_det,
-            m1: ((-a01 * b11) + (a02 * b10) - (a03 * b09)) * inv_det,
-            m2: ((a31 * b05) - (a32 * b04) + (a33 * b03)) * inv_det,
-            m3: ((-a21 * b05) + (a22 * b04) - (a23 * b03)) * inv_det,
-            m4: ((-a10 * b11) + (a12 * b08) - (a13 * b07)) * inv_det,
-            m5: ((a00 * b11) - (a02 * b08) + (a03 * b07)) * inv_det,
-            m6: ((-a30 * b05) + (a32 * b02) - (a33 * b01)) * inv_det,
-            m7: ((a20 * b05) - (a22 * b02) + (a23 * b01)) * inv_det,
-            m8: ((a10 * b10) - (a11 * b08) + (a13 * b06)) * inv_det,
-            m9: ((-a00 * b10) + (a01 * b08) - (a03 * b06)) * inv_det,
-            m10: ((a30 * b04) - (a31 * b02) + (a33 * b00)) * inv_det,
-            m11: ((-a20 * b04) + (a21 * b02) - (a23 * b00)) * inv_det,
-            m12: ((-a10 * b09) + (a11 * b07) - (a12 * b06)) * inv_det,
-            m13: ((a00 * b09) - (a01 * b07) + (a02 * b06)) * inv_det,
-            m14: ((-a30 * b03) + (a31 * b01) - (a32 * b00)) * inv_det,
-            m15: ((a20 * b03) - (a21 * b01) + (a22 * b00)) * inv_det,
-        }
+        simd::matrix_invert(self)
     }
 
     /// Returns a new `Matrix` normalized from the current one.
@@ -1837,24 +1738,7 @@ impl Matrix {
 impl Add for Matrix {
     type Output = Matrix;
     fn add(self, mat: Matrix) -> Matrix {
-        Matrix {
-            m0: self.m0 + mat.m0,
-            m1: self.m1 + mat.m1,
-            m2: self.m2 + mat.m2,
-            m3: self.m3 + mat.m3,
-            m4: self.m4 + mat.m4,
-            m5: self.m5 + mat.m5,
-            m6: self.m6 + mat.m6,
-            m7: self.m7 + mat.m7,
-            m8: self.m8 + mat.m8,
-            m9: self.m9 + mat.m9,
-            m10: self.m10 + mat.m10,
-            m11: self.m11 + mat.m11,
-            m12: self.m12 + mat.m12,
-            m13: self.m13 + mat.m13,
-            m14: self.m14 + mat.m14,
-            m15: self.m15 + mat.m15,
-        }
+        simd::matrix_add(&self, &mat)
     }
 }
 
@@ -1867,24 +1751,7 @@ impl AddAssign for Matrix {
 impl Sub for Matrix {
     type Output = Matrix;
     fn sub(self, mat: Matrix) -> Matrix {
-        Matrix {
-            m0: self.m0 - mat.m0,
-            m1: self.m1 - mat.m1,
-            m2: self.m2 - mat.m2,
-            m3: self.m3 - mat.m3,
-            m4: self.m4 - mat.m4,
-            m5: self.m5 - mat.m5,
-            m6: self.m6 - mat.m6,
-            m7: self.m7 - mat.m7,
-            m8: self.m8 - mat.m8,
-            m9: self.m9 - mat.m9,
-            m10: self.m10 - mat.m10,
-            m11: self.m11 - mat.m11,
-            m12: self.m12 - mat.m12,
-            m13: self.m13 - mat.m13,
-            m14: self.m14 - mat.m14,
-            m15: self.m15 - mat.m15,
-        }
+        simd::matrix_sub(&self, &mat)
     }
 }
 
@@ -1897,24 +1764,7 @@ impl SubAssign for Matrix {
 impl Mul for Matrix {
     type Output = Matrix;
     fn mul(self, mat: Matrix) -> Matrix {
-        Matrix {
-            m0: self.m0 * mat.m0 + self.m1 * mat.m4 + self.m2 * mat.m8 + self.m3 * mat.m12,
-            m1: self.m0 * mat.m1 + self.m1 * mat.m5 + self.m2 * mat.m9 + self.m3 * mat.m13,
-            m2: self.m0 * mat.m2 + self.m1 * mat.m6 + self.m2 * mat.m10 + self.m3 * mat.m14,
-            m3: self.m0 * mat.m3 + self.m1 * mat.m7 + self.m2 * mat.m11 + self.m3 * mat.m15,
-            m4: self.m4 * mat.m0 + self.m5 * mat.m4 + self.m6 * mat.m8 + self.m7 * mat.m12,
-            m5: self.m4 * mat.m1 + self.m5 * mat.m5 + self.m6 * mat.m9 + self.m7 * mat.m13,
-            m6: self.m4 * mat.m2 + self.m5 * mat.m6 + self.m6 * mat.m10 + self.m7 * mat.m14,
-            m7: self.m4 * mat.m3 + self.m5 * mat.m7 + self.m6 * mat.m11 + self.m7 * mat.m15,
-            m8: self.m8 * mat.m0 + self.m9 * mat.m4 + self.m10 * mat.m8 + self.m11 * mat.m12,
-            m9: self.m8 * mat.m1 + self.m9 * mat.m5 + self.m10 * mat.m9 + self.m11 * mat.m13,
-            m10: self.m8 * mat.m2 + self.m9 * mat.m6 + self.m10 * mat.m10 + self.m11 * mat.m14,
-            m11: self.m8 * mat.m3 + self.m9 * mat.m7 + self.m10 * mat.m11 + self.m11 * mat.m15,
-            m12: self.m12 * mat.m0 + self.m13 * mat.m4 + self.m14 * mat.m8 + self.m15 * mat.m12,
-            m13: self.m12 * mat.m1 + self.m13 * mat.m5 + self.m14 * mat.m9 + self.m15 * mat.m13,
-            m14: self.m12 * mat.m2 + self.m13 * mat.m6 + self.m14 * mat.m10 + self.m15 * mat.m14,
-            m15: self.m12 * mat.m3 + self.m13 * mat.m7 + self.m14 * mat.m11 + self.m15 * mat.m15,
-        }
+        simd::matrix_mul(&self, &mat)
     }
 }
 
@@ -2007,6 +1857,18 @@ impl BoundingBox {
     pub fn new(min: Vector3, max: Vector3) -> BoundingBox {
         BoundingBox { min, max }
     }
+
+    /// Returns the smallest box containing the current one transformed by `mat`.
+    pub fn transformed(&self, mat: &Matrix) -> BoundingBox {
+        let center = ((self.min + self.max) * 0.5).transform_with(*mat);
+        let e = (self.max - self.min) * 0.5;
+        let extents = Vector3 {
+            x: mat.m0.abs() * e.x + mat.m4.abs() * e.y + mat.m8.abs() * e.z,
+            y: mat.m1.abs() * e.x + mat.m5.abs() * e.y + mat.m9.abs() * e.z,
+            z: mat.m2.abs() * e.x + mat.m6.abs() * e.y + mat.m10.abs() * e.z,
+        };
+        BoundingBox::new(center - extents, center + extents)
+    }
 }
 
 impl From<ffi::BoundingBox> for BoundingBox {
@@ -2094,9 +1956,81 @@ impl Into<ffi::Transform> for &Transform {
 
 #[cfg(test)]
 mod math_test {
-    use super::{Ray, Vector2, Vector3, Vector4};
+    use super::{Matrix, Quaternion, Ray, Vector2, Vector3, Vector4};
+    use crate::core::simd::scalar;
     use crate::ffi;
 
+    fn test_matrices() -> Vec<Matrix> {
+        vec![
+            Matrix::identity(),
+            Matrix::translate(1.0, -2.0, 3.0),
+            Matrix::rotate(Vector3::new(1.0, 2.0, 3.0).normalized(), 0.7)
+                * Matrix::scale(2.0, 0.5, 1.5)
+                * Matrix::translate(-4.0, 5.0, 6.0),
+            Matrix::perspective(1.2, 16.0 / 9.0, 0.1, 100.0),
+            Matrix::look_at(
+                Vector3::new(3.0, 4.0, 5.0),
+                Vector3::zero(),
+                Vector3::up(),
+            ),
+        ]
+    }
+
+    fn assert_matrix_eq(a: Matrix, b: Matrix) {
+        for (x, y) in a.to_array().iter().zip(b.to_array().iter()) {
+            assert!((x - y).abs() <= 1e-4 * (1.0 + y.abs()), "{:?} != {:?}", a, b);
+        }
+    }
+
+    fn assert_vector4_eq(a: Vector4, b: Vector4) {
+        assert!(
+            (a.x - b.x).abs() < 1e-4
+                && (a.y - b.y).abs() < 1e-4
+                && (a.z - b.z).abs() < 1e-4
+                && (a.w - b.w).abs() < 1e-4,
+            "{:?} != {:?}",
+            a,
+            b
+        );
+    }
+
+    #[test]
+    fn test_simd_matrix() {
+        let matrices = test_matrices();
+        for a in matrices.iter() {
+            assert_matrix_eq(a.transposed(), scalar::matrix_transpose(a));
+            assert_matrix_eq(a.inverted(), scalar::matrix_invert(a));
+            assert_matrix_eq(*a * a.inverted(), Matrix::identity());
+
+            for b in matrices.iter() {
+                assert_matrix_eq(*a + *b, scalar::matrix_add(a, b));
+                assert_matrix_eq(*a - *b, scalar::matrix_sub(a, b));
+                assert_matrix_eq(*a * *b, scalar::matrix_mul(a, b));
+            }
+        }
+    }
+
+    #[test]
+    fn test_simd_vector() {
+        let q = Quaternion::from_axis_angle(Vector3::new(1.0, 1.0, 0.0).normalized(), 0.4);
+        let r = Quaternion::from_euler(0.3, -1.1, 2.0);
+        let v = Vector3::new(1.5, -2.0, 0.25);
+
+        for m in test_matrices().iter() {
+            let t = v.transform_with(*m);
+            let s = scalar::matrix_transform(m, Vector4::new(v.x, v.y, v.z, 1.0));
+            assert_vector4_eq(Vector4::new(t.x, t.y, t.z, s.w), s);
+            assert_vector4_eq(q.transform(*m), scalar::matrix_transform(m, q));
+        }
+
+        assert_vector4_eq(q * r, scalar::quaternion_mul(q, r));
+        assert_vector4_eq(r * q, scalar::quaternion_mul(r, q));
+        assert_vector4_eq(q.lerp(r, 0.3), scalar::vector4_lerp(q, r, 0.3));
+        assert_vector4_eq(q.slerp(r, 0.0), q);
+        assert_vector4_eq(q.slerp(r, 1.0), r);
+        assert!((q.slerp(r, 0.5).length() - 1.0).abs() < 1e-4);
+    }
+
     #[test]
     fn test_into() {
         let v2: ffi::Vector2 = (Vector2 { x: 1.0, y: 2.0 }).into();
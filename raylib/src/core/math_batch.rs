@@ -0,0 +1,859 @@
+//! Bulk math kernels: many points, vectors, quaternions or matrices per call
+//!
+//! Free functions work on plain slices, `Vec3Soa` and `Mat4Batch` store one array per
+//! component so every kernel is a straight loop the compiler vectorizes.
+//! `TriangleSoa` casts rays against packed triangles, 8 triangles per step.
+//! `par_*` variants split the work across threads above `PARALLEL_THRESHOLD` elements.
+use crate::core::bvh::{mesh_triangles, model_triangles};
+use crate::core::math::{Matrix, Quaternion, Ray, RayHitInfo, Vector3};
+use crate::ffi;
+
+/// Element count (ray triangle tests for ray casts) below which `par_*` kernels run on the
+/// calling thread.
+pub const PARALLEL_THRESHOLD: usize = 64 * 1024;
+
+/// Calls `f(offset, chunk)` over `out` chunks, on worker threads when `out` holds at least
+/// `min_len` elements.
+pub(crate) fn par_chunks<T: Send>(out: &mut [T], min_len: usize, f: impl Fn(usize, &mut [T]) + Sync) {
+    let workers = std::thread::available_parallelism().map_or(1, |n| n.get());
+    if out.len() < min_len || workers < 2 {
+        return f(0, out);
+    }
+
+    let chunk = (out.len() + workers - 1) / workers;
+    let f = &f;
+    std::thread::scope(|scope| {
+        for (i, c) in out.chunks_mut(chunk).enumerate() {
+            scope.spawn(move || f(i * chunk, c));
+        }
+    });
+}
+
+/// Same as `par_chunks`, for three arrays of the same length.
+fn par_chunks3(
+    x: &mut [f32],
+    y: &mut [f32],
+    z: &mut [f32],
+    f: impl Fn(usize, &mut [f32], &mut [f32], &mut [f32]) + Sync,
+) {
+    let workers = std::thread::available_parallelism().map_or(1, |n| n.get());
+    if x.len() < PARALLEL_THRESHOLD || workers < 2 {
+        return f(0, x, y, z);
+    }
+
+    let chunk = (x.len() + workers - 1) / workers;
+    let f = &f;
+    std::thread::scope(|scope| {
+        let chunks = x
+            .chunks_mut(chunk)
+            .zip(y.chunks_mut(chunk))
+            .zip(z.chunks_mut(chunk));
+        for (i, ((x, y), z)) in chunks.enumerate() {
+            scope.spawn(move || f(i * chunk, x, y, z));
+        }
+    });
+}
+
+/// Writes `points` transformed by `mat` into `out`.
+///
+/// # Panics
+///
+/// Panics if `out` is shorter than `points`.
+pub fn transform_points(mat: &Matrix, points: &[Vector3], out: &mut [Vector3]) {
+    let out = &mut out[..points.len()];
+    for (o, p) in out.iter_mut().zip(points) {
+        *o = Vector3 {
+            x: mat.m0 * p.x + mat.m4 * p.y + mat.m8 * p.z + mat.m12,
+            y: mat.m1 * p.x + mat.m5 * p.y + mat.m9 * p.z + mat.m13,
+            z: mat.m2 * p.x + mat.m6 * p.y + mat.m10 * p.z + mat.m14,
+        };
+    }
+}
+
+/// Normalizes every vector in place, zero vectors are left untouched.
+pub fn normalize_all(vectors: &mut [Vector3]) {
+    for v in vectors.iter_mut() {
+        let length = (v.x * v.x + v.y * v.y + v.z * v.z).sqrt();
+        let ilength = if length == 0.0 { 1.0 } else { 1.0 / length };
+        v.x *= ilength;
+        v.y *= ilength;
+        v.z *= ilength;
+    }
+}
+
+/// Writes `a` linearly interpolated by `amount` towards `b` into `out`.
+///
+/// # Panics
+///
+/// Panics if `b` or `out` are shorter than `a`.
+pub fn lerp_all(a: &[Vector3], b: &[Vector3], amount: f32, out: &mut [Vector3]) {
+    let (b, out) = (&b[..a.len()], &mut out[..a.len()]);
+    for ((o, a), b) in out.iter_mut().zip(a).zip(b) {
+        *o = Vector3 {
+            x: a.x + amount * (b.x - a.x),
+            y: a.y + amount * (b.y - a.y),
+            z: a.z + amount * (b.z - a.z),
+        };
+    }
+}
+
+/// Writes `a` spherically interpolated by `amount` towards `b` into `out`.
+///
+/// # Panics
+///
+/// Panics if `b` or `out` are shorter than `a`.
+pub fn quat_slerp_all(a: &[Quaternion], b: &[Quaternion], amount: f32, out: &mut [Quaternion]) {
+    let (b, out) = (&b[..a.len()], &mut out[..a.len()]);
+    for ((o, a), b) in out.iter_mut().zip(a).zip(b) {
+        *o = a.slerp(*b, amount);
+    }
+}
+
+/// Parallel version of [`transform_points`].
+pub fn par_transform_points(mat: &Matrix, points: &[Vector3], out: &mut [Vector3]) {
+    par_chunks(
+        &mut out[..points.len()],
+        PARALLEL_THRESHOLD,
+        |offset, out| transform_points(mat, &points[offset..offset + out.len()], out),
+    );
+}
+
+/// Parallel version of [`normalize_all`].
+pub fn par_normalize_all(vectors: &mut [Vector3]) {
+    par_chunks(vectors, PARALLEL_THRESHOLD, |_, vectors| {
+        normalize_all(vectors)
+    });
+}
+
+/// Parallel version of [`lerp_all`].
+pub fn par_lerp_all(a: &[Vector3], b: &[Vector3], amount: f32, out: &mut [Vector3]) {
+    let b = &b[..a.len()];
+    par_chunks(&mut out[..a.len()], PARALLEL_THRESHOLD, |offset, out| {
+        let range = offset..offset + out.len();
+        lerp_all(&a[range.clone()], &b[range], amount, out)
+    });
+}
+
+/// Parallel version of [`quat_slerp_all`].
+pub fn par_quat_slerp_all(a: &[Quaternion], b: &[Quaternion], amount: f32, out: &mut [Quaternion]) {
+    let b = &b[..a.len()];
+    par_chunks(&mut out[..a.len()], PARALLEL_THRESHOLD, |offset, out| {
+        let range = offset..offset + out.len();
+        quat_slerp_all(&a[range.clone()], &b[range], amount, out)
+    });
+}
+
+/// `Vector3` array stored as one array per component.
+///
+/// Components must keep the same length, which `push` and `clear` guarantee.
+#[derive(Debug, Default, Clone, PartialEq)]
+pub struct Vec3Soa {
+    pub x: Vec<f32>,
+    pub y: Vec<f32>,
+    pub z: Vec<f32>,
+}
+
+impl Vec3Soa {
+    /// Returns an empty `Vec3Soa`.
+    pub fn new() -> Vec3Soa {
+        Vec3Soa::default()
+    }
+
+    /// Returns an empty `Vec3Soa` able to hold `capacity` vectors without reallocating.
+    pub fn with_capacity(capacity: usize) -> Vec3Soa {
+        Vec3Soa {
+            x: Vec::with_capacity(capacity),
+            y: Vec::with_capacity(capacity),
+            z: Vec::with_capacity(capacity),
+        }
+    }
+
+    /// Returns a `Vec3Soa` holding a copy of `vectors`.
+    pub fn from_slice(vectors: &[Vector3]) -> Vec3Soa {
+        Vec3Soa {
+            x: vectors.iter().map(|v| v.x).collect(),
+            y: vectors.iter().map(|v| v.y).collect(),
+            z: vectors.iter().map(|v| v.z).collect(),
+        }
+    }
+
+    /// Number of vectors.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.x.len()
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.x.is_empty()
+    }
+
+    #[inline]
+    pub fn push(&mut self, v: Vector3) {
+        self.x.push(v.x);
+        self.y.push(v.y);
+        self.z.push(v.z);
+    }
+
+    #[inline]
+    pub fn get(&self, index: usize) -> Vector3 {
+        Vector3::new(self.x[index], self.y[index], self.z[index])
+    }
+
+    #[inline]
+    pub fn set(&mut self, index: usize, v: Vector3) {
+        self.x[index] = v.x;
+        self.y[index] = v.y;
+        self.z[index] = v.z;
+    }
+
+    pub fn clear(&mut self) {
+        self.x.clear();
+        self.y.clear();
+        self.z.clear();
+    }
+
+    /// Writes vectors into `out`, e.g. a mesh vertices array.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `out` is shorter than `self`.
+    pub fn write_to(&self, out: &mut [Vector3]) {
+        let out = &mut out[..self.len()];
+        for (i, o) in out.iter_mut().enumerate() {
+            *o = Vector3::new(self.x[i], self.y[i], self.z[i]);
+        }
+    }
+
+    pub fn to_vec(&self) -> Vec<Vector3> {
+        (0..self.len()).map(|i| self.get(i)).collect()
+    }
+
+    /// Transforms every point by `mat`.
+    pub fn transform(&mut self, mat: &Matrix) {
+        transform_soa(mat, &mut self.x, &mut self.y, &mut self.z);
+    }
+
+    /// Normalizes every vector, zero vectors are left untouched.
+    pub fn normalize(&mut self) {
+        normalize_soa(&mut self.x, &mut self.y, &mut self.z);
+    }
+
+    /// Moves every vector towards the matching `target` vector by `amount`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `target` is shorter than `self`.
+    pub fn lerp(&mut self, target: &Vec3Soa, amount: f32) {
+        let n = self.len();
+        lerp_soa(&mut self.x, &target.x[..n], amount);
+        lerp_soa(&mut self.y, &target.y[..n], amount);
+        lerp_soa(&mut self.z, &target.z[..n], amount);
+    }
+
+    /// Parallel version of [`Vec3Soa::transform`].
+    pub fn par_transform(&mut self, mat: &Matrix) {
+        par_chunks3(&mut self.x, &mut self.y, &mut self.z, |_, x, y, z| {
+            transform_soa(mat, x, y, z)
+        });
+    }
+
+    /// Parallel version of [`Vec3Soa::normalize`].
+    pub fn par_normalize(&mut self) {
+        par_chunks3(&mut self.x, &mut self.y, &mut self.z, |_, x, y, z| {
+            normalize_soa(x, y, z)
+        });
+    }
+
+    /// Parallel version of [`Vec3Soa::lerp`].
+    pub fn par_lerp(&mut self, target: &Vec3Soa, amount: f32) {
+        let n = self.len();
+        let (tx, ty, tz) = (&target.x[..n], &target.y[..n], &target.z[..n]);
+        par_chunks3(&mut self.x, &mut self.y, &mut self.z, |offset, x, y, z| {
+            let range = offset..offset + x.len();
+            lerp_soa(x, &tx[range.clone()], amount);
+            lerp_soa(y, &ty[range.clone()], amount);
+            lerp_soa(z, &tz[range], amount);
+        });
+    }
+}
+
+fn transform_soa(mat: &Matrix, x: &mut [f32], y: &mut [f32], z: &mut [f32]) {
+    let n = x.len();
+    let (y, z) = (&mut y[..n], &mut z[..n]);
+    for i in 0..n {
+        let (px, py, pz) = (x[i], y[i], z[i]);
+        x[i] = mat.m0 * px + mat.m4 * py + mat.m8 * pz + mat.m12;
+        y[i] = mat.m1 * px + mat.m5 * py + mat.m9 * pz + mat.m13;
+        z[i] = mat.m2 * px + mat.m6 * py + mat.m10 * pz + mat.m14;
+    }
+}
+
+fn normalize_soa(x: &mut [f32], y: &mut [f32], z: &mut [f32]) {
+    let n = x.len();
+    let (y, z) = (&mut y[..n], &mut z[..n]);
+    for i in 0..n {
+        let length = (x[i] * x[i] + y[i] * y[i] + z[i] * z[i]).sqrt();
+        let ilength = if length == 0.0 { 1.0 } else { 1.0 / length };
+        x[i] *= ilength;
+        y[i] *= ilength;
+        z[i] *= ilength;
+    }
+}
+
+fn lerp_soa(a: &mut [f32], b: &[f32], amount: f32) {
+    let b = &b[..a.len()];
+    for (a, b) in a.iter_mut().zip(b) {
+        *a += amount * (b - *a);
+    }
+}
+
+/// `Matrix` array stored as one array per field: `m[0]` holds every `m0`, `m[15]` every `m15`.
+///
+/// Fields must keep the same length, which `push` and `clear` guarantee.
+#[derive(Debug, Default, Clone, PartialEq)]
+pub struct Mat4Batch {
+    pub m: [Vec<f32>; 16],
+}
+
+impl Mat4Batch {
+    /// Returns an empty `Mat4Batch`.
+    pub fn new() -> Mat4Batch {
+        Mat4Batch::default()
+    }
+
+    /// Returns a `Mat4Batch` holding a copy of `matrices`.
+    pub fn from_slice(matrices: &[Matrix]) -> Mat4Batch {
+        let mut batch = Mat4Batch::default();
+        for m in batch.m.iter_mut() {
+            m.reserve(matrices.len());
+        }
+        for mat in matrices {
+            batch.push(*mat);
+        }
+        batch
+    }
+
+    /// Number of matrices.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.m[0].len()
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.m[0].is_empty()
+    }
+
+    pub fn push(&mut self, mat: Matrix) {
+        for (m, v) in self.m.iter_mut().zip(mat.to_array().iter()) {
+            m.push(*v);
+        }
+    }
+
+    pub fn get(&self, index: usize) -> Matrix {
+        let m = |i: usize| self.m[i][index];
+        Matrix {
+            m0: m(0),
+            m1: m(1),
+            m2: m(2),
+            m3: m(3),
+            m4: m(4),
+            m5: m(5),
+            m6: m(6),
+            m7: m(7),
+            m8: m(8),
+            m9: m(9),
+            m10: m(10),
+            m11: m(11),
+            m12: m(12),
+            m13: m(13),
+            m14: m(14),
+            m15: m(15),
+        }
+    }
+
+    pub fn clear(&mut self) {
+        for m in self.m.iter_mut() {
+            m.clear();
+        }
+    }
+
+    pub fn to_vec(&self) -> Vec<Matrix> {
+        (0..self.len()).map(|i| self.get(i)).collect()
+    }
+
+    /// Writes `self[i] * rhs[i]` into `out[i]` for every matrix, e.g. inverse bind poses by
+    /// joint poses. `out` is resized to `self.len()`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `rhs` is shorter than `self`.
+    pub fn multiply(&self, rhs: &Mat4Batch, out: &mut Mat4Batch) {
+        let n = self.len();
+        for m in out.m.iter_mut() {
+            m.resize(n, 0.0);
+        }
+
+        for i in 0..4 {
+            for j in 0..4 {
+                let (a0, a1, a2, a3) = (
+                    &self.m[4 * i][..n],
+                    &self.m[4 * i + 1][..n],
+                    &self.m[4 * i + 2][..n],
+                    &self.m[4 * i + 3][..n],
+                );
+                let (b0, b1, b2, b3) = (
+                    &rhs.m[j][..n],
+                    &rhs.m[4 + j][..n],
+                    &rhs.m[8 + j][..n],
+                    &rhs.m[12 + j][..n],
+                );
+                let o = &mut out.m[4 * i + j][..n];
+                for k in 0..n {
+                    o[k] = a0[k] * b0[k] + a1[k] * b1[k] + a2[k] * b2[k] + a3[k] * b3[k];
+                }
+            }
+        }
+    }
+
+    /// Writes `self[i] * mat` into every matrix, e.g. local poses by the model transform.
+    pub fn mul_matrix(&mut self, mat: &Matrix) {
+        let b = mat.to_array();
+        let n = self.len();
+        for i in 0..4 {
+            if let [r0, r1, r2, r3] = &mut self.m[4 * i..4 * i + 4] {
+                let (r0, r1, r2, r3) = (&mut r0[..n], &mut r1[..n], &mut r2[..n], &mut r3[..n]);
+                for k in 0..n {
+                    let (a0, a1, a2, a3) = (r0[k], r1[k], r2[k], r3[k]);
+                    r0[k] = a0 * b[0] + a1 * b[4] + a2 * b[8] + a3 * b[12];
+                    r1[k] = a0 * b[1] + a1 * b[5] + a2 * b[9] + a3 * b[13];
+                    r2[k] = a0 * b[2] + a1 * b[6] + a2 * b[10] + a3 * b[14];
+                    r3[k] = a0 * b[3] + a1 * b[7] + a2 * b[11] + a3 * b[15];
+                }
+            }
+        }
+    }
+}
+
+/// Lanes of a `TriangleSoa` step.
+const TRIANGLE_LANES: usize = 8;
+/// Same epsilon as `GetCollisionRayTriangle`.
+const RAY_EPSILON: f32 = 0.000001;
+
+/// Triangle soup packed for ray casts: first vertex and both edges of every triangle, one array
+/// per component.
+///
+/// Arrays are padded to a multiple of 8 with degenerate triangles, so the Möller–Trumbore test
+/// runs over 8 triangles at a time in a straight loop the compiler vectorizes. Brute force:
+/// for large static meshes queried by few rays, a `MeshBvh` is faster.
+#[derive(Debug, Default, Clone, PartialEq)]
+pub struct TriangleSoa {
+    /// First vertex, `x`, `y` and `z` arrays.
+    v0: [Vec<f32>; 3],
+    /// Second vertex minus the first one.
+    e1: [Vec<f32>; 3],
+    /// Third vertex minus the first one.
+    e2: [Vec<f32>; 3],
+    len: usize,
+}
+
+impl TriangleSoa {
+    /// Returns an empty `TriangleSoa`.
+    pub fn new() -> TriangleSoa {
+        TriangleSoa::default()
+    }
+
+    /// Returns a `TriangleSoa` holding `triangles`.
+    pub fn from_triangles(triangles: &[[Vector3; 3]]) -> TriangleSoa {
+        let mut soa = TriangleSoa::new();
+        soa.extend(triangles);
+        soa
+    }
+
+    /// Returns a `TriangleSoa` holding `mesh` triangles, animated vertices are used when
+    /// present.
+    pub fn from_mesh(mesh: impl AsRef<ffi::Mesh>) -> TriangleSoa {
+        let mut triangles = Vec::new();
+        mesh_triangles(mesh.as_ref(), None, &mut triangles);
+        TriangleSoa::from_triangles(&triangles)
+    }
+
+    /// Returns a `TriangleSoa` holding every mesh of `model`, with the model transform applied
+    /// like `get_collision_ray_model` does.
+    pub fn from_model(model: impl AsRef<ffi::Model>) -> TriangleSoa {
+        TriangleSoa::from_triangles(&model_triangles(model.as_ref()))
+    }
+
+    /// Number of triangles.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Appends `triangles`.
+    pub fn extend(&mut self, triangles: &[[Vector3; 3]]) {
+        let padded = round_up_lanes(self.len + triangles.len());
+        for a in self.v0.iter_mut().chain(&mut self.e1).chain(&mut self.e2) {
+            a.truncate(self.len);
+            a.reserve(padded - self.len);
+        }
+
+        for [a, b, c] in triangles {
+            let (e1, e2) = (*b - *a, *c - *a);
+            for (k, (v0, (e1, e2))) in [a.x, a.y, a.z]
+                .iter()
+                .zip([e1.x, e1.y, e1.z].iter().zip([e2.x, e2.y, e2.z].iter()))
+                .enumerate()
+            {
+                self.v0[k].push(*v0);
+                self.e1[k].push(*e1);
+                self.e2[k].push(*e2);
+            }
+        }
+        self.len += triangles.len();
+
+        // Null edges: det is 0, padding triangles are never hit
+        for a in self.v0.iter_mut().chain(&mut self.e1).chain(&mut self.e2) {
+            a.resize(padded, 0.0);
+        }
+    }
+
+    /// Appends a triangle.
+    pub fn push(&mut self, triangle: [Vector3; 3]) {
+        self.extend(&[triangle]);
+    }
+
+    /// Returns triangle `index`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `index` is out of bounds.
+    pub fn get(&self, index: usize) -> [Vector3; 3] {
+        assert!(index < self.len, "index out of bounds");
+        let get = |a: &[Vec<f32>; 3]| Vector3::new(a[0][index], a[1][index], a[2][index]);
+        let (v0, e1, e2) = (get(&self.v0), get(&self.e1), get(&self.e2));
+        [v0, v0 + e1, v0 + e2]
+    }
+
+    pub fn clear(&mut self) {
+        for a in self.v0.iter_mut().chain(&mut self.e1).chain(&mut self.e2) {
+            a.clear();
+        }
+        self.len = 0;
+    }
+
+    /// Gets collision info between ray and the closest triangle, same as
+    /// `get_collision_ray_model`.
+    pub fn raycast(&self, ray: Ray) -> RayHitInfo {
+        self.raycast_triangle(ray)
+            .map_or(RayHitInfo::default(), |(_, hit)| hit)
+    }
+
+    /// Gets collision info between ray and the closest triangle, and its index.
+    pub fn raycast_triangle(&self, ray: Ray) -> Option<(usize, RayHitInfo)> {
+        let (o, d) = (ray.position, ray.direction);
+        // Closest hit seen by each lane, reduced once all triangles are tested
+        let mut closest = [f32::INFINITY; TRIANGLE_LANES];
+        let mut closest_base = [0u32; TRIANGLE_LANES];
+
+        for base in (0..self.v0[0].len()).step_by(TRIANGLE_LANES) {
+            let [v0x, v0y, v0z] = lanes(&self.v0, base);
+            let [e1x, e1y, e1z] = lanes(&self.e1, base);
+            let [e2x, e2y, e2z] = lanes(&self.e2, base);
+
+            // Branchless Möller–Trumbore
+            for k in 0..TRIANGLE_LANES {
+                let px = d.y * e2z[k] - d.z * e2y[k];
+                let py = d.z * e2x[k] - d.x * e2z[k];
+                let pz = d.x * e2y[k] - d.y * e2x[k];
+                let det = e1x[k] * px + e1y[k] * py + e1z[k] * pz;
+                let inv_det = 1.0 / det;
+
+                let sx = o.x - v0x[k];
+                let sy = o.y - v0y[k];
+                let sz = o.z - v0z[k];
+                let u = (sx * px + sy * py + sz * pz) * inv_det;
+
+                let qx = sy * e1z[k] - sz * e1y[k];
+                let qy = sz * e1x[k] - sx * e1z[k];
+                let qz = sx * e1y[k] - sy * e1x[k];
+                let v = (d.x * qx + d.y * qy + d.z * qz) * inv_det;
+                let t = (e2x[k] * qx + e2y[k] * qy + e2z[k] * qz) * inv_det;
+
+                // `&` and not `&&`: short-circuits are branches, which break vectorization
+                let inside = (det.abs() >= RAY_EPSILON)
+                    & (u >= 0.0)
+                    & (v >= 0.0)
+                    & (u + v <= 1.0)
+                    & (t > RAY_EPSILON)
+                    & (t < closest[k]);
+                closest[k] = if inside { t } else { closest[k] };
+                closest_base[k] = if inside { base as u32 } else { closest_base[k] };
+            }
+        }
+
+        let (k, closest) = closest
+            .iter()
+            .enumerate()
+            .fold(
+                (0, f32::INFINITY),
+                |best, (k, t)| {
+                    if *t < best.1 {
+                        (k, *t)
+                    } else {
+                        best
+                    }
+                },
+            );
+        let hit = if closest < f32::INFINITY {
+            Some(closest_base[k] as usize + k)
+        } else {
+            None
+        };
+
+        hit.map(|i| {
+            let [a, b, c] = self.get(i);
+            let hit = RayHitInfo {
+                hit: true,
+                distance: closest,
+                position: o + d * closest,
+                normal: (b - a).cross(c - a).normalized(),
+            };
+            (i, hit)
+        })
+    }
+
+    /// Casts every ray, `out[i]` is overwritten with the closest hit of `rays[i]`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `out` is shorter than `rays`.
+    pub fn raycast_all(&self, rays: &[Ray], out: &mut [RayHitInfo]) {
+        let out = &mut out[..rays.len()];
+        for (o, ray) in out.iter_mut().zip(rays) {
+            *o = self.raycast(*ray);
+        }
+    }
+
+    /// Parallel version of [`TriangleSoa::raycast_all`].
+    pub fn par_raycast_all(&self, rays: &[Ray], out: &mut [RayHitInfo]) {
+        let min_rays = PARALLEL_THRESHOLD / self.len.max(1);
+        par_chunks(&mut out[..rays.len()], min_rays, |offset, out| {
+            self.raycast_all(&rays[offset..offset + out.len()], out)
+        });
+    }
+}
+
+/// `TRIANGLE_LANES` values of the `x`, `y` and `z` arrays from `base`, as arrays so bounds
+/// are checked once.
+#[inline]
+fn lanes(a: &[Vec<f32>; 3], base: usize) -> [&[f32; TRIANGLE_LANES]; 3] {
+    let lane = |k: usize| -> &[f32; TRIANGLE_LANES] {
+        std::convert::TryInto::try_into(&a[k][base..base + TRIANGLE_LANES]).unwrap()
+    };
+    [lane(0), lane(1), lane(2)]
+}
+
+#[inline]
+fn round_up_lanes(len: usize) -> usize {
+    (len + TRIANGLE_LANES - 1) / TRIANGLE_LANES * TRIANGLE_LANES
+}
+
+#[cfg(test)]
+mod math_batch_test {
+    use super::*;
+
+    fn assert_vector3_eq(a: Vector3, b: Vector3) {
+        assert!(
+            (a - b).length() <= 1e-5 * (1.0 + b.length()),
+            "{:?} != {:?}",
+            a,
+            b
+        );
+    }
+
+    fn test_points(n: usize) -> Vec<Vector3> {
+        (0..n)
+            .map(|i| Vector3::new(i as f32 * 0.5, (i % 7) as f32 - 3.0, (i % 13) as f32))
+            .collect()
+    }
+
+    fn test_matrix() -> Matrix {
+        Matrix::rotate(Vector3::new(1.0, 2.0, 3.0).normalized(), 0.7)
+            * Matrix::translate(1.0, -2.0, 3.0)
+    }
+
+    #[test]
+    fn test_transform_points() {
+        let mat = test_matrix();
+        // Above the threshold for the parallel kernels to split
+        let points = test_points(PARALLEL_THRESHOLD * 2 + 3);
+        let expected: Vec<Vector3> = points.iter().map(|p| p.transform_with(mat)).collect();
+
+        let mut out = vec![Vector3::zero(); points.len()];
+        transform_points(&mat, &points, &mut out);
+        out.iter()
+            .zip(&expected)
+            .for_each(|(a, b)| assert_vector3_eq(*a, *b));
+
+        let mut out = vec![Vector3::zero(); points.len()];
+        par_transform_points(&mat, &points, &mut out);
+        out.iter()
+            .zip(&expected)
+            .for_each(|(a, b)| assert_vector3_eq(*a, *b));
+
+        let mut soa = Vec3Soa::from_slice(&points);
+        soa.transform(&mat);
+        soa.to_vec()
+            .iter()
+            .zip(&expected)
+            .for_each(|(a, b)| assert_vector3_eq(*a, *b));
+
+        let mut soa = Vec3Soa::from_slice(&points);
+        soa.par_transform(&mat);
+        soa.to_vec()
+            .iter()
+            .zip(&expected)
+            .for_each(|(a, b)| assert_vector3_eq(*a, *b));
+    }
+
+    #[test]
+    fn test_normalize_lerp() {
+        let a = test_points(PARALLEL_THRESHOLD + 5);
+        let b: Vec<Vector3> = a.iter().map(|v| *v * 2.0 + Vector3::one()).collect();
+
+        let mut normalized = a.clone();
+        par_normalize_all(&mut normalized);
+        let mut soa = Vec3Soa::from_slice(&a);
+        soa.normalize();
+        for (i, v) in a.iter().enumerate() {
+            assert_vector3_eq(normalized[i], v.normalized());
+            assert_vector3_eq(soa.get(i), v.normalized());
+        }
+
+        let mut out = vec![Vector3::zero(); a.len()];
+        par_lerp_all(&a, &b, 0.25, &mut out);
+        let mut soa = Vec3Soa::from_slice(&a);
+        soa.par_lerp(&Vec3Soa::from_slice(&b), 0.25);
+        for (i, v) in a.iter().enumerate() {
+            assert_vector3_eq(out[i], v.lerp(b[i], 0.25));
+            assert_vector3_eq(soa.get(i), v.lerp(b[i], 0.25));
+        }
+    }
+
+    #[test]
+    fn test_quat_slerp_all() {
+        let a: Vec<Quaternion> = (0..100)
+            .map(|i| Quaternion::from_euler(i as f32 * 0.01, 0.2, 0.0))
+            .collect();
+        let b: Vec<Quaternion> = (0..100)
+            .map(|i| Quaternion::from_euler(0.0, i as f32 * 0.03, 1.0))
+            .collect();
+
+        let mut out = vec![Quaternion::identity(); a.len()];
+        par_quat_slerp_all(&a, &b, 0.5, &mut out);
+        for i in 0..a.len() {
+            assert_eq!(out[i], a[i].slerp(b[i], 0.5));
+        }
+    }
+
+    #[test]
+    fn test_mat4_batch() {
+        let a: Vec<Matrix> = (0..10)
+            .map(|i| Matrix::rotate_y(i as f32 * 0.3) * Matrix::translate(i as f32, 1.0, 2.0))
+            .collect();
+        let b: Vec<Matrix> = (0..10)
+            .map(|i| Matrix::scale(1.0, i as f32, 2.0) * Matrix::rotate_x(i as f32))
+            .collect();
+        let mat = test_matrix();
+
+        let batch = Mat4Batch::from_slice(&a);
+        let mut out = Mat4Batch::new();
+        batch.multiply(&Mat4Batch::from_slice(&b), &mut out);
+        let mut scaled = batch.clone();
+        scaled.mul_matrix(&mat);
+
+        for i in 0..a.len() {
+            let (expected, product) = ((a[i] * b[i]).to_array(), out.get(i).to_array());
+            let (expected_mat, scaled) = ((a[i] * mat).to_array(), scaled.get(i).to_array());
+            for k in 0..16 {
+                assert!((expected[k] - product[k]).abs() < 1e-3);
+                assert!((expected_mat[k] - scaled[k]).abs() < 1e-3);
+            }
+        }
+    }
+
+    #[test]
+    fn test_triangle_soa_raycast() {
+        // Bumpy grid, 2 * 30 * 30 triangles: not a multiple of 8 once one is pushed
+        let vertex = |x: usize, z: usize| {
+            let (x, z) = (x as f32, z as f32);
+            Vector3::new(x, (x * 0.7).sin() + (z * 0.3).cos(), z)
+        };
+        let mut triangles = Vec::new();
+        for z in 0..30 {
+            for x in 0..30 {
+                triangles.push([vertex(x, z), vertex(x, z + 1), vertex(x + 1, z)]);
+                triangles.push([vertex(x + 1, z), vertex(x, z + 1), vertex(x + 1, z + 1)]);
+            }
+        }
+        let mut soa = TriangleSoa::from_triangles(&triangles);
+        let roof = [
+            Vector3::new(10.0, 5.0, 10.0),
+            Vector3::new(10.0, 5.0, 12.0),
+            Vector3::new(12.0, 5.0, 10.0),
+        ];
+        soa.push(roof);
+        triangles.push(roof);
+        assert_eq!(soa.len(), triangles.len());
+        assert_eq!(soa.get(soa.len() - 1), roof);
+
+        let rays: Vec<Ray> = (0..300)
+            .map(|i| {
+                let f = i as f32;
+                Ray {
+                    position: Vector3::new((f * 7.3) % 30.0, 10.0, (f * 3.1) % 30.0),
+                    direction: Vector3::new((f * 0.37).sin() * 0.5, -1.0, (f * 0.11).cos() * 0.5),
+                }
+            })
+            .collect();
+        let bvh = crate::core::bvh::MeshBvh::from_triangles(&triangles);
+
+        let mut out = vec![RayHitInfo::default(); rays.len()];
+        let mut par_out = vec![RayHitInfo::default(); rays.len()];
+        soa.raycast_all(&rays, &mut out);
+        soa.par_raycast_all(&rays, &mut par_out);
+        assert_eq!(out, par_out);
+
+        let mut hits = 0;
+        for (ray, hit) in rays.iter().zip(&out) {
+            let expected = bvh.raycast(*ray);
+            assert_eq!(hit.hit, expected.hit, "{:?}", ray);
+            if hit.hit {
+                hits += 1;
+                assert!((hit.distance - expected.distance).abs() < 1e-4);
+                assert_vector3_eq(hit.position, expected.position);
+                assert_vector3_eq(hit.normal, expected.normal);
+            }
+        }
+        assert!(hits > rays.len() / 2);
+
+        let (index, _) = soa
+            .raycast_triangle(Ray {
+                position: Vector3::new(10.5, 20.0, 10.5),
+                direction: Vector3::new(0.0, -1.0, 0.0),
+            })
+            .unwrap();
+        assert_eq!(index, triangles.len() - 1);
+
+        soa.clear();
+        assert!(soa.is_empty());
+        assert!(!soa.raycast(rays[0]).hit);
+    }
+}
@@ -1,5 +1,6 @@
 //! Useful functions that don't fit anywhere else
-use crate::core::texture::Image;
+use crate::core::file::lock_static_buffers;
+use crate::core::texture::{Image, FORMAT_R8G8B8A8};
 use crate::core::{RaylibHandle, RaylibThread};
 use crate::ffi;
 use std::ffi::CString;
@@ -28,6 +29,55 @@ pub fn open_url(url: &str) {
     }
 }
 
+make_thin_wrapper!(
+    ScreenCapture,
+    ffi::ScreenCapture,
+    ffi::rlUnloadScreenCapture
+);
+
+impl ScreenCapture {
+    pub fn width(&self) -> i32 {
+        self.0.width
+    }
+
+    pub fn height(&self) -> i32 {
+        self.0.height
+    }
+
+    /// Returns true once the pixels can be read without waiting for the GPU.
+    pub fn is_ready(&self) -> bool {
+        unsafe { ffi::rlIsScreenCaptureReady(self.0) }
+    }
+
+    /// Returns the captured image if ready, gives the capture back otherwise.
+    /// The image is `None` if the pixels could not be read back, see `into_image`.
+    pub fn try_into_image(self) -> Result<Option<Image>, ScreenCapture> {
+        if self.is_ready() {
+            Ok(self.into_image())
+        } else {
+            Err(self)
+        }
+    }
+
+    /// Returns the captured image like `get_screen_data` would have, waiting for the GPU if
+    /// the pixels are not ready yet. Returns `None` if the pixels could not be read back, e.g. the
+    /// pixel buffer failed to map, so a failed capture is not mistaken for a black frame.
+    pub fn into_image(self) -> Option<Image> {
+        let mut capture = unsafe { self.unwrap() };
+        let data = unsafe { ffi::rlGetScreenCapturePixels(&mut capture) };
+        if data.is_null() {
+            return None;
+        }
+        Some(Image(ffi::Image {
+            data: data as *mut _,
+            width: capture.width,
+            height: capture.height,
+            mipmaps: 1,
+            format: FORMAT_R8G8B8A8,
+        }))
+    }
+}
+
 impl RaylibHandle {
     pub fn get_screen_data(&mut self, _: &RaylibThread) -> Image {
         unsafe { Image(ffi::GetScreenData()) }
@@ -36,10 +86,25 @@ impl RaylibHandle {
     /// Takes a screenshot of current screen (saved a .png)
     pub fn take_screenshot(&mut self, _: &RaylibThread, filename: &str) {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe {
             ffi::TakeScreenshot(c_filename.as_ptr());
         }
     }
+
+    /// Starts reading the screen pixels without waiting for the GPU to render them.
+    /// Keep the capture a frame or two, until `is_ready`, then take the image with
+    /// `try_into_image` or `into_image`: the read does not stall the frame.
+    /// Without pixel buffer objects (OpenGL 1.1, ES2) pixels are read right away.
+    ///
+    /// The capture covers `get_screen_width` x `get_screen_height` pixels from the bottom left
+    /// corner, while `get_screen_data` reads the whole render size. Both match unless the
+    /// framebuffer is scaled, e.g. on high-DPI displays or in a fullscreen mode of another size,
+    /// where only part of the screen is captured. raylib 3.7 does not expose the render size.
+    pub fn capture_screen_async(&mut self, _: &RaylibThread) -> ScreenCapture {
+        let (width, height) = (self.get_screen_width(), self.get_screen_height());
+        unsafe { ScreenCapture(ffi::rlReadScreenPixelsAsync(width, height)) }
+    }
 }
 
 // lossy conversion to an f32
@@ -1,25 +1,39 @@
 #[macro_use]
 mod macros;
 
+pub mod archive;
 pub mod audio;
+pub mod batch;
+pub mod broadphase;
+pub mod bvh;
 pub mod camera;
 pub mod collision;
 pub mod color;
 pub mod data;
 pub mod drawing;
+pub mod encoder;
 pub mod file;
+pub mod frustum;
+pub mod image_ops;
 pub mod input;
+pub mod loader;
 pub mod logging;
+pub mod mapped;
 pub mod math;
+pub mod math_batch;
 pub mod misc;
 pub mod models;
+pub mod recorder;
+pub mod resample;
 pub mod shaders;
+mod simd;
 pub mod text;
 pub mod texture;
 pub mod vr;
 pub mod window;
 
 use crate::ffi;
+#[cfg(not(feature = "null_backend"))]
 use std::ffi::CString;
 use std::marker::PhantomData;
 use std::sync::atomic::{AtomicBool, Ordering};
@@ -43,6 +57,16 @@ macro_rules! rstr {
 
 static IS_INITIALIZED: AtomicBool = AtomicBool::new(false);
 
+/// Serializes tests creating a `RaylibHandle`: only one may exist at a time, while tests run on
+/// several threads.
+#[cfg(all(test, feature = "null_backend"))]
+pub(crate) fn test_window_lock() -> std::sync::MutexGuard<'static, ()> {
+    lazy_static::lazy_static! {
+        static ref WINDOW: std::sync::Mutex<()> = std::sync::Mutex::new(());
+    }
+    WINDOW.lock().unwrap_or_else(|e| e.into_inner())
+}
+
 /// This token is used to ensure certain functions are only running on the same
 /// thread raylib was initialized from. This is useful for architectures like macos
 /// where cocoa can only be called from one thread.
@@ -62,9 +86,15 @@ pub struct RaylibHandle(()); // inner field is private, preventing manual constr
 impl Drop for RaylibHandle {
     fn drop(&mut self) {
         if IS_INITIALIZED.load(Ordering::Relaxed) {
+            #[cfg(not(feature = "null_backend"))]
             unsafe {
                 ffi::CloseWindow();
             }
+            #[cfg(feature = "null_backend")]
+            unsafe {
+                ffi::UnloadFontDefault();
+                ffi::rlglClose();
+            }
             IS_INITIALIZED.store(false, Ordering::Relaxed);
         }
     }
@@ -196,6 +226,7 @@ impl RaylibBuilder {
 /// # Panics
 ///
 /// Attempting to initialize Raylib more than once will result in a panic.
+#[cfg(not(feature = "null_backend"))]
 fn init_window(width: i32, height: i32, title: &str) -> RaylibHandle {
     if IS_INITIALIZED.load(Ordering::Relaxed) {
         panic!("Attempted to initialize raylib-rs more than once!");
@@ -211,3 +242,35 @@ fn init_window(width: i32, height: i32, title: &str) -> RaylibHandle {
         RaylibHandle(())
     }
 }
+
+/// Initializes rlgl on the null backend, OpenGL calls are recorded instead of issued.
+/// No window is opened: window, input and timing functions are not available,
+/// draws go through the render batch as usual.
+///
+/// # Panics
+///
+/// Attempting to initialize Raylib more than once will result in a panic.
+#[cfg(feature = "null_backend")]
+fn init_window(width: i32, height: i32, _title: &str) -> RaylibHandle {
+    if IS_INITIALIZED.load(Ordering::Relaxed) {
+        panic!("Attempted to initialize raylib-rs more than once!");
+    } else {
+        unsafe {
+            // Loader is ignored, null backend functions are loaded
+            ffi::rlLoadExtensions(ffi::rlNullGetProcAddress as *mut std::os::raw::c_void);
+            ffi::rlglInit(width, height);
+
+            // Same default 2D projection as InitWindow()
+            ffi::rlViewport(0, 0, width, height);
+            ffi::rlMatrixMode(ffi::RL_PROJECTION as i32);
+            ffi::rlLoadIdentity();
+            ffi::rlOrtho(0.0, width as f64, height as f64, 0.0, 0.0, 1.0);
+            ffi::rlMatrixMode(ffi::RL_MODELVIEW as i32);
+            ffi::rlLoadIdentity();
+
+            ffi::LoadFontDefault();
+        }
+        IS_INITIALIZED.store(true, Ordering::Relaxed);
+        RaylibHandle(())
+    }
+}
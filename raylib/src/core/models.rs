@@ -1,5 +1,7 @@
 //! 3D Model, Mesh, and Animation
-use crate::core::math::{BoundingBox, Vector3};
+use crate::core::color::Color;
+use crate::core::file::lock_static_buffers;
+use crate::core::math::{BoundingBox, Vector2, Vector3};
 use crate::core::texture::Image;
 use crate::core::{RaylibHandle, RaylibThread};
 use crate::ffi;
@@ -54,6 +56,7 @@ impl RaylibHandle {
     // #[inline]
     pub fn load_model(&mut self, _: &RaylibThread, filename: &str) -> Result<Model, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let m = unsafe { ffi::LoadModel(c_filename.as_ptr()) };
         if m.meshes.is_null() && m.materials.is_null() && m.bones.is_null() && m.bindPose.is_null()
         {
@@ -78,6 +81,42 @@ impl RaylibHandle {
         Ok(Model(m))
     }
 
+    /// Uploads mesh vertex data built on the CPU, see [`MeshData`].
+    pub fn load_mesh_from_data(
+        &mut self,
+        thread: &RaylibThread,
+        data: &MeshData,
+    ) -> Result<Mesh, String> {
+        self.load_mesh_from_view(thread, &data.view())
+    }
+
+    /// Uploads borrowed mesh vertex data, e.g. from a [`MappedFile`](crate::core::mapped::MappedFile).
+    /// Meshes keep a CPU copy raylib frees on unload, so the data is copied once.
+    pub fn load_mesh_from_view(
+        &mut self,
+        _: &RaylibThread,
+        view: &MeshView,
+    ) -> Result<Mesh, String> {
+        view.validate()?;
+        let triangles = if view.indices.is_empty() {
+            view.vertices.len() / 3
+        } else {
+            view.indices.len() / 3
+        };
+        unsafe {
+            let mut mesh: ffi::Mesh = std::mem::zeroed();
+            mesh.vertexCount = view.vertices.len() as i32;
+            mesh.triangleCount = triangles as i32;
+            mesh.vertices = raylib_copy(view.vertices);
+            mesh.texcoords = raylib_copy(view.texcoords);
+            mesh.normals = raylib_copy(view.normals);
+            mesh.colors = raylib_copy(view.colors);
+            mesh.indices = raylib_copy(view.indices);
+            ffi::UploadMesh(&mut mesh, false);
+            Ok(Mesh(mesh))
+        }
+    }
+
     pub fn load_model_animations(
         &mut self,
         _: &RaylibThread,
@@ -85,6 +124,7 @@ impl RaylibHandle {
     ) -> Result<Vec<ModelAnimation>, String> {
         let c_filename = CString::new(filename).unwrap();
         let mut m_size = 0;
+        let _lock = lock_static_buffers();
         let m_ptr = unsafe { ffi::LoadModelAnimations(c_filename.as_ptr(), &mut m_size) };
         if m_size <= 0 {
             return Err(format!("No model animations loaded from {}", filename));
@@ -222,6 +262,102 @@ impl Mesh {
         m
     }
 }
+
+/// Mesh vertex data in CPU memory, turned into a [`Mesh`] with
+/// [`RaylibHandle::load_mesh_from_data`].
+///
+/// Unlike `Mesh`, which owns GPU buffers, it is `Send`: meshes can be built or parsed on worker
+/// threads and only uploaded on the main thread. Attributes other than `vertices` are either
+/// empty or hold one value per vertex. Without `indices`, every 3 vertices are a triangle.
+#[derive(Debug, Default, Clone, PartialEq)]
+pub struct MeshData {
+    pub vertices: Vec<Vector3>,
+    pub texcoords: Vec<Vector2>,
+    pub normals: Vec<Vector3>,
+    pub colors: Vec<Color>,
+    pub indices: Vec<u16>,
+}
+
+impl MeshData {
+    /// Size of the vertex data in bytes.
+    pub fn size_bytes(&self) -> usize {
+        self.view().size_bytes()
+    }
+
+    pub fn view(&self) -> MeshView<'_> {
+        MeshView {
+            vertices: &self.vertices,
+            texcoords: &self.texcoords,
+            normals: &self.normals,
+            colors: &self.colors,
+            indices: &self.indices,
+        }
+    }
+}
+
+/// Borrowed mesh vertex data, laid out like [`MeshData`].
+#[derive(Debug, Default, Copy, Clone, PartialEq)]
+pub struct MeshView<'a> {
+    pub vertices: &'a [Vector3],
+    pub texcoords: &'a [Vector2],
+    pub normals: &'a [Vector3],
+    pub colors: &'a [Color],
+    pub indices: &'a [u16],
+}
+
+impl<'a> MeshView<'a> {
+    /// Size of the vertex data in bytes.
+    pub fn size_bytes(&self) -> usize {
+        use std::mem::size_of_val;
+        size_of_val(self.vertices)
+            + size_of_val(self.texcoords)
+            + size_of_val(self.normals)
+            + size_of_val(self.colors)
+            + size_of_val(self.indices)
+    }
+
+    fn validate(&self) -> Result<(), String> {
+        let count = self.vertices.len();
+        if count == 0 {
+            return Err(format!("invalid mesh vertex count {}", count));
+        }
+        for (name, len) in [
+            ("texcoords", self.texcoords.len()),
+            ("normals", self.normals.len()),
+            ("colors", self.colors.len()),
+        ]
+        .iter()
+        {
+            if *len != 0 && *len != count {
+                return Err(format!("mesh has {} {} for {} vertices", len, name, count));
+            }
+        }
+        if self.indices.is_empty() && count % 3 != 0 {
+            return Err(format!(
+                "mesh vertex count {} is not a multiple of 3",
+                count
+            ));
+        }
+        if self.indices.len() % 3 != 0 || self.indices.iter().any(|i| *i as usize >= count) {
+            return Err("invalid mesh indices".to_owned());
+        }
+        Ok(())
+    }
+}
+
+/// Copies `items` into memory raylib frees on unload, null if empty.
+fn raylib_copy<T: Copy, U>(items: &[T]) -> *mut U {
+    if items.is_empty() {
+        return std::ptr::null_mut();
+    }
+    unsafe {
+        let size = std::mem::size_of_val(items);
+        let data = ffi::MemAlloc(size as i32);
+        std::ptr::copy_nonoverlapping(items.as_ptr() as *const u8, data as *mut u8, size);
+        data as *mut U
+    }
+}
+
 pub trait RaylibMesh: AsRef<ffi::Mesh> + AsMut<ffi::Mesh> {
     fn vertices(&self) -> &[Vector3] {
         unsafe {
@@ -399,6 +535,7 @@ pub trait RaylibMesh: AsRef<ffi::Mesh> + AsMut<ffi::Mesh> {
     #[inline]
     fn export_mesh(&self, filename: &str) {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe {
             ffi::ExportMesh(*self.as_ref(), c_filename.as_ptr());
         }
@@ -415,6 +552,7 @@ impl Material {
     pub fn load_materials(filename: &str) -> Result<Vec<Material>, String> {
         let c_filename = CString::new(filename).unwrap();
         let mut m_size = 0;
+        let _lock = lock_static_buffers();
         let m_ptr = unsafe { ffi::LoadMaterials(c_filename.as_ptr(), &mut m_size) };
         if m_size <= 0 {
             return Err(format!("No materials loaded from {}", filename));
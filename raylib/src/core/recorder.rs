@@ -0,0 +1,484 @@
+//! Frame recording: screen captures encoded to image files on worker threads
+use crate::core::file::lock_static_buffers;
+use crate::core::misc::ScreenCapture;
+use crate::core::{RaylibHandle, RaylibThread};
+use crate::ffi;
+use std::cell::UnsafeCell;
+use std::collections::VecDeque;
+use std::ffi::CString;
+use std::mem::MaybeUninit;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::sync::Arc;
+use std::thread::{self, JoinHandle};
+use std::time::Duration;
+
+struct Slot<T> {
+    /// Position the slot is ready for: `pos` to push, `pos + 1` to pop.
+    sequence: AtomicUsize,
+    value: UnsafeCell<MaybeUninit<T>>,
+}
+
+/// Bounded lock-free multi-producer multi-consumer queue.
+///
+/// `push` fails instead of waiting when the queue is full and `pop` when it is empty, so
+/// neither side ever blocks the other.
+pub struct BoundedQueue<T> {
+    slots: Box<[Slot<T>]>,
+    mask: usize,
+    head: AtomicUsize,
+    tail: AtomicUsize,
+}
+
+unsafe impl<T: Send> Send for BoundedQueue<T> {}
+unsafe impl<T: Send> Sync for BoundedQueue<T> {}
+
+impl<T> BoundedQueue<T> {
+    /// Creates a queue of `capacity` elements, rounded up to a power of two.
+    pub fn new(capacity: usize) -> BoundedQueue<T> {
+        let capacity = capacity.max(1).next_power_of_two();
+        BoundedQueue {
+            slots: (0..capacity)
+                .map(|i| Slot {
+                    sequence: AtomicUsize::new(i),
+                    value: UnsafeCell::new(MaybeUninit::uninit()),
+                })
+                .collect(),
+            mask: capacity - 1,
+            head: AtomicUsize::new(0),
+            tail: AtomicUsize::new(0),
+        }
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.slots.len()
+    }
+
+    /// Number of queued elements, may be outdated as soon as returned.
+    pub fn len(&self) -> usize {
+        let tail = self.tail.load(Ordering::Acquire);
+        let head = self.head.load(Ordering::Acquire);
+        tail.wrapping_sub(head).min(self.capacity())
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Appends `value`, or gives it back if the queue is full.
+    pub fn push(&self, value: T) -> Result<(), T> {
+        let mut pos = self.tail.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let sequence = slot.sequence.load(Ordering::Acquire);
+            let diff = sequence as isize - pos as isize;
+            if diff == 0 {
+                match self.tail.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        unsafe { (*slot.value.get()).as_mut_ptr().write(value) };
+                        slot.sequence.store(pos + 1, Ordering::Release);
+                        return Ok(());
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if diff < 0 {
+                // Slot not popped yet since the previous lap
+                return Err(value);
+            } else {
+                pos = self.tail.load(Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// Removes the oldest element, `None` if the queue is empty.
+    pub fn pop(&self) -> Option<T> {
+        let mut pos = self.head.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let sequence = slot.sequence.load(Ordering::Acquire);
+            let diff = sequence as isize - (pos + 1) as isize;
+            if diff == 0 {
+                match self.head.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        let value = unsafe { (*slot.value.get()).as_ptr().read() };
+                        slot.sequence.store(pos + self.mask + 1, Ordering::Release);
+                        return Some(value);
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if diff < 0 {
+                return None;
+            } else {
+                pos = self.head.load(Ordering::Relaxed);
+            }
+        }
+    }
+}
+
+impl<T> Drop for BoundedQueue<T> {
+    fn drop(&mut self) {
+        while self.pop().is_some() {}
+    }
+}
+
+impl<T> std::fmt::Debug for BoundedQueue<T> {
+    fn fmt(&self, f: &mut std::fmt::Formatter) -> std::fmt::Result {
+        f.debug_struct("BoundedQueue")
+            .field("capacity", &self.capacity())
+            .field("len", &self.len())
+            .finish()
+    }
+}
+
+/// Image file format of recorded frames, encoded by `ExportImage`.
+#[derive(Debug, Copy, Clone, PartialEq, Eq, Hash)]
+pub enum FrameFormat {
+    Png,
+    /// Uncompressed, much faster to encode than PNG, larger files.
+    Tga,
+    Bmp,
+}
+
+impl FrameFormat {
+    fn extension(self) -> &'static str {
+        match self {
+            FrameFormat::Png => "png",
+            FrameFormat::Tga => "tga",
+            FrameFormat::Bmp => "bmp",
+        }
+    }
+}
+
+/// Frame read back from the GPU, pixels allocated by rlgl.
+struct Frame {
+    index: u64,
+    image: ffi::Image,
+}
+
+// Pixels are owned by the frame, moved to a single worker
+unsafe impl Send for Frame {}
+
+impl Drop for Frame {
+    fn drop(&mut self) {
+        unsafe { ffi::UnloadImage(self.image) }
+    }
+}
+
+#[derive(Debug)]
+struct Shared {
+    queue: BoundedQueue<Frame>,
+    closing: AtomicBool,
+    encoded: AtomicU64,
+    failed: AtomicU64,
+}
+
+/// Frames counters of a [`FrameRecorder`].
+#[derive(Debug, Default, Copy, Clone, PartialEq, Eq)]
+pub struct RecorderStats {
+    /// Frames submitted to `record_frame`.
+    pub frames: u64,
+    /// Frames written to disk.
+    pub encoded: u64,
+    /// Frames skipped because the encoders fell behind.
+    pub dropped: u64,
+    /// Frames that could not be read back, or that `ExportImage` could not write.
+    pub failed: u64,
+    /// Frames read back or being encoded.
+    pub in_flight: u64,
+}
+
+/// Records the screen as a numbered image sequence, without stalling the render thread.
+///
+/// Every recorded frame is read back asynchronously (see
+/// [`RaylibHandle::capture_screen_async`]), then handed through a [`BoundedQueue`] to worker
+/// threads that encode it. When the queue is full the frame is dropped and counted instead
+/// of waiting for the encoders: file names keep the frame index, so drops show as gaps.
+/// Only `glReadPixels` is required, it works under software GL contexts too.
+///
+/// `ExportImage` uses raylib's static text buffers, so encoders hold the crate wide file lock
+/// while writing a frame and never encode two frames at once, nor while another thread loads
+/// or exports a file through raylib. Extra workers only add queued frames in flight.
+#[derive(Debug)]
+pub struct FrameRecorder {
+    directory: PathBuf,
+    format: FrameFormat,
+    shared: Arc<Shared>,
+    workers: Vec<JoinHandle<()>>,
+    pending: VecDeque<(u64, ScreenCapture)>,
+    frames: u64,
+    dropped: u64,
+}
+
+impl FrameRecorder {
+    /// Maximum captures waiting for the GPU, older ones are waited for past it.
+    const MAX_PENDING: usize = 3;
+
+    /// Creates a recorder writing `frame_NNNNNN` files into `directory`, created if missing,
+    /// with a single encoder and a queue of 8 frames.
+    pub fn new(directory: impl AsRef<Path>, format: FrameFormat) -> std::io::Result<FrameRecorder> {
+        FrameRecorder::with_workers(directory, format, 1, 8)
+    }
+
+    /// Creates a recorder with `workers` encoder threads and a queue of `queue_capacity`
+    /// frames (rounded up to a power of two) between them and the render thread.
+    pub fn with_workers(
+        directory: impl AsRef<Path>,
+        format: FrameFormat,
+        workers: usize,
+        queue_capacity: usize,
+    ) -> std::io::Result<FrameRecorder> {
+        let directory = directory.as_ref().to_path_buf();
+        std::fs::create_dir_all(&directory)?;
+
+        let shared = Arc::new(Shared {
+            queue: BoundedQueue::new(queue_capacity),
+            closing: AtomicBool::new(false),
+            encoded: AtomicU64::new(0),
+            failed: AtomicU64::new(0),
+        });
+        let workers = (0..workers.max(1))
+            .map(|i| {
+                let shared = shared.clone();
+                let directory = directory.clone();
+                thread::Builder::new()
+                    .name(format!("frame encoder {}", i))
+                    .spawn(move || encode_frames(&shared, &directory, format))
+            })
+            .collect::<std::io::Result<_>>()?;
+
+        Ok(FrameRecorder {
+            directory,
+            format,
+            shared,
+            workers,
+            pending: VecDeque::new(),
+            frames: 0,
+            dropped: 0,
+        })
+    }
+
+    pub fn directory(&self) -> &Path {
+        &self.directory
+    }
+
+    pub fn format(&self) -> FrameFormat {
+        self.format
+    }
+
+    /// Path of the file frame `index` is written to.
+    pub fn frame_path(&self, index: u64) -> PathBuf {
+        frame_path(&self.directory, self.format, index)
+    }
+
+    /// Records the last frame drawn, call it after `end_drawing` (the drawing handle dropped).
+    /// Returns the frame index, `None` if the frame is dropped.
+    pub fn record_frame(&mut self, rl: &mut RaylibHandle, thread: &RaylibThread) -> Option<u64> {
+        self.queue_ready(false);
+
+        let index = self.frames;
+        self.frames += 1;
+        // Reading back a frame the encoders have no room for would only cost GPU time
+        let room = self.shared.queue.capacity() - self.shared.queue.len();
+        if room <= self.pending.len() {
+            self.dropped += 1;
+            return None;
+        }
+
+        self.pending
+            .push_back((index, rl.capture_screen_async(thread)));
+        if self.pending.len() > Self::MAX_PENDING {
+            let (index, capture) = self.pending.pop_front().unwrap();
+            self.queue_frame(index, capture, false);
+        }
+        Some(index)
+    }
+
+    /// Queues read back frames. If `wait`, waits for the GPU and for room in the queue, so
+    /// every frame is queued.
+    fn queue_ready(&mut self, wait: bool) {
+        while let Some((index, capture)) = self.pending.pop_front() {
+            if !wait && !capture.is_ready() {
+                self.pending.push_front((index, capture));
+                break;
+            }
+            self.queue_frame(index, capture, wait);
+        }
+    }
+
+    fn queue_frame(&mut self, index: u64, capture: ScreenCapture, wait: bool) {
+        let image = match capture.into_image() {
+            Some(image) => unsafe { image.unwrap() },
+            None => {
+                self.shared.failed.fetch_add(1, Ordering::AcqRel);
+                return;
+            }
+        };
+        let mut frame = Frame { index, image };
+        loop {
+            match self.shared.queue.push(frame) {
+                Ok(()) => break,
+                Err(_) if !wait => {
+                    self.dropped += 1;
+                    return;
+                }
+                Err(f) => {
+                    frame = f;
+                    thread::sleep(Duration::from_millis(1));
+                }
+            }
+        }
+        self.workers.iter().for_each(|w| w.thread().unpark());
+    }
+
+    pub fn stats(&self) -> RecorderStats {
+        let encoded = self.shared.encoded.load(Ordering::Acquire);
+        let failed = self.shared.failed.load(Ordering::Acquire);
+        RecorderStats {
+            frames: self.frames,
+            encoded,
+            dropped: self.dropped,
+            failed,
+            in_flight: self.frames - self.dropped - encoded - failed,
+        }
+    }
+
+    /// Frames skipped because the encoders fell behind.
+    pub fn dropped_frames(&self) -> u64 {
+        self.dropped
+    }
+
+    /// Waits for every recorded frame to be written and stops the encoders.
+    pub fn finish(mut self) -> RecorderStats {
+        self.stop();
+        self.stats()
+    }
+
+    fn stop(&mut self) {
+        self.queue_ready(true);
+        self.shared.closing.store(true, Ordering::Release);
+        for worker in self.workers.drain(..) {
+            worker.thread().unpark();
+            let _ = worker.join();
+        }
+    }
+}
+
+impl Drop for FrameRecorder {
+    fn drop(&mut self) {
+        self.stop();
+    }
+}
+
+fn frame_path(directory: &Path, format: FrameFormat, index: u64) -> PathBuf {
+    directory.join(format!("frame_{:06}.{}", index, format.extension()))
+}
+
+/// Encoder thread: encodes queued frames until the recorder closes and the queue is empty.
+fn encode_frames(shared: &Shared, directory: &Path, format: FrameFormat) {
+    loop {
+        let frame = match shared.queue.pop() {
+            Some(frame) => frame,
+            None if shared.closing.load(Ordering::Acquire) => return,
+            None => {
+                // Unparked on push, the timeout covers a push racing with the park
+                thread::park_timeout(Duration::from_millis(10));
+                continue;
+            }
+        };
+
+        let path = frame_path(directory, format, frame.index);
+        let written = match CString::new(path.to_string_lossy().as_bytes()) {
+            Ok(path) if !frame.image.data.is_null() => {
+                let _lock = lock_static_buffers();
+                unsafe { ffi::ExportImage(frame.image, path.as_ptr()) }
+            }
+            Ok(_) => false,
+            Err(_) => false,
+        };
+        let counter = if written {
+            &shared.encoded
+        } else {
+            &shared.failed
+        };
+        counter.fetch_add(1, Ordering::AcqRel);
+    }
+}
+
+#[cfg(test)]
+mod recorder_test {
+    use super::*;
+
+    #[test]
+    fn test_bounded_queue() {
+        let queue = BoundedQueue::new(3);
+        assert_eq!(queue.capacity(), 4);
+        assert_eq!(queue.pop(), None);
+        for i in 0..4 {
+            assert_eq!(queue.push(i), Ok(()));
+        }
+        assert_eq!(queue.push(4), Err(4));
+        assert_eq!(queue.len(), 4);
+        assert_eq!(queue.pop(), Some(0));
+        assert_eq!(queue.push(4), Ok(()));
+        assert_eq!(
+            (1..5).map(|_| queue.pop().unwrap()).collect::<Vec<_>>(),
+            [1, 2, 3, 4]
+        );
+        assert!(queue.is_empty());
+
+        // Queued values are dropped with the queue
+        let value = Arc::new(());
+        let queue = BoundedQueue::new(2);
+        queue.push(value.clone()).unwrap();
+        drop(queue);
+        assert_eq!(Arc::strong_count(&value), 1);
+    }
+
+    #[test]
+    fn test_bounded_queue_threads() {
+        const PER_PRODUCER: u64 = 20_000;
+        let queue = BoundedQueue::new(64);
+        let sum = AtomicU64::new(0);
+        let popped = AtomicU64::new(0);
+        thread::scope(|scope| {
+            for p in 0..3 {
+                let queue = &queue;
+                scope.spawn(move || {
+                    for i in 0..PER_PRODUCER {
+                        let mut value = p * PER_PRODUCER + i;
+                        while let Err(v) = queue.push(value) {
+                            value = v;
+                            thread::yield_now();
+                        }
+                    }
+                });
+            }
+            for _ in 0..2 {
+                scope.spawn(|| {
+                    while popped.load(Ordering::Acquire) < 3 * PER_PRODUCER {
+                        match queue.pop() {
+                            Some(v) => {
+                                sum.fetch_add(v, Ordering::AcqRel);
+                                popped.fetch_add(1, Ordering::AcqRel);
+                            }
+                            None => thread::yield_now(),
+                        }
+                    }
+                });
+            }
+        });
+        let n = 3 * PER_PRODUCER;
+        assert_eq!(sum.into_inner(), n * (n - 1) / 2);
+        assert!(queue.is_empty());
+    }
+}
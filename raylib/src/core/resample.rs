@@ -0,0 +1,328 @@
+//! Separable image resampling with selectable filters and cached weight tables
+use crate::core::color::Color;
+use crate::core::math_batch::{par_chunks, PARALLEL_THRESHOLD};
+use std::collections::HashMap;
+use std::sync::Arc;
+
+/// Reconstruction filter of a [`Resampler`].
+#[derive(Debug, Copy, Clone, PartialEq, Eq, Hash)]
+pub enum ResampleFilter {
+    /// Average of the covered pixels, sharp and blocky when upscaling.
+    Box,
+    /// Triangle filter, bilinear interpolation when upscaling.
+    Bilinear,
+    /// Catmull-Rom cubic, sharper than bilinear.
+    Bicubic,
+    /// Windowed sinc over 3 lobes, the sharpest, may ring on hard edges.
+    Lanczos3,
+}
+
+impl ResampleFilter {
+    /// Radius of the filter, in source pixels when not downscaling.
+    fn support(self) -> f32 {
+        match self {
+            ResampleFilter::Box => 0.5,
+            ResampleFilter::Bilinear => 1.0,
+            ResampleFilter::Bicubic => 2.0,
+            ResampleFilter::Lanczos3 => 3.0,
+        }
+    }
+
+    fn weight(self, x: f32) -> f32 {
+        let x = x.abs();
+        match self {
+            ResampleFilter::Box => (x < 0.5) as u8 as f32,
+            ResampleFilter::Bilinear => (1.0 - x).max(0.0),
+            ResampleFilter::Bicubic => {
+                // Keys cubic with a = -0.5
+                if x < 1.0 {
+                    (1.5 * x - 2.5) * x * x + 1.0
+                } else if x < 2.0 {
+                    ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0
+                } else {
+                    0.0
+                }
+            }
+            ResampleFilter::Lanczos3 => {
+                if x < 3.0 {
+                    sinc(x) * sinc(x / 3.0)
+                } else {
+                    0.0
+                }
+            }
+        }
+    }
+}
+
+fn sinc(x: f32) -> f32 {
+    if x == 0.0 {
+        1.0
+    } else {
+        let x = x * std::f32::consts::PI;
+        x.sin() / x
+    }
+}
+
+/// Weights of one axis: output pixel `i` is the sum of `taps` source pixels from `starts[i]`,
+/// weighted by `coeffs[i * taps..][..taps]`. Every output has the same tap count, shorter
+/// filters are padded with zeros, so the inner loops have a fixed length.
+#[derive(Debug)]
+struct Weights {
+    starts: Vec<u32>,
+    coeffs: Vec<f32>,
+    taps: usize,
+}
+
+impl Weights {
+    fn new(filter: ResampleFilter, src: usize, dst: usize) -> Weights {
+        // Downscaling widens the filter to cover every source pixel
+        let scale = dst as f32 / src as f32;
+        let filter_scale = scale.min(1.0);
+        let support = filter.support() / filter_scale;
+        let taps = ((support * 2.0).ceil() as usize + 1).min(src);
+
+        let mut weights = Weights {
+            starts: Vec::with_capacity(dst),
+            coeffs: vec![0.0; dst * taps],
+            taps,
+        };
+        for i in 0..dst {
+            let center = (i as f32 + 0.5) / scale;
+            let first = ((center - support).floor().max(0.0) as usize).min(src - taps);
+            let coeffs = &mut weights.coeffs[i * taps..][..taps];
+            for (k, c) in coeffs.iter_mut().enumerate() {
+                let x = (first + k) as f32 + 0.5 - center;
+                *c = filter.weight(x * filter_scale);
+            }
+
+            let sum: f32 = coeffs.iter().sum();
+            if sum != 0.0 {
+                coeffs.iter_mut().for_each(|c| *c /= sum);
+            } else {
+                // Box filter between two pixels: nearest one
+                let nearest = (center as usize).min(src - 1) - first;
+                coeffs[nearest.min(taps - 1)] = 1.0;
+            }
+            weights.starts.push(first as u32);
+        }
+        weights
+    }
+}
+
+/// Image resampler: box, bilinear, bicubic or Lanczos3 filtering, separable, row parallel.
+///
+/// Weight tables are computed once per filter and source/destination size pair and cached,
+/// keep one resampler to resize many images of the same sizes (e.g. thumbnails). Channels
+/// are filtered independently, alpha is not premultiplied.
+#[derive(Debug, Clone)]
+pub struct Resampler {
+    filter: ResampleFilter,
+    cache: HashMap<(usize, usize), Arc<Weights>>,
+    /// Horizontally resampled rows, as 4 `f32` per pixel.
+    scratch: Vec<f32>,
+}
+
+impl Resampler {
+    pub fn new(filter: ResampleFilter) -> Resampler {
+        Resampler {
+            filter,
+            cache: HashMap::new(),
+            scratch: Vec::new(),
+        }
+    }
+
+    pub fn filter(&self) -> ResampleFilter {
+        self.filter
+    }
+
+    /// Number of cached weight tables, one per axis size pair.
+    pub fn cached_tables(&self) -> usize {
+        self.cache.len()
+    }
+
+    /// Releases the cached weight tables and the scratch buffer.
+    pub fn clear_cache(&mut self) {
+        self.cache.clear();
+        self.scratch = Vec::new();
+    }
+
+    fn weights(&mut self, src: usize, dst: usize) -> Arc<Weights> {
+        let filter = self.filter;
+        self.cache
+            .entry((src, dst))
+            .or_insert_with(|| Arc::new(Weights::new(filter, src, dst)))
+            .clone()
+    }
+
+    /// Resamples the `src_width * src_height` image `src` into the `dst_width * dst_height`
+    /// image `dst`, both stored row by row.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `src` or `dst` are shorter than their size.
+    pub fn resize(
+        &mut self,
+        src: &[Color],
+        src_width: usize,
+        src_height: usize,
+        dst: &mut [Color],
+        dst_width: usize,
+        dst_height: usize,
+    ) {
+        let (src, dst) = (
+            &src[..src_width * src_height],
+            &mut dst[..dst_width * dst_height],
+        );
+        if dst.is_empty() {
+            return;
+        }
+        if src.is_empty() {
+            return dst.iter_mut().for_each(|p| *p = Color::default());
+        }
+
+        let horizontal = self.weights(src_width, dst_width);
+        let vertical = self.weights(src_height, dst_height);
+        let (horizontal, vertical) = (&*horizontal, &*vertical);
+        let row_len = dst_width * 4;
+        let min_rows = (PARALLEL_THRESHOLD / dst_width).max(1);
+
+        // Horizontal pass, every source row into a row of floats
+        let scratch = &mut self.scratch;
+        scratch.resize(src_height * row_len, 0.0);
+        let mut rows: Vec<&mut [f32]> = scratch.chunks_mut(row_len).collect();
+        par_chunks(&mut rows, min_rows, |offset, rows| {
+            let mut line = vec![0.0; src_width * 4];
+            for (y, row) in rows.iter_mut().enumerate() {
+                let src_row = &src[(offset + y) * src_width..][..src_width];
+                let src_row = unsafe {
+                    std::slice::from_raw_parts(src_row.as_ptr() as *const u8, src_width * 4)
+                };
+                for (l, b) in line.iter_mut().zip(src_row) {
+                    *l = *b as f32;
+                }
+                resample_row(horizontal, &line, row);
+            }
+        });
+
+        // Vertical pass, every destination row from the float rows
+        let scratch = &self.scratch;
+        let mut rows: Vec<&mut [Color]> = dst.chunks_mut(dst_width).collect();
+        par_chunks(&mut rows, min_rows, |offset, rows| {
+            let mut acc = vec![0.0; row_len];
+            for (y, row) in rows.iter_mut().enumerate() {
+                let y = offset + y;
+                let start = vertical.starts[y] as usize;
+                let coeffs = &vertical.coeffs[y * vertical.taps..][..vertical.taps];
+
+                acc.iter_mut().for_each(|a| *a = 0.0);
+                for (k, c) in coeffs.iter().enumerate() {
+                    let src_row = &scratch[(start + k) * row_len..][..row_len];
+                    for (a, s) in acc.iter_mut().zip(src_row) {
+                        *a += c * s;
+                    }
+                }
+                // `as u8` saturates, out of range values from negative lobes are clamped.
+                // Color is 4 u8 fields, `repr(C)`, rows are converted as bytes.
+                let row =
+                    unsafe { std::slice::from_raw_parts_mut(row.as_mut_ptr() as *mut u8, row_len) };
+                for (p, a) in row.iter_mut().zip(&acc) {
+                    *p = (a + 0.5) as u8;
+                }
+            }
+        });
+    }
+}
+
+/// Resamples one row of `4` floats per pixel.
+#[inline]
+fn resample_row(weights: &Weights, src: &[f32], dst: &mut [f32]) {
+    let taps = weights.taps;
+    for ((d, start), coeffs) in dst
+        .chunks_exact_mut(4)
+        .zip(&weights.starts)
+        .zip(weights.coeffs.chunks_exact(taps))
+    {
+        let src = &src[*start as usize * 4..][..taps * 4];
+        let mut acc = [0.0; 4];
+        for (c, s) in coeffs.iter().zip(src.chunks_exact(4)) {
+            for k in 0..4 {
+                acc[k] += c * s[k];
+            }
+        }
+        d.copy_from_slice(&acc);
+    }
+}
+
+#[cfg(test)]
+mod resample_test {
+    use super::*;
+
+    const FILTERS: [ResampleFilter; 4] = [
+        ResampleFilter::Box,
+        ResampleFilter::Bilinear,
+        ResampleFilter::Bicubic,
+        ResampleFilter::Lanczos3,
+    ];
+
+    fn test_image(width: usize, height: usize) -> Vec<Color> {
+        (0..width * height)
+            .map(|i| {
+                let (x, y) = (i % width, i / width);
+                Color::new((x * 7) as u8, (y * 5) as u8, (x * y) as u8, 255 - x as u8)
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_resample_identity_and_constant() {
+        let (width, height) = (37, 23);
+        let image = test_image(width, height);
+        let constant = vec![Color::new(10, 200, 90, 128); width * height];
+
+        for filter in FILTERS.iter() {
+            let mut resampler = Resampler::new(*filter);
+            let mut out = vec![Color::default(); width * height];
+            resampler.resize(&image, width, height, &mut out, width, height);
+            assert_eq!(out, image, "{:?}", filter);
+
+            for (w, h) in [(100, 7), (5, 60), (1, 1)].iter() {
+                let mut out = vec![Color::default(); w * h];
+                resampler.resize(&constant, width, height, &mut out, *w, *h);
+                assert!(out.iter().all(|p| *p == constant[0]), "{:?}", filter);
+            }
+        }
+    }
+
+    #[test]
+    fn test_resample_box_and_cache() {
+        let (width, height) = (64, 32);
+        let image = test_image(width, height);
+        let mut resampler = Resampler::new(ResampleFilter::Box);
+        let mut out = vec![Color::default(); 32 * 16];
+        resampler.resize(&image, width, height, &mut out, 32, 16);
+        assert_eq!(resampler.cached_tables(), 2);
+
+        for y in 0..16 {
+            for x in 0..32 {
+                let texel = |dx, dy| image[(y * 2 + dy) * width + x * 2 + dx];
+                let average = |f: fn(Color) -> u8| {
+                    let sum: f32 = [(0, 0), (1, 0), (0, 1), (1, 1)]
+                        .iter()
+                        .map(|(dx, dy)| f(texel(*dx, *dy)) as f32)
+                        .sum();
+                    (sum / 4.0 + 0.5) as u8
+                };
+                let p = out[y * 32 + x];
+                assert_eq!(p.r, average(|c| c.r));
+                assert_eq!(p.a, average(|c| c.a));
+            }
+        }
+
+        resampler.resize(&image, width, height, &mut out, 32, 16);
+        assert_eq!(resampler.cached_tables(), 2);
+        resampler.resize(&image, width, height, &mut out, 16, 32);
+        assert_eq!(resampler.cached_tables(), 4);
+        resampler.clear_cache();
+        assert_eq!(resampler.cached_tables(), 0);
+    }
+}
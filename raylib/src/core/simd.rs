@@ -0,0 +1,635 @@
+//! SIMD kernels behind the `Matrix`, `Vector3` and `Quaternion` operators of math.rs
+//!
+//! Implementation is selected at compile time: SSE2 on x86_64 (AVX/FMA when enabled with
+//! `-C target-feature=+avx2,+fma` or `-C target-cpu=native`), NEON on aarch64, scalar code on
+//! other targets or with the `scalar_math` feature.
+//!
+//! `Matrix` lists `m0, m4, m8, m12` first, so every 16 bytes in memory hold one matrix row:
+//! kernels load rows straight from the `#[repr(C)]` struct, no conversion is required.
+use crate::core::math::{Matrix, Vector4};
+
+cfg_if::cfg_if! {
+    if #[cfg(feature = "scalar_math")] {
+        pub(crate) use self::scalar::*;
+    } else if #[cfg(target_arch = "x86_64")] {
+        pub(crate) use self::sse::*;
+    } else if #[cfg(target_arch = "aarch64")] {
+        pub(crate) use self::neon::*;
+    } else {
+        pub(crate) use self::scalar::*;
+    }
+}
+
+/// Scalar implementations, also used as reference by tests.
+#[allow(dead_code)]
+pub(crate) mod scalar {
+    use super::{Matrix, Vector4};
+
+    #[inline]
+    pub(crate) fn matrix_add(a: &Matrix, b: &Matrix) -> Matrix {
+        Matrix {
+            m0: a.m0 + b.m0,
+            m1: a.m1 + b.m1,
+            m2: a.m2 + b.m2,
+            m3: a.m3 + b.m3,
+            m4: a.m4 + b.m4,
+            m5: a.m5 + b.m5,
+            m6: a.m6 + b.m6,
+            m7: a.m7 + b.m7,
+            m8: a.m8 + b.m8,
+            m9: a.m9 + b.m9,
+            m10: a.m10 + b.m10,
+            m11: a.m11 + b.m11,
+            m12: a.m12 + b.m12,
+            m13: a.m13 + b.m13,
+            m14: a.m14 + b.m14,
+            m15: a.m15 + b.m15,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_sub(a: &Matrix, b: &Matrix) -> Matrix {
+        Matrix {
+            m0: a.m0 - b.m0,
+            m1: a.m1 - b.m1,
+            m2: a.m2 - b.m2,
+            m3: a.m3 - b.m3,
+            m4: a.m4 - b.m4,
+            m5: a.m5 - b.m5,
+            m6: a.m6 - b.m6,
+            m7: a.m7 - b.m7,
+            m8: a.m8 - b.m8,
+            m9: a.m9 - b.m9,
+            m10: a.m10 - b.m10,
+            m11: a.m11 - b.m11,
+            m12: a.m12 - b.m12,
+            m13: a.m13 - b.m13,
+            m14: a.m14 - b.m14,
+            m15: a.m15 - b.m15,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_mul(a: &Matrix, b: &Matrix) -> Matrix {
+        Matrix {
+            m0: a.m0 * b.m0 + a.m1 * b.m4 + a.m2 * b.m8 + a.m3 * b.m12,
+            m1: a.m0 * b.m1 + a.m1 * b.m5 + a.m2 * b.m9 + a.m3 * b.m13,
+            m2: a.m0 * b.m2 + a.m1 * b.m6 + a.m2 * b.m10 + a.m3 * b.m14,
+            m3: a.m0 * b.m3 + a.m1 * b.m7 + a.m2 * b.m11 + a.m3 * b.m15,
+            m4: a.m4 * b.m0 + a.m5 * b.m4 + a.m6 * b.m8 + a.m7 * b.m12,
+            m5: a.m4 * b.m1 + a.m5 * b.m5 + a.m6 * b.m9 + a.m7 * b.m13,
+            m6: a.m4 * b.m2 + a.m5 * b.m6 + a.m6 * b.m10 + a.m7 * b.m14,
+            m7: a.m4 * b.m3 + a.m5 * b.m7 + a.m6 * b.m11 + a.m7 * b.m15,
+            m8: a.m8 * b.m0 + a.m9 * b.m4 + a.m10 * b.m8 + a.m11 * b.m12,
+            m9: a.m8 * b.m1 + a.m9 * b.m5 + a.m10 * b.m9 + a.m11 * b.m13,
+            m10: a.m8 * b.m2 + a.m9 * b.m6 + a.m10 * b.m10 + a.m11 * b.m14,
+            m11: a.m8 * b.m3 + a.m9 * b.m7 + a.m10 * b.m11 + a.m11 * b.m15,
+            m12: a.m12 * b.m0 + a.m13 * b.m4 + a.m14 * b.m8 + a.m15 * b.m12,
+            m13: a.m12 * b.m1 + a.m13 * b.m5 + a.m14 * b.m9 + a.m15 * b.m13,
+            m14: a.m12 * b.m2 + a.m13 * b.m6 + a.m14 * b.m10 + a.m15 * b.m14,
+            m15: a.m12 * b.m3 + a.m13 * b.m7 + a.m14 * b.m11 + a.m15 * b.m15,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_transpose(m: &Matrix) -> Matrix {
+        Matrix {
+            m0: m.m0,
+            m1: m.m4,
+            m2: m.m8,
+            m3: m.m12,
+            m4: m.m1,
+            m5: m.m5,
+            m6: m.m9,
+            m7: m.m13,
+            m8: m.m2,
+            m9: m.m6,
+            m10: m.m10,
+            m11: m.m14,
+            m12: m.m3,
+            m13: m.m7,
+            m14: m.m11,
+            m15: m.m15,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_invert(m: &Matrix) -> Matrix {
+        let a00 = m.m0;
+        let a01 = m.m1;
+        let a02 = m.m2;
+        let a03 = m.m3;
+        let a10 = m.m4;
+        let a11 = m.m5;
+        let a12 = m.m6;
+        let a13 = m.m7;
+        let a20 = m.m8;
+        let a21 = m.m9;
+        let a22 = m.m10;
+        let a23 = m.m11;
+        let a30 = m.m12;
+        let a31 = m.m13;
+        let a32 = m.m14;
+        let a33 = m.m15;
+
+        let b00 = (a00 * a11) - (a01 * a10);
+        let b01 = (a00 * a12) - (a02 * a10);
+        let b02 = (a00 * a13) - (a03 * a10);
+        let b03 = (a01 * a12) - (a02 * a11);
+        let b04 = (a01 * a13) - (a03 * a11);
+        let b05 = (a02 * a13) - (a03 * a12);
+        let b06 = (a20 * a31) - (a21 * a30);
+        let b07 = (a20 * a32) - (a22 * a30);
+        let b08 = (a20 * a33) - (a23 * a30);
+        let b09 = (a21 * a32) - (a22 * a31);
+        let b10 = (a21 * a33) - (a23 * a31);
+        let b11 = (a22 * a33) - (a23 * a32);
+
+        let inv_det = 1.0
+            / ((b00 * b11) - (b01 * b10) + (b02 * b09) + (b03 * b08) - (b04 * b07) + (b05 * b06));
+
+        Matrix {
+            m0: ((a11 * b11) - (a12 * b10) + (a13 * b09)) * inv_det,
+            m1: ((-a01 * b11) + (a02 * b10) - (a03 * b09)) * inv_det,
+            m2: ((a31 * b05) - (a32 * b04) + (a33 * b03)) * inv_det,
+            m3: ((-a21 * b05) + (a22 * b04) - (a23 * b03)) * inv_det,
+            m4: ((-a10 * b11) + (a12 * b08) - (a13 * b07)) * inv_det,
+            m5: ((a00 * b11) - (a02 * b08) + (a03 * b07)) * inv_det,
+            m6: ((-a30 * b05) + (a32 * b02) - (a33 * b01)) * inv_det,
+            m7: ((a20 * b05) - (a22 * b02) + (a23 * b01)) * inv_det,
+            m8: ((a10 * b10) - (a11 * b08) + (a13 * b06)) * inv_det,
+            m9: ((-a00 * b10) + (a01 * b08) - (a03 * b06)) * inv_det,
+            m10: ((a30 * b04) - (a31 * b02) + (a33 * b00)) * inv_det,
+            m11: ((-a20 * b04) + (a21 * b02) - (a23 * b00)) * inv_det,
+            m12: ((-a10 * b09) + (a11 * b07) - (a12 * b06)) * inv_det,
+            m13: ((a00 * b09) - (a01 * b07) + (a02 * b06)) * inv_det,
+            m14: ((-a30 * b03) + (a31 * b01) - (a32 * b00)) * inv_det,
+            m15: ((a20 * b03) - (a21 * b01) + (a22 * b00)) * inv_det,
+        }
+    }
+
+    /// Transforms `v` by `m`, `w` component included.
+    #[inline]
+    pub(crate) fn matrix_transform(m: &Matrix, v: Vector4) -> Vector4 {
+        Vector4 {
+            x: m.m0 * v.x + m.m4 * v.y + m.m8 * v.z + m.m12 * v.w,
+            y: m.m1 * v.x + m.m5 * v.y + m.m9 * v.z + m.m13 * v.w,
+            z: m.m2 * v.x + m.m6 * v.y + m.m10 * v.z + m.m14 * v.w,
+            w: m.m3 * v.x + m.m7 * v.y + m.m11 * v.z + m.m15 * v.w,
+        }
+    }
+
+    #[inline]
+    pub(crate) fn quaternion_mul(a: Vector4, b: Vector4) -> Vector4 {
+        Vector4 {
+            x: (a.x * b.w) + (a.w * b.x) + (a.y * b.z) - (a.z * b.y),
+            y: (a.y * b.w) + (a.w * b.y) + (a.z * b.x) - (a.x * b.z),
+            z: (a.z * b.w) + (a.w * b.z) + (a.x * b.y) - (a.y * b.x),
+            w: (a.w * b.w) - (a.x * b.x) - (a.y * b.y) - (a.z * b.z),
+        }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_dot(a: Vector4, b: Vector4) -> f32 {
+        a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w
+    }
+
+    /// Returns `a + (b - a) * amount`.
+    #[inline]
+    pub(crate) fn vector4_lerp(a: Vector4, b: Vector4, amount: f32) -> Vector4 {
+        Vector4 {
+            x: a.x + amount * (b.x - a.x),
+            y: a.y + amount * (b.y - a.y),
+            z: a.z + amount * (b.z - a.z),
+            w: a.w + amount * (b.w - a.w),
+        }
+    }
+
+    /// Returns `a * wa + b * wb`.
+    #[inline]
+    pub(crate) fn vector4_blend(a: Vector4, wa: f32, b: Vector4, wb: f32) -> Vector4 {
+        Vector4 {
+            x: a.x * wa + b.x * wb,
+            y: a.y * wa + b.y * wb,
+            z: a.z * wa + b.z * wb,
+            w: a.w * wa + b.w * wb,
+        }
+    }
+}
+
+#[cfg(target_arch = "x86_64")]
+#[allow(dead_code)]
+mod sse {
+    use super::{Matrix, Vector4};
+    use std::arch::x86_64::*;
+
+    // Already vectorized by the compiler
+    #[allow(unused_imports)]
+    pub(crate) use super::scalar::{matrix_transpose, vector4_lerp};
+
+    /// `[a[x], a[y], b[z], b[w]]`
+    macro_rules! shuffle {
+        ($a:expr, $b:expr, $x:literal, $y:literal, $z:literal, $w:literal) => {
+            _mm_shuffle_ps::<{ $x | ($y << 2) | ($z << 4) | ($w << 6) }>($a, $b)
+        };
+    }
+
+    macro_rules! swizzle {
+        ($v:expr, $x:literal, $y:literal, $z:literal, $w:literal) => {
+            shuffle!($v, $v, $x, $y, $z, $w)
+        };
+    }
+
+    #[inline(always)]
+    unsafe fn load(m: &Matrix) -> [__m128; 4] {
+        let p = m as *const Matrix as *const f32;
+        [
+            _mm_loadu_ps(p),
+            _mm_loadu_ps(p.add(4)),
+            _mm_loadu_ps(p.add(8)),
+            _mm_loadu_ps(p.add(12)),
+        ]
+    }
+
+    #[inline(always)]
+    unsafe fn store(rows: [__m128; 4]) -> Matrix {
+        let mut m = Matrix::default();
+        let p = &mut m as *mut Matrix as *mut f32;
+        _mm_storeu_ps(p, rows[0]);
+        _mm_storeu_ps(p.add(4), rows[1]);
+        _mm_storeu_ps(p.add(8), rows[2]);
+        _mm_storeu_ps(p.add(12), rows[3]);
+        m
+    }
+
+    #[inline(always)]
+    unsafe fn load4(v: &Vector4) -> __m128 {
+        _mm_loadu_ps(v as *const Vector4 as *const f32)
+    }
+
+    #[inline(always)]
+    unsafe fn store4(v: __m128) -> Vector4 {
+        let mut r = Vector4::default();
+        _mm_storeu_ps(&mut r as *mut Vector4 as *mut f32, v);
+        r
+    }
+
+    /// Returns `a * b + c`, fused when FMA is enabled.
+    #[inline(always)]
+    unsafe fn madd(a: __m128, b: __m128, c: __m128) -> __m128 {
+        #[cfg(target_feature = "fma")]
+        return _mm_fmadd_ps(a, b, c);
+        #[cfg(not(target_feature = "fma"))]
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    /// Horizontal sum, broadcast to every lane.
+    #[inline(always)]
+    unsafe fn sum(v: __m128) -> __m128 {
+        let v = _mm_add_ps(v, swizzle!(v, 2, 3, 0, 1));
+        _mm_add_ps(v, swizzle!(v, 1, 0, 3, 2))
+    }
+
+    #[inline]
+    pub(crate) fn matrix_add(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            store([
+                _mm_add_ps(a[0], b[0]),
+                _mm_add_ps(a[1], b[1]),
+                _mm_add_ps(a[2], b[2]),
+                _mm_add_ps(a[3], b[3]),
+            ])
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_sub(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            store([
+                _mm_sub_ps(a[0], b[0]),
+                _mm_sub_ps(a[1], b[1]),
+                _mm_sub_ps(a[2], b[2]),
+                _mm_sub_ps(a[3], b[3]),
+            ])
+        }
+    }
+
+    /// Every result row is a combination of `a` rows, weighted by the matching `b` row.
+    #[cfg(not(target_feature = "avx"))]
+    #[inline]
+    pub(crate) fn matrix_mul(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            let row = |r: __m128| {
+                let mut acc = _mm_mul_ps(swizzle!(r, 0, 0, 0, 0), a[0]);
+                acc = madd(swizzle!(r, 1, 1, 1, 1), a[1], acc);
+                acc = madd(swizzle!(r, 2, 2, 2, 2), a[2], acc);
+                madd(swizzle!(r, 3, 3, 3, 3), a[3], acc)
+            };
+            store([row(b[0]), row(b[1]), row(b[2]), row(b[3])])
+        }
+    }
+
+    /// Same as the SSE version, two result rows at once.
+    #[cfg(target_feature = "avx")]
+    #[inline]
+    pub(crate) fn matrix_mul(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let a = load(a);
+            let a = [
+                _mm256_broadcast_ps(&a[0]),
+                _mm256_broadcast_ps(&a[1]),
+                _mm256_broadcast_ps(&a[2]),
+                _mm256_broadcast_ps(&a[3]),
+            ];
+            let pb = b as *const Matrix as *const f32;
+
+            let rows = |r: __m256| {
+                let mut acc = _mm256_mul_ps(_mm256_shuffle_ps::<0x00>(r, r), a[0]);
+                #[cfg(target_feature = "fma")]
+                {
+                    acc = _mm256_fmadd_ps(_mm256_shuffle_ps::<0x55>(r, r), a[1], acc);
+                    acc = _mm256_fmadd_ps(_mm256_shuffle_ps::<0xaa>(r, r), a[2], acc);
+                    acc = _mm256_fmadd_ps(_mm256_shuffle_ps::<0xff>(r, r), a[3], acc);
+                }
+                #[cfg(not(target_feature = "fma"))]
+                {
+                    acc = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps::<0x55>(r, r), a[1]), acc);
+                    acc = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps::<0xaa>(r, r), a[2]), acc);
+                    acc = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps::<0xff>(r, r), a[3]), acc);
+                }
+                acc
+            };
+
+            let mut m = Matrix::default();
+            let p = &mut m as *mut Matrix as *mut f32;
+            _mm256_storeu_ps(p, rows(_mm256_loadu_ps(pb)));
+            _mm256_storeu_ps(p.add(8), rows(_mm256_loadu_ps(pb.add(8))));
+            m
+        }
+    }
+
+    /// 2x2 row major matrices product `a * b`.
+    #[inline(always)]
+    unsafe fn mat2_mul(a: __m128, b: __m128) -> __m128 {
+        _mm_add_ps(
+            _mm_mul_ps(a, swizzle!(b, 0, 3, 0, 3)),
+            _mm_mul_ps(swizzle!(a, 1, 0, 3, 2), swizzle!(b, 2, 1, 2, 1)),
+        )
+    }
+
+    /// 2x2 row major matrices product `adjugate(a) * b`.
+    #[inline(always)]
+    unsafe fn mat2_adj_mul(a: __m128, b: __m128) -> __m128 {
+        _mm_sub_ps(
+            _mm_mul_ps(swizzle!(a, 3, 3, 0, 0), b),
+            _mm_mul_ps(swizzle!(a, 1, 1, 2, 2), swizzle!(b, 2, 3, 0, 1)),
+        )
+    }
+
+    /// 2x2 row major matrices product `a * adjugate(b)`.
+    #[inline(always)]
+    unsafe fn mat2_mul_adj(a: __m128, b: __m128) -> __m128 {
+        _mm_sub_ps(
+            _mm_mul_ps(a, swizzle!(b, 3, 0, 3, 0)),
+            _mm_mul_ps(swizzle!(a, 1, 0, 3, 2), swizzle!(b, 2, 1, 2, 1)),
+        )
+    }
+
+    /// Block-wise inversion: the matrix is split into four 2x2 matrices `A B / C D`.
+    /// NOTE: Inverse of the transposed matrix is the transposed inverse, memory rows can be used directly
+    #[inline]
+    pub(crate) fn matrix_invert(m: &Matrix) -> Matrix {
+        unsafe {
+            let m = load(m);
+            let a = _mm_movelh_ps(m[0], m[1]);
+            let b = _mm_movehl_ps(m[1], m[0]);
+            let c = _mm_movelh_ps(m[2], m[3]);
+            let d = _mm_movehl_ps(m[3], m[2]);
+
+            // Sub matrices determinants: |A| |B| |C| |D|
+            let det_sub = _mm_sub_ps(
+                _mm_mul_ps(
+                    shuffle!(m[0], m[2], 0, 2, 0, 2),
+                    shuffle!(m[1], m[3], 1, 3, 1, 3),
+                ),
+                _mm_mul_ps(
+                    shuffle!(m[0], m[2], 1, 3, 1, 3),
+                    shuffle!(m[1], m[3], 0, 2, 0, 2),
+                ),
+            );
+            let det_a = swizzle!(det_sub, 0, 0, 0, 0);
+            let det_b = swizzle!(det_sub, 1, 1, 1, 1);
+            let det_c = swizzle!(det_sub, 2, 2, 2, 2);
+            let det_d = swizzle!(det_sub, 3, 3, 3, 3);
+
+            let d_c = mat2_adj_mul(d, c);
+            let a_b = mat2_adj_mul(a, b);
+            let x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+            let w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+            let y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+            let z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+            // |M| = |A|*|D| + |B|*|C| - trace((A#B)(D#C))
+            let tr = sum(_mm_mul_ps(a_b, swizzle!(d_c, 0, 2, 1, 3)));
+            let det = _mm_sub_ps(
+                _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)),
+                tr,
+            );
+            let inv_det = _mm_div_ps(_mm_setr_ps(1.0, -1.0, -1.0, 1.0), det);
+
+            let x = _mm_mul_ps(x, inv_det);
+            let y = _mm_mul_ps(y, inv_det);
+            let z = _mm_mul_ps(z, inv_det);
+            let w = _mm_mul_ps(w, inv_det);
+
+            // Adjugate of every block, stored back as rows
+            store([
+                shuffle!(x, y, 3, 1, 3, 1),
+                shuffle!(x, y, 2, 0, 2, 0),
+                shuffle!(z, w, 3, 1, 3, 1),
+                shuffle!(z, w, 2, 0, 2, 0),
+            ])
+        }
+    }
+
+    /// Four dot products (one per row), gathered with a transposition.
+    #[inline]
+    pub(crate) fn matrix_transform(m: &Matrix, v: Vector4) -> Vector4 {
+        unsafe {
+            let m = load(m);
+            let v = load4(&v);
+            let p0 = _mm_mul_ps(m[0], v);
+            let p1 = _mm_mul_ps(m[1], v);
+            let p2 = _mm_mul_ps(m[2], v);
+            let p3 = _mm_mul_ps(m[3], v);
+
+            let t0 = _mm_unpacklo_ps(p0, p1);
+            let t1 = _mm_unpackhi_ps(p0, p1);
+            let t2 = _mm_unpacklo_ps(p2, p3);
+            let t3 = _mm_unpackhi_ps(p2, p3);
+            store4(_mm_add_ps(
+                _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0)),
+                _mm_add_ps(_mm_movelh_ps(t1, t3), _mm_movehl_ps(t3, t1)),
+            ))
+        }
+    }
+
+    #[inline]
+    pub(crate) fn quaternion_mul(a: Vector4, b: Vector4) -> Vector4 {
+        unsafe {
+            let a = load4(&a);
+            let b = load4(&b);
+            let sign = _mm_setr_ps(1.0, 1.0, 1.0, -1.0);
+
+            let r = _mm_mul_ps(swizzle!(a, 3, 3, 3, 3), b);
+            let r = madd(
+                _mm_mul_ps(swizzle!(a, 0, 1, 2, 0), swizzle!(b, 3, 3, 3, 0)),
+                sign,
+                r,
+            );
+            let r = madd(
+                _mm_mul_ps(swizzle!(a, 1, 2, 0, 1), swizzle!(b, 2, 0, 1, 1)),
+                sign,
+                r,
+            );
+            store4(_mm_sub_ps(
+                r,
+                _mm_mul_ps(swizzle!(a, 2, 0, 1, 2), swizzle!(b, 1, 2, 0, 2)),
+            ))
+        }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_dot(a: Vector4, b: Vector4) -> f32 {
+        unsafe { _mm_cvtss_f32(sum(_mm_mul_ps(load4(&a), load4(&b)))) }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_blend(a: Vector4, wa: f32, b: Vector4, wb: f32) -> Vector4 {
+        unsafe {
+            let r = _mm_mul_ps(load4(&a), _mm_set1_ps(wa));
+            store4(madd(load4(&b), _mm_set1_ps(wb), r))
+        }
+    }
+}
+
+#[cfg(target_arch = "aarch64")]
+#[allow(dead_code)]
+mod neon {
+    use super::{Matrix, Vector4};
+    use std::arch::aarch64::*;
+
+    // No NEON advantage over the scalar code for those
+    #[allow(unused_imports)]
+    pub(crate) use super::scalar::{matrix_invert, matrix_transpose, quaternion_mul};
+
+    #[inline(always)]
+    unsafe fn load(m: &Matrix) -> [float32x4_t; 4] {
+        let p = m as *const Matrix as *const f32;
+        [
+            vld1q_f32(p),
+            vld1q_f32(p.add(4)),
+            vld1q_f32(p.add(8)),
+            vld1q_f32(p.add(12)),
+        ]
+    }
+
+    #[inline(always)]
+    unsafe fn store(rows: [float32x4_t; 4]) -> Matrix {
+        let mut m = Matrix::default();
+        let p = &mut m as *mut Matrix as *mut f32;
+        vst1q_f32(p, rows[0]);
+        vst1q_f32(p.add(4), rows[1]);
+        vst1q_f32(p.add(8), rows[2]);
+        vst1q_f32(p.add(12), rows[3]);
+        m
+    }
+
+    #[inline(always)]
+    unsafe fn load4(v: &Vector4) -> float32x4_t {
+        vld1q_f32(v as *const Vector4 as *const f32)
+    }
+
+    #[inline(always)]
+    unsafe fn store4(v: float32x4_t) -> Vector4 {
+        let mut r = Vector4::default();
+        vst1q_f32(&mut r as *mut Vector4 as *mut f32, v);
+        r
+    }
+
+    #[inline]
+    pub(crate) fn matrix_add(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            store([
+                vaddq_f32(a[0], b[0]),
+                vaddq_f32(a[1], b[1]),
+                vaddq_f32(a[2], b[2]),
+                vaddq_f32(a[3], b[3]),
+            ])
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_sub(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            store([
+                vsubq_f32(a[0], b[0]),
+                vsubq_f32(a[1], b[1]),
+                vsubq_f32(a[2], b[2]),
+                vsubq_f32(a[3], b[3]),
+            ])
+        }
+    }
+
+    /// Every result row is a combination of `a` rows, weighted by the matching `b` row.
+    #[inline]
+    pub(crate) fn matrix_mul(a: &Matrix, b: &Matrix) -> Matrix {
+        unsafe {
+            let (a, b) = (load(a), load(b));
+            let row = |r: float32x4_t| {
+                let acc = vmulq_laneq_f32::<0>(a[0], r);
+                let acc = vfmaq_laneq_f32::<1>(acc, a[1], r);
+                let acc = vfmaq_laneq_f32::<2>(acc, a[2], r);
+                vfmaq_laneq_f32::<3>(acc, a[3], r)
+            };
+            store([row(b[0]), row(b[1]), row(b[2]), row(b[3])])
+        }
+    }
+
+    #[inline]
+    pub(crate) fn matrix_transform(m: &Matrix, v: Vector4) -> Vector4 {
+        unsafe {
+            let m = load(m);
+            let v = load4(&v);
+            Vector4 {
+                x: vaddvq_f32(vmulq_f32(m[0], v)),
+                y: vaddvq_f32(vmulq_f32(m[1], v)),
+                z: vaddvq_f32(vmulq_f32(m[2], v)),
+                w: vaddvq_f32(vmulq_f32(m[3], v)),
+            }
+        }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_dot(a: Vector4, b: Vector4) -> f32 {
+        unsafe { vaddvq_f32(vmulq_f32(load4(&a), load4(&b))) }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_lerp(a: Vector4, b: Vector4, amount: f32) -> Vector4 {
+        unsafe {
+            let a = load4(&a);
+            store4(vaddq_f32(a, vmulq_n_f32(vsubq_f32(load4(&b), a), amount)))
+        }
+    }
+
+    #[inline]
+    pub(crate) fn vector4_blend(a: Vector4, wa: f32, b: Vector4, wb: f32) -> Vector4 {
+        unsafe { store4(vfmaq_n_f32(vmulq_n_f32(load4(&a), wa), load4(&b), wb)) }
+    }
+}
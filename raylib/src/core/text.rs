@@ -1,12 +1,26 @@
 //! Text and Font related functions
 //! Text manipulation functions are super unsafe so use rust String functions
-use crate::core::math::Vector2;
+use crate::core::batch::{draw_sprite_batch, SpriteInstance};
+use crate::core::color::Color;
+use crate::core::file::lock_static_buffers;
+use crate::core::math::{Rectangle, Vector2};
 use crate::core::texture::{Image, Texture2D};
 use crate::core::{RaylibHandle, RaylibThread};
 use crate::ffi;
 
+use std::cell::RefCell;
 use std::convert::{AsMut, AsRef};
 use std::ffi::CString;
+use std::os::raw::c_char;
+
+/// Glyph quads gathered before being written into the render batch by `draw_text_font`.
+const GLYPH_CHUNK: usize = 64;
+
+thread_local! {
+    /// NUL terminated copy of the last text passed to C text functions (or last formatted text),
+    /// reused between calls.
+    static C_TEXT: RefCell<Vec<u8>> = RefCell::new(Vec::with_capacity(256));
+}
 
 fn no_drop<T>(_thing: T) {}
 make_thin_wrapper!(Font, ffi::Font, ffi::UnloadFont);
@@ -95,6 +109,7 @@ impl RaylibHandle {
     #[inline]
     pub fn load_font(&mut self, _: &RaylibThread, filename: &str) -> Result<Font, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let f = unsafe { ffi::LoadFont(c_filename.as_ptr()) };
         if f.chars.is_null() || f.texture.id == 0 {
             return Err(format!(
@@ -115,6 +130,7 @@ impl RaylibHandle {
         chars: FontLoadEx,
     ) -> Result<Font, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let f = unsafe {
             match chars {
                 FontLoadEx::Chars(c) => ffi::LoadFontEx(
@@ -322,8 +338,12 @@ impl RaylibHandle {
 /// Measures string width in pixels for default font.
 #[inline]
 pub fn measure_text(text: &str, font_size: i32) -> i32 {
-    let c_text = CString::new(text).unwrap();
-    unsafe { ffi::MeasureText(c_text.as_ptr(), font_size) }
+    let font = unsafe { ffi::GetFontDefault() };
+    if font.texture.id == 0 {
+        return 0;
+    }
+    let (font_size, spacing) = default_font_size(font_size);
+    measure_text_font(&font, text, font_size, spacing).x as i32
 }
 
 /// Measures string width in pixels for `font`.
@@ -334,8 +354,183 @@ pub fn measure_text_ex(
     font_size: f32,
     spacing: f32,
 ) -> Vector2 {
-    let c_text = CString::new(text).unwrap();
-    unsafe { ffi::MeasureTextEx(*font.as_ref(), c_text.as_ptr(), font_size, spacing).into() }
+    measure_text_font(font.as_ref(), text, font_size, spacing)
+}
+
+/// Calls `f` with `text` as a C string, copied into a reused thread local buffer.
+/// As in C, text ends at the first NUL character.
+pub(crate) fn with_c_text<R>(text: &str, f: impl FnOnce(*const c_char) -> R) -> R {
+    C_TEXT.with(|buffer| {
+        let mut buffer = buffer.borrow_mut();
+        buffer.clear();
+        buffer.extend_from_slice(text.as_bytes());
+        buffer.push(0);
+        f(buffer.as_ptr() as *const c_char)
+    })
+}
+
+/// Calls `f` with `args` formatted into the same reused thread local buffer as [`with_c_text`].
+/// Allows drawing formatted text every frame without allocating a `String`.
+pub(crate) fn with_text_format<R>(args: std::fmt::Arguments, f: impl FnOnce(&str) -> R) -> R {
+    use std::io::Write;
+    C_TEXT.with(|buffer| {
+        let mut buffer = buffer.borrow_mut();
+        buffer.clear();
+        // Formatting into a Vec only fails if a Display implementation fails
+        let _ = buffer.write_fmt(args);
+        f(std::str::from_utf8(&buffer).unwrap_or_default())
+    })
+}
+
+/// Font size and spacing `DrawText`/`MeasureText` use with the default font.
+#[inline]
+pub(crate) fn default_font_size(font_size: i32) -> (f32, f32) {
+    let font_size = font_size.max(10);
+    (font_size as f32, (font_size / 10) as f32)
+}
+
+/// Glyphs and atlas rectangles of `font`, empty if the font is not loaded.
+#[inline]
+fn font_glyphs(font: &ffi::Font) -> (&[ffi::CharInfo], &[ffi::Rectangle]) {
+    if font.chars.is_null() || font.recs.is_null() || font.charsCount <= 0 {
+        return (&[], &[]);
+    }
+    let count = font.charsCount as usize;
+    unsafe {
+        (
+            std::slice::from_raw_parts(font.chars, count),
+            std::slice::from_raw_parts(font.recs, count),
+        )
+    }
+}
+
+/// Index of `codepoint` in `glyphs`, glyph 63 when missing, as `GetGlyphIndex` does.
+/// Fonts loaded with the default charset store codepoints in order from 32, checked first.
+#[inline]
+fn glyph_index(glyphs: &[ffi::CharInfo], codepoint: i32) -> usize {
+    // Codepoints under 32 wrap around, out of range
+    let direct = codepoint.wrapping_sub(32) as usize;
+    if direct < glyphs.len() && glyphs[direct].value == codepoint {
+        return direct;
+    }
+    glyphs
+        .iter()
+        .position(|g| g.value == codepoint)
+        .unwrap_or(63.min(glyphs.len() - 1))
+}
+
+/// Draws `text` as `DrawTextEx` does, without the C string round trip.
+/// Glyph quads are written into the render batch in chunks, see `draw_sprite_batch`.
+pub(crate) fn draw_text_font(
+    font: &ffi::Font,
+    text: &str,
+    position: ffi::Vector2,
+    font_size: f32,
+    spacing: f32,
+    tint: ffi::Color,
+) {
+    let (glyphs, recs) = font_glyphs(font);
+    if glyphs.is_empty() || font.texture.id == 0 {
+        return;
+    }
+
+    let scale = font_size / font.baseSize as f32;
+    let padding = font.charsPadding as f32;
+    let tint = Color::from(tint);
+    let mut quads = [SpriteInstance::default(); GLYPH_CHUNK];
+    let mut count = 0;
+    let mut offset_x = 0.0;
+    let mut offset_y = 0;
+
+    for c in text.chars().take_while(|&c| c != '\0') {
+        if c == '\n' {
+            // Fixed line spacing of 1.5 line-height
+            offset_y += ((font.baseSize + font.baseSize / 2) as f32 * scale) as i32;
+            offset_x = 0.0;
+            continue;
+        }
+
+        let index = glyph_index(glyphs, c as i32);
+        let (glyph, rec) = (&glyphs[index], &recs[index]);
+        if c != ' ' && c != '\t' {
+            quads[count] = SpriteInstance {
+                dest: Rectangle::new(
+                    position.x + offset_x + glyph.offsetX as f32 * scale - padding * scale,
+                    position.y + offset_y as f32 + glyph.offsetY as f32 * scale - padding * scale,
+                    (rec.width + 2.0 * padding) * scale,
+                    (rec.height + 2.0 * padding) * scale,
+                ),
+                source: Rectangle::new(
+                    rec.x - padding,
+                    rec.y - padding,
+                    rec.width + 2.0 * padding,
+                    rec.height + 2.0 * padding,
+                ),
+                origin: Vector2::zero(),
+                rotation: 0.0,
+                tint,
+            };
+            count += 1;
+            if count == GLYPH_CHUNK {
+                draw_sprite_batch(&font.texture, &quads);
+                count = 0;
+            }
+        }
+
+        offset_x += if glyph.advanceX == 0 {
+            rec.width * scale + spacing
+        } else {
+            glyph.advanceX as f32 * scale + spacing
+        };
+    }
+
+    draw_sprite_batch(&font.texture, &quads[..count]);
+}
+
+/// Measures `text` as `MeasureTextEx` does, without the C string round trip.
+pub(crate) fn measure_text_font(
+    font: &ffi::Font,
+    text: &str,
+    font_size: f32,
+    spacing: f32,
+) -> Vector2 {
+    let (glyphs, recs) = font_glyphs(font);
+    if glyphs.is_empty() {
+        return Vector2::zero();
+    }
+
+    let scale = font_size / font.baseSize as f32;
+    let mut width = 0.0f32;
+    let mut max_width = 0.0f32;
+    let mut height = font.baseSize as f32;
+    // Characters of the current and longest lines, spacing is added between them
+    let mut len = 0;
+    let mut max_len = 0;
+
+    for c in text.chars().take_while(|&c| c != '\0') {
+        len += 1;
+        if c == '\n' {
+            max_width = max_width.max(width);
+            width = 0.0;
+            len = 0;
+            // Fixed line spacing of 1.5 line-height
+            height += font.baseSize as f32 * 1.5;
+        } else {
+            let index = glyph_index(glyphs, c as i32);
+            width += if glyphs[index].advanceX != 0 {
+                glyphs[index].advanceX as f32
+            } else {
+                recs[index].width + glyphs[index].offsetX as f32
+            };
+        }
+        max_len = max_len.max(len);
+    }
+    max_width = max_width.max(width);
+
+    Vector2::new(
+        max_width * scale + (max_len - 1) as f32 * spacing,
+        height * scale,
+    )
 }
 
 /// Gets index position for a unicode character on `font`.
@@ -343,3 +538,89 @@ pub fn measure_text_ex(
 pub fn get_glyph_index(font: impl std::convert::AsRef<ffi::Font>, character: i32) -> i32 {
     unsafe { ffi::GetGlyphIndex(*font.as_ref(), character) }
 }
+
+#[cfg(test)]
+mod text_test {
+    use super::*;
+
+    /// Font with codepoints 32 to 127, 5x10 glyphs, only 'A' has an advance.
+    fn test_font(glyphs: &mut Vec<ffi::CharInfo>, recs: &mut Vec<ffi::Rectangle>) -> ffi::Font {
+        for i in 0..96 {
+            let mut glyph: ffi::CharInfo = unsafe { std::mem::zeroed() };
+            glyph.value = 32 + i;
+            glyph.advanceX = if glyph.value == 'A' as i32 { 7 } else { 0 };
+            glyphs.push(glyph);
+            recs.push(Rectangle::new(i as f32 * 5.0, 0.0, 5.0, 10.0).into());
+        }
+        let mut font: ffi::Font = unsafe { std::mem::zeroed() };
+        font.baseSize = 10;
+        font.charsCount = glyphs.len() as i32;
+        font.chars = glyphs.as_mut_ptr();
+        font.recs = recs.as_mut_ptr();
+        font
+    }
+
+    #[test]
+    fn test_glyph_index() {
+        let (mut glyphs, mut recs) = (Vec::new(), Vec::new());
+        test_font(&mut glyphs, &mut recs);
+        assert_eq!(glyph_index(&glyphs, ' ' as i32), 0);
+        assert_eq!(glyph_index(&glyphs, 'A' as i32), 33);
+        // Missing glyphs fall back to index 63
+        assert_eq!(glyph_index(&glyphs, 'é' as i32), 63);
+        assert_eq!(glyph_index(&glyphs, '\n' as i32), 63);
+
+        // Unordered charset
+        glyphs.swap(0, 33);
+        assert_eq!(glyph_index(&glyphs, 'A' as i32), 0);
+    }
+
+    #[test]
+    fn test_measure_text_font() {
+        let (mut glyphs, mut recs) = (Vec::new(), Vec::new());
+        let font = test_font(&mut glyphs, &mut recs);
+        assert_eq!(
+            measure_text_font(&font, "AB", 20.0, 2.0),
+            Vector2::new(26.0, 20.0)
+        );
+        // Longest line width, spacing of the line with most characters
+        assert_eq!(
+            measure_text_font(&font, "A\nBBB", 20.0, 2.0),
+            Vector2::new(34.0, 50.0)
+        );
+        // Text ends on NUL, as in C
+        assert_eq!(
+            measure_text_font(&font, "AB\0CD", 20.0, 2.0),
+            Vector2::new(26.0, 20.0)
+        );
+    }
+
+    #[test]
+    fn test_with_c_text() {
+        let text = with_c_text("label", |c_text| unsafe {
+            std::ffi::CStr::from_ptr(c_text)
+                .to_str()
+                .unwrap()
+                .to_owned()
+        });
+        assert_eq!(text, "label");
+        let text = with_c_text("ab\0cd", |c_text| unsafe {
+            std::ffi::CStr::from_ptr(c_text)
+                .to_str()
+                .unwrap()
+                .to_owned()
+        });
+        assert_eq!(text, "ab");
+    }
+
+    #[test]
+    fn test_with_text_format() {
+        let text = with_text_format(format_args!("DRAW CALLS: {}", 42), str::to_owned);
+        assert_eq!(text, "DRAW CALLS: 42");
+        let capacity = C_TEXT.with(|buffer| buffer.borrow().capacity());
+        with_text_format(format_args!("{} ({} ELIDED)", 1, 2), |text| {
+            assert_eq!(text, "1 (2 ELIDED)")
+        });
+        assert_eq!(C_TEXT.with(|buffer| buffer.borrow().capacity()), capacity);
+    }
+}
@@ -1,6 +1,9 @@
 //! Image and texture related functions
 use crate::core::color::Color;
+use crate::core::file::lock_static_buffers;
+use crate::core::image_ops::*;
 use crate::core::math::{Rectangle, Vector4};
+use crate::core::resample::Resampler;
 use crate::core::{RaylibHandle, RaylibThread};
 use crate::ffi;
 use std::ffi::CString;
@@ -45,6 +48,28 @@ impl Into<ffi::NPatchInfo> for &NPatchInfo {
     }
 }
 
+// Uncompressed pixel formats, their variant names differ across the generated bindings.
+pub(crate) const FORMAT_GRAYSCALE: i32 = 1;
+pub(crate) const FORMAT_R5G6B5: i32 = 3;
+pub(crate) const FORMAT_R5G5B5A1: i32 = 5;
+pub(crate) const FORMAT_R4G4B4A4: i32 = 6;
+pub(crate) const FORMAT_R8G8B8A8: i32 = 7;
+
+/// Allocates `count` values of `T` with `MemAlloc`, `None` if the size overflows raylib's `int`
+/// sizes or the allocation failed.
+pub(crate) fn mem_alloc<T>(count: usize) -> Option<*mut T> {
+    let size = count.checked_mul(std::mem::size_of::<T>())?;
+    if size > i32::MAX as usize {
+        return None;
+    }
+    let data = unsafe { ffi::MemAlloc(size as i32) };
+    if data.is_null() {
+        None
+    } else {
+        Some(data as *mut T)
+    }
+}
+
 fn no_drop<T>(_thing: T) {}
 make_thin_wrapper!(Image, ffi::Image, ffi::UnloadImage);
 make_thin_wrapper!(Texture2D, ffi::Texture2D, ffi::UnloadTexture);
@@ -56,6 +81,9 @@ make_thin_wrapper!(
 );
 make_thin_wrapper!(WeakRenderTexture2D, ffi::RenderTexture2D, no_drop);
 
+// Image pixels are in CPU memory, images can be loaded and processed on other threads
+unsafe impl Send for Image {}
+
 // Weak things can be clone
 impl Clone for WeakTexture2D {
     fn clone(&self) -> WeakTexture2D {
@@ -145,6 +173,45 @@ impl Image {
         unsafe { std::mem::transmute(i) }
     }
 
+    /// Pixels of an RGBA8 image without mipmaps, which the `image_ops` kernels process in
+    /// place. Other formats go through the C functions.
+    fn rgba8_pixels(&mut self) -> Option<&mut [Color]> {
+        if self.0.data.is_null()
+            || self.0.format != FORMAT_R8G8B8A8
+            || self.0.mipmaps != 1
+            || self.0.width <= 0
+            || self.0.height <= 0
+        {
+            return None;
+        }
+        let len = self.0.width as usize * self.0.height as usize;
+        Some(unsafe { std::slice::from_raw_parts_mut(self.0.data as *mut Color, len) })
+    }
+
+    /// Replaces the pixel data by `len` values allocated with `MemAlloc`, filled by `fill`
+    /// from the current pixels. The image is left untouched if the allocation fails.
+    fn replace_pixels<T>(
+        &mut self,
+        format: i32,
+        len: usize,
+        fill: impl FnOnce(&mut [Color], &mut [T]),
+    ) {
+        let pixels = match self.rgba8_pixels() {
+            Some(pixels) => pixels as *mut [Color],
+            None => return,
+        };
+        let data = match mem_alloc::<T>(len) {
+            Some(data) => data,
+            None => return,
+        };
+        unsafe {
+            fill(&mut *pixels, std::slice::from_raw_parts_mut(data, len));
+            ffi::MemFree(self.0.data);
+            self.0.data = data as *mut _;
+            self.0.format = format;
+        }
+    }
+
     #[inline]
     pub fn from_image(&self, rec: impl Into<ffi::Rectangle>) -> Image {
         unsafe { Image(ffi::ImageFromImage(self.0, rec.into())) }
@@ -154,6 +221,7 @@ impl Image {
     #[inline]
     pub fn export_image(&self, filename: &str) {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe {
             ffi::ExportImage(self.0, c_filename.as_ptr());
         }
@@ -163,6 +231,7 @@ impl Image {
     #[inline]
     pub fn export_image_as_code(&self, filename: &str) {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         unsafe {
             ffi::ExportImageAsCode(self.0, c_filename.as_ptr());
         }
@@ -242,6 +311,9 @@ impl Image {
     /// Premultiplies alpha channel on `image`.
     #[inline]
     pub fn alpha_premultiply(&mut self) {
+        if let Some(pixels) = self.rgba8_pixels() {
+            return premultiply_pixels(pixels);
+        }
         unsafe {
             ffi::ImageAlphaPremultiply(&mut self.0);
         }
@@ -263,6 +335,43 @@ impl Image {
         }
     }
 
+    /// Resizes `image` with `resampler` filter, reusing its cached weight tables. Mipmaps are
+    /// dropped. Formats other than RGBA8 are converted back and forth, compressed images are
+    /// left untouched.
+    pub fn resize_with(&mut self, resampler: &mut Resampler, new_width: i32, new_height: i32) {
+        if self.0.data.is_null() || new_width <= 0 || new_height <= 0 {
+            return;
+        }
+        let format = self.format();
+        if self.0.format != FORMAT_R8G8B8A8 {
+            unsafe {
+                ffi::ImageFormat(&mut self.0, FORMAT_R8G8B8A8);
+            }
+            if self.0.format != FORMAT_R8G8B8A8 {
+                return;
+            }
+        }
+
+        let (width, height) = (self.0.width as usize, self.0.height as usize);
+        let (new_width, new_height) = (new_width as usize, new_height as usize);
+        if let Some(data) = mem_alloc::<Color>(new_width * new_height) {
+            unsafe {
+                let src = std::slice::from_raw_parts(self.0.data as *const Color, width * height);
+                let dst = std::slice::from_raw_parts_mut(data, new_width * new_height);
+                resampler.resize(src, width, height, dst, new_width, new_height);
+
+                ffi::MemFree(self.0.data);
+                self.0.data = data as *mut _;
+            }
+            self.0.width = new_width as i32;
+            self.0.height = new_height as i32;
+            self.0.mipmaps = 1;
+        }
+        if self.0.format != format as i32 {
+            self.set_format(format);
+        }
+    }
+
     /// Resizes `image` (nearest-neighbor scaling).
     #[inline]
     pub fn resize_nn(&mut self, new_width: i32, new_height: i32) {
@@ -301,9 +410,52 @@ impl Image {
         }
     }
 
+    /// Generates all mipmap levels like [`Image::gen_mipmaps`], into one buffer with a box
+    /// filter run in parallel for large images. With `srgb` colors are averaged in linear
+    /// space. Formats other than RGBA8 go through `gen_mipmaps`.
+    pub fn gen_mipmaps_fast(&mut self, srgb: bool) {
+        if self.0.data.is_null()
+            || self.0.format != FORMAT_R8G8B8A8
+            || self.0.width <= 0
+            || self.0.height <= 0
+        {
+            return self.gen_mipmaps();
+        }
+
+        let (width, height) = (self.0.width as usize, self.0.height as usize);
+        let (levels, len) = mipmap_chain_size(width, height);
+        let data = match mem_alloc::<Color>(len) {
+            Some(data) => data,
+            None => return,
+        };
+        unsafe {
+            let chain = std::slice::from_raw_parts_mut(data, len);
+            let base = std::slice::from_raw_parts(self.0.data as *const Color, width * height);
+            chain[..base.len()].copy_from_slice(base);
+            gen_mipmap_chain(chain, width, height, srgb);
+
+            ffi::MemFree(self.0.data);
+            self.0.data = data as *mut _;
+        }
+        self.0.mipmaps = levels as i32;
+    }
+
     /// Dithers `image` data to 16bpp or lower (Floyd-Steinberg dithering).
     #[inline]
     pub fn dither(&mut self, r_bpp: i32, g_bpp: i32, b_bpp: i32, a_bpp: i32) {
+        let format = match (r_bpp, g_bpp, b_bpp, a_bpp) {
+            (5, 6, 5, 0) => Some(FORMAT_R5G6B5),
+            (5, 5, 5, 1) => Some(FORMAT_R5G5B5A1),
+            (4, 4, 4, 4) => Some(FORMAT_R4G4B4A4),
+            _ => None,
+        };
+        if let (Some(format), Some(_)) = (format, self.rgba8_pixels()) {
+            let (width, height) = (self.0.width as usize, self.0.height as usize);
+            let bpp = (r_bpp as u32, g_bpp as u32, b_bpp as u32, a_bpp as u32);
+            return self.replace_pixels(format, width * height, |pixels, out| {
+                dither_pixels(pixels, width, height, bpp, out)
+            });
+        }
         unsafe {
             ffi::ImageDither(&mut self.0, r_bpp, g_bpp, b_bpp, a_bpp);
         }
@@ -524,6 +676,10 @@ impl Image {
     /// Tints colors in `image` using specified `color`.
     #[inline]
     pub fn color_tint(&mut self, color: impl Into<ffi::Color>) {
+        let color = color.into();
+        if let Some(pixels) = self.rgba8_pixels() {
+            return tint_pixels(pixels, color.into());
+        }
         unsafe {
             ffi::ImageColorTint(&mut self.0, color.into());
         }
@@ -532,6 +688,9 @@ impl Image {
     /// Inverts the colors in `image`.
     #[inline]
     pub fn color_invert(&mut self) {
+        if let Some(pixels) = self.rgba8_pixels() {
+            return invert_pixels(pixels);
+        }
         unsafe {
             ffi::ImageColorInvert(&mut self.0);
         }
@@ -540,6 +699,12 @@ impl Image {
     /// Converts `image color to grayscale.
     #[inline]
     pub fn color_grayscale(&mut self) {
+        if let Some(pixels) = self.rgba8_pixels() {
+            let len = pixels.len();
+            return self.replace_pixels(FORMAT_GRAYSCALE, len, |pixels, out| {
+                grayscale_pixels(pixels, out)
+            });
+        }
         unsafe {
             ffi::ImageColorGrayscale(&mut self.0);
         }
@@ -548,6 +713,9 @@ impl Image {
     /// Adjusts the contrast of `image`.
     #[inline]
     pub fn color_contrast(&mut self, contrast: f32) {
+        if let Some(pixels) = self.rgba8_pixels() {
+            return contrast_pixels(pixels, contrast);
+        }
         unsafe {
             ffi::ImageColorContrast(&mut self.0, contrast);
         }
@@ -556,6 +724,9 @@ impl Image {
     /// Adjusts the brightness of `image`.
     #[inline]
     pub fn color_brightness(&mut self, brightness: i32) {
+        if let Some(pixels) = self.rgba8_pixels() {
+            return brightness_pixels(pixels, brightness);
+        }
         unsafe {
             ffi::ImageColorBrightness(&mut self.0, brightness);
         }
@@ -684,6 +855,7 @@ impl Image {
     /// Loads image from file into CPU memory (RAM).
     pub fn load_image(filename: &str) -> Result<Image, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let i = unsafe { ffi::LoadImage(c_filename.as_ptr()) };
         if i.data.is_null() {
             return Err(format!(
@@ -697,6 +869,7 @@ impl Image {
     pub fn load_image_from_mem(filetype: &str, bytes: &Vec<u8>, size: i32) -> Result<Image, String> {
         let c_filetype = CString::new(filetype).unwrap();
         let c_bytes = bytes.as_ptr();
+        let _lock = lock_static_buffers();
         let i = unsafe { ffi::LoadImageFromMemory(c_filetype.as_ptr(), c_bytes, size) };
         if i.data.is_null() {
             return Err(format!(
@@ -706,6 +879,23 @@ impl Image {
         Ok(Image(i))
     }
 
+    /// Decodes an image file held in memory, e.g. mapped with a
+    /// [`MappedFile`](crate::core::mapped::MappedFile), without copying it first.
+    pub fn load_image_from_bytes(filetype: &str, bytes: &[u8]) -> Result<Image, String> {
+        if bytes.len() > i32::MAX as usize {
+            return Err(format!("image data of {} bytes is too large", bytes.len()));
+        }
+        let c_filetype = CString::new(filetype).unwrap();
+        let _lock = lock_static_buffers();
+        let i = unsafe {
+            ffi::LoadImageFromMemory(c_filetype.as_ptr(), bytes.as_ptr(), bytes.len() as i32)
+        };
+        if i.data.is_null() {
+            return Err(format!("Image data is null. Check provided buffer data"));
+        };
+        Ok(Image(i))
+    }
+
     /// Loads image from RAW file data.
     pub fn load_image_raw(
         filename: &str,
@@ -855,6 +1045,7 @@ impl RaylibHandle {
     /// Loads texture from file into GPU memory (VRAM).
     pub fn load_texture(&mut self, _: &RaylibThread, filename: &str) -> Result<Texture2D, String> {
         let c_filename = CString::new(filename).unwrap();
+        let _lock = lock_static_buffers();
         let t = unsafe { ffi::LoadTexture(c_filename.as_ptr()) };
         if t.id == 0 {
             return Err(format!("failed to load {} as a texture.", filename));
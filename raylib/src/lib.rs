@@ -68,7 +68,6 @@ pub mod ffi {
 }
 
 pub use crate::core::collision::*;
-pub use crate::core::file::*;
 pub use crate::core::logging::*;
 pub use crate::core::misc::{get_random_value, open_url};
 pub use crate::core::*;
@@ -25,14 +25,26 @@ Permission is granted to anyone to use this software for any purpose, including
 //! ```
 
 pub use crate::consts::*;
+pub use crate::core::archive::*;
 pub use crate::core::audio::*;
+pub use crate::core::batch::*;
+pub use crate::core::broadphase::*;
+pub use crate::core::bvh::*;
 pub use crate::core::camera::*;
 pub use crate::core::color::*;
 pub use crate::core::data::*;
 pub use crate::core::drawing::*;
+pub use crate::core::encoder::*;
+pub use crate::core::frustum::*;
+pub use crate::core::image_ops::*;
+pub use crate::core::loader::*;
 pub use crate::core::logging::*;
+pub use crate::core::mapped::*;
 pub use crate::core::math::*;
+pub use crate::core::math_batch::*;
 pub use crate::core::models::*;
+pub use crate::core::recorder::*;
+pub use crate::core::resample::*;
 pub use crate::core::shaders::*;
 pub use crate::core::text::*;
 pub use crate::core::texture::*;
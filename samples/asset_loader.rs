@@ -0,0 +1,109 @@
+//! Asynchronous asset loading.
+//!
+//! Writes a set of noise textures as PNG files, then loads them while drawing: first with
+//! `load_texture`, one per frame on the render thread, then with an `AssetLoader` decoding on
+//! worker threads and uploading within a 2 ms budget per frame. Prints the worst and average
+//! frame times of both, and the loader counters while it runs.
+//! `cargo run --release --bin asset_loader [textures] [size] [workers]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::{Duration, Instant};
+
+fn draw_frame(rl: &mut RaylibHandle, thread: &RaylibThread, textures: &[Texture2D], label: &str) {
+    let mut d = rl.begin_drawing(thread);
+    d.clear_background(Color::RAYWHITE);
+    for (i, texture) in textures.iter().enumerate() {
+        let position = Vector2::new((i % 8) as f32 * 100.0, (i / 8) as f32 * 100.0 + 40.0);
+        let scale = 96.0 / texture.width().max(1) as f32;
+        d.draw_texture_ex(texture, position, 0.0, scale, Color::WHITE);
+    }
+    d.draw_text(label, 10, 10, 20, Color::BLACK);
+}
+
+fn report(name: &str, frame_times: &[Duration]) {
+    let worst = frame_times.iter().max().cloned().unwrap_or_default();
+    let total: Duration = frame_times.iter().sum();
+    println!(
+        "{:<14} {:>4} frames, worst {:>8.2} ms, average {:>6.2} ms",
+        name,
+        frame_times.len(),
+        worst.as_secs_f64() * 1000.0,
+        total.as_secs_f64() * 1000.0 / frame_times.len().max(1) as f64
+    );
+}
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let count = arg(1).unwrap_or(32) as usize;
+    let size = arg(2).unwrap_or(1024) as i32;
+    let workers = arg(3).unwrap_or(2) as usize;
+
+    let directory = std::env::temp_dir().join("raylib_asset_loader");
+    std::fs::create_dir_all(&directory).expect("could not create textures directory");
+    let files: Vec<String> = (0..count)
+        .map(|i| {
+            let file = directory.join(format!("noise_{:03}.png", i));
+            let file = file.to_string_lossy().into_owned();
+            if !std::path::Path::new(&file).exists() {
+                Image::gen_image_perlin_noise(size, size, i as i32 * size, 0, 4.0)
+                    .export_image(&file);
+            }
+            file
+        })
+        .collect();
+
+    let (mut rl, thread) = raylib::init().size(800, 480).title("Asset loader").build();
+
+    let mut textures = Vec::new();
+    let mut frame_times = Vec::new();
+    for file in &files {
+        if rl.window_should_close() {
+            return;
+        }
+        let start = Instant::now();
+        textures.push(
+            rl.load_texture(&thread, file)
+                .expect("could not load texture"),
+        );
+        draw_frame(&mut rl, &thread, &textures, "load_texture");
+        frame_times.push(start.elapsed());
+    }
+    report("load_texture", &frame_times);
+    textures.clear();
+
+    let mut loader = AssetLoader::new(workers);
+    let mut handles: Vec<_> = files.iter().map(|f| loader.load_texture(f)).collect();
+    let mut frame_times = Vec::new();
+    while !loader.is_idle() {
+        if rl.window_should_close() {
+            return;
+        }
+        let start = Instant::now();
+        loader.update(&mut rl, &thread, Duration::from_millis(2));
+        for handle in handles.iter_mut() {
+            if let Some(texture) = handle.take() {
+                textures.push(texture.expect("could not load texture"));
+            }
+        }
+        let stats = loader.stats();
+        let label = format!(
+            "AssetLoader: {} queued, {} decoding, {} uploading ({} KB), {} loaded",
+            stats.queued,
+            stats.decoding,
+            stats.uploading,
+            stats.uploading_bytes / 1024,
+            stats.loaded
+        );
+        draw_frame(&mut rl, &thread, &textures, &label);
+        frame_times.push(start.elapsed());
+    }
+    report("AssetLoader", &frame_times);
+    let stats = loader.stats();
+    println!(
+        "{} loaded ({} MB decoded), {} failed, {} cancelled",
+        stats.loaded,
+        stats.loaded_bytes >> 20,
+        stats.failed,
+        stats.cancelled
+    );
+}
@@ -0,0 +1,94 @@
+//! Render batch upload modes benchmark.
+//!
+//! Draws 200k sprites per frame through a custom render batch for every upload mode and layout
+//! and prints the average frame time. Run it on a software GL context with
+//! `LIBGL_ALWAYS_SOFTWARE=1 cargo run --release --bin batch_upload [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+const SPRITES: i32 = 200_000;
+
+fn main() {
+    let frames: u32 = std::env::args()
+        .nth(1)
+        .and_then(|f| f.parse().ok())
+        .unwrap_or(60);
+
+    let (mut rl, thread) = raylib::init()
+        .size(1280, 720)
+        .title("Batch upload modes")
+        .build();
+
+    let image = Image::gen_image_checked(8, 8, 2, 2, Color::WHITE, Color::GRAY);
+    let sprite = rl
+        .load_texture_from_image(&thread, &image)
+        .expect("could not load sprite texture");
+
+    let modes = [
+        (
+            "subdata x1",
+            1,
+            RenderBatchUploadMode::RL_BATCH_UPLOAD_SUBDATA,
+            RenderBatchLayout::RL_BATCH_LAYOUT_SEPARATE,
+        ),
+        (
+            "orphan x3",
+            3,
+            RenderBatchUploadMode::RL_BATCH_UPLOAD_ORPHAN,
+            RenderBatchLayout::RL_BATCH_LAYOUT_SEPARATE,
+        ),
+        (
+            "persistent x3",
+            3,
+            RenderBatchUploadMode::RL_BATCH_UPLOAD_PERSISTENT,
+            RenderBatchLayout::RL_BATCH_LAYOUT_SEPARATE,
+        ),
+        (
+            "interleaved x1",
+            1,
+            RenderBatchUploadMode::RL_BATCH_UPLOAD_SUBDATA,
+            RenderBatchLayout::RL_BATCH_LAYOUT_INTERLEAVED,
+        ),
+        (
+            "interleaved persistent x3",
+            3,
+            RenderBatchUploadMode::RL_BATCH_UPLOAD_PERSISTENT,
+            RenderBatchLayout::RL_BATCH_LAYOUT_INTERLEAVED,
+        ),
+    ];
+
+    for (name, buffers, mode, layout) in modes.iter() {
+        let mut batch = rl
+            .load_render_batch(&thread, *buffers, 8192, *mode, *layout)
+            .expect("could not load render batch");
+
+        let start = Instant::now();
+        for frame in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            let mut d = rl.begin_drawing(&thread);
+            d.clear_background(Color::BLACK);
+            {
+                let mut b = d.begin_render_batch(&mut batch);
+                for i in 0..SPRITES {
+                    let x = (i * 37 + frame as i32) % 1280;
+                    let y = (i * 91) % 720;
+                    b.draw_texture(&sprite, x, y, Color::new(i as u8, (i >> 3) as u8, 128, 255));
+                }
+            }
+            d.draw_fps(10, 10);
+            d.draw_render_stats(10, 40);
+        }
+        let elapsed = start.elapsed().as_secs_f64() * 1000.0 / frames as f64;
+
+        println!(
+            "{:<26} ({:?}) {:>8.2} ms/frame",
+            name,
+            batch.upload_mode(),
+            elapsed
+        );
+    }
+}
@@ -0,0 +1,129 @@
+//! 2D broad phase benchmark.
+//!
+//! Moves circles bouncing in a square world and finds the colliding ones with the pairwise
+//! O(n²) loop, with a `SpatialHash` and with `SweepAndPrune`, the narrow phase being
+//! `check_collision_circles`. Prints the average update, pairs and narrow phase times per frame.
+//! `cargo run --release --bin broadphase [bodies] [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::{Duration, Instant};
+
+const WORLD_SIZE: f32 = 4000.0;
+const MAX_RADIUS: f32 = 6.0;
+
+struct Bodies {
+    centers: Vec<Vector2>,
+    velocities: Vec<Vector2>,
+    radii: Vec<f32>,
+}
+
+impl Bodies {
+    fn new(count: usize) -> Bodies {
+        let mut state = 0x9e37_79b9u32;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            (state >> 8) as f32 / (1 << 24) as f32
+        };
+        let mut bodies = Bodies {
+            centers: Vec::with_capacity(count),
+            velocities: Vec::with_capacity(count),
+            radii: Vec::with_capacity(count),
+        };
+        for _ in 0..count {
+            bodies
+                .centers
+                .push(Vector2::new(next() * WORLD_SIZE, next() * WORLD_SIZE));
+            bodies
+                .velocities
+                .push(Vector2::new(next() * 4.0 - 2.0, next() * 4.0 - 2.0));
+            bodies.radii.push(2.0 + next() * (MAX_RADIUS - 2.0));
+        }
+        bodies
+    }
+
+    fn step(&mut self) {
+        for (c, v) in self.centers.iter_mut().zip(self.velocities.iter_mut()) {
+            *c += *v;
+            if c.x < 0.0 || c.x > WORLD_SIZE {
+                v.x = -v.x;
+            }
+            if c.y < 0.0 || c.y > WORLD_SIZE {
+                v.y = -v.y;
+            }
+        }
+    }
+
+    fn collide(&self, a: u32, b: u32) -> bool {
+        let (a, b) = (a as usize, b as usize);
+        check_collision_circles(
+            self.centers[a],
+            self.radii[a],
+            self.centers[b],
+            self.radii[b],
+        )
+    }
+}
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let count = arg(1).unwrap_or(50_000) as usize;
+    let frames = arg(2).unwrap_or(100) as u32;
+
+    // One frame only, it takes seconds with 50k bodies
+    let mut bodies = Bodies::new(count);
+    let start = Instant::now();
+    let mut collisions = 0;
+    for a in 0..count as u32 {
+        for b in a + 1..count as u32 {
+            collisions += bodies.collide(a, b) as usize;
+        }
+    }
+    println!(
+        "{:<16} {:>10.2} ms/frame {:>8} collisions",
+        "pairwise",
+        start.elapsed().as_secs_f64() * 1000.0,
+        collisions
+    );
+
+    let methods: Vec<(&str, Box<dyn BroadPhase2D>)> = vec![
+        ("SpatialHash", Box::new(SpatialHash::new(MAX_RADIUS * 2.0))),
+        ("SweepAndPrune", Box::new(SweepAndPrune::new())),
+    ];
+    for (name, mut broadphase) in methods {
+        bodies = Bodies::new(count);
+        let (mut update, mut pairs_time, mut narrow) = Default::default();
+        let (mut candidates, mut collisions) = (0, 0);
+        let mut pairs = Vec::new();
+
+        for _ in 0..frames {
+            bodies.step();
+
+            let start = Instant::now();
+            broadphase.update_circles(&bodies.centers, &bodies.radii);
+            update += start.elapsed();
+
+            let start = Instant::now();
+            broadphase.pairs(&mut pairs);
+            pairs_time += start.elapsed();
+            candidates += pairs.len();
+
+            let start = Instant::now();
+            collisions += pairs.iter().filter(|(a, b)| bodies.collide(*a, *b)).count();
+            narrow += start.elapsed();
+        }
+
+        let per_frame = |d: Duration| d.as_secs_f64() * 1000.0 / frames as f64;
+        println!(
+            "{:<16} {:>10.2} ms/frame {:>8} collisions ({:.2} ms update, {:.2} ms pairs, {:.2} ms narrow, {} candidates)",
+            name,
+            per_frame(update + pairs_time + narrow),
+            collisions / frames as usize,
+            per_frame(update),
+            per_frame(pairs_time),
+            per_frame(narrow),
+            candidates / frames as usize
+        );
+    }
+}
@@ -0,0 +1,89 @@
+//! Command list benchmark.
+//!
+//! Draws a scrolling 100x100 tile map every frame, first submitting every tile through the
+//! render batch and then replaying a command list recorded once, and prints draw calls, bytes
+//! uploaded and frame time for both.
+//! `cargo run --release --bin command_list [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+const MAP_SIZE: i32 = 100;
+const TILE: i32 = 16;
+
+/// Draws every tile of the map, picking one of the 4x4 atlas tiles from its position.
+fn draw_map<D: RaylibDraw>(d: &mut D, atlas: &Texture2D, offset: Vector2) {
+    for y in 0..MAP_SIZE {
+        for x in 0..MAP_SIZE {
+            let tile = (x * 7 + y * 13) % 16;
+            let source = Rectangle::new((tile % 4 * 8) as f32, (tile / 4 * 8) as f32, 8.0, 8.0);
+            let position = Vector2::new((x * TILE) as f32, (y * TILE) as f32) + offset;
+            d.draw_texture_pro(
+                atlas,
+                source,
+                Rectangle::new(position.x, position.y, TILE as f32, TILE as f32),
+                Vector2::default(),
+                0.0,
+                Color::WHITE,
+            );
+        }
+    }
+}
+
+fn main() {
+    let frames: u32 = std::env::args()
+        .nth(1)
+        .and_then(|f| f.parse().ok())
+        .unwrap_or(120);
+
+    let (mut rl, thread) = raylib::init().size(1280, 720).title("Command list").build();
+
+    let image = Image::gen_image_checked(32, 32, 4, 4, Color::WHITE, Color::DARKGREEN);
+    let atlas = rl
+        .load_texture_from_image(&thread, &image)
+        .expect("could not load tile atlas");
+
+    let mut map = rl.load_command_list(&thread);
+    {
+        let mut d = rl.begin_drawing(&thread);
+        let mut r = d.begin_command_list(&mut map);
+        draw_map(&mut r, &atlas, Vector2::default());
+    }
+
+    for replayed in [false, true].iter() {
+        let mut draw_calls = 0;
+        let mut bytes = 0;
+        let start = Instant::now();
+
+        for frame in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            let scroll = Vector2::new(-(((frame * 4) % 320) as f32), -(((frame * 2) % 880) as f32));
+            {
+                let mut d = rl.begin_drawing(&thread);
+                d.clear_background(Color::BLACK);
+
+                if *replayed {
+                    d.draw_command_list(&map, Matrix::translate(scroll.x, scroll.y, 0.0));
+                } else {
+                    draw_map(&mut d, &atlas, scroll);
+                }
+            }
+
+            let stats = rl.render_stats();
+            draw_calls += stats.drawCalls;
+            bytes += stats.bytesUploaded;
+        }
+        let elapsed = start.elapsed().as_secs_f64() * 1000.0 / frames as f64;
+
+        println!(
+            "{:<10} {:>6} draw calls/frame {:>9} bytes uploaded/frame {:>8.2} ms/frame",
+            if *replayed { "replayed" } else { "immediate" },
+            draw_calls / frames,
+            bytes / frames,
+            elapsed
+        );
+    }
+}
@@ -0,0 +1,108 @@
+//! Frustum culling benchmark.
+//!
+//! Draws a grid of cubes around a rotating camera with one `draw_model` call per cube, with
+//! `draw_model_culled`, and with a single `cull_boxes` pass before drawing the visible cubes,
+//! and prints the average frame time, culling time and drawn cubes count of each.
+//! `cargo run --release --bin frustum_culling [side] [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::{Duration, Instant};
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let side = arg(1).unwrap_or(100) as i32;
+    let frames = arg(2).unwrap_or(120) as u32;
+
+    let (mut rl, thread) = raylib::init()
+        .size(1280, 720)
+        .title("Frustum culling")
+        .build();
+
+    let cube = Mesh::gen_mesh_cube(&thread, 0.5, 0.5, 0.5);
+    let bounds = cube.mesh_bounding_box();
+    let model = rl
+        .load_model_from_mesh(&thread, unsafe { cube.make_weak() })
+        .expect("could not load cube model");
+
+    let positions: Vec<Vector3> = (0..side * side)
+        .map(|i| {
+            let half = side as f32 / 2.0;
+            Vector3::new((i % side) as f32 - half, 0.0, (i / side) as f32 - half)
+        })
+        .collect();
+    let mut boxes = vec![bounds; positions.len()];
+    let mut visible = VisibilitySet::new();
+
+    for method in ["draw_model", "draw_model_culled", "cull_boxes"].iter() {
+        let mut culling = Duration::default();
+        let mut drawn = 0;
+        let start = Instant::now();
+
+        for frame in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            let angle = frame as f32 * 0.02;
+            let camera = Camera3D::perspective(
+                Vector3::new(0.0, 4.0, 0.0),
+                Vector3::new(angle.cos(), 3.0, angle.sin()),
+                Vector3::up(),
+                60.0,
+            );
+            let aspect = rl.get_screen_width() as f32 / rl.get_screen_height() as f32;
+            let frustum = Frustum::from_camera(&camera, aspect);
+
+            let mut d = rl.begin_drawing(&thread);
+            d.clear_background(Color::RAYWHITE);
+            {
+                let mut d3 = d.begin_mode3D(camera);
+                match *method {
+                    "draw_model_culled" => {
+                        for p in positions.iter() {
+                            if d3.draw_model_culled(
+                                &frustum,
+                                &model,
+                                &bounds,
+                                p,
+                                1.0,
+                                Color::SKYBLUE,
+                            ) {
+                                drawn += 1;
+                            }
+                        }
+                    }
+                    "cull_boxes" => {
+                        let cull = Instant::now();
+                        for (b, p) in boxes.iter_mut().zip(positions.iter()) {
+                            *b = BoundingBox::new(bounds.min + *p, bounds.max + *p);
+                        }
+                        frustum.cull_boxes(&boxes, &mut visible);
+                        culling += cull.elapsed();
+
+                        for i in visible.iter_visible() {
+                            d3.draw_model(&model, positions[i], 1.0, Color::SKYBLUE);
+                        }
+                        drawn += visible.count_visible();
+                    }
+                    _ => {
+                        for p in positions.iter() {
+                            d3.draw_model(&model, p, 1.0, Color::SKYBLUE);
+                        }
+                        drawn += positions.len();
+                    }
+                }
+            }
+            d.draw_fps(10, 10);
+            d.draw_render_stats(10, 40);
+        }
+
+        println!(
+            "{:<18} {:>8.2} ms/frame {:>8.3} ms culling {:>8} cubes/frame",
+            method,
+            start.elapsed().as_secs_f64() * 1000.0 / frames as f64,
+            culling.as_secs_f64() * 1000.0 / frames as f64,
+            drawn / frames as usize
+        );
+    }
+}
@@ -0,0 +1,99 @@
+//! Image color adjustments benchmark.
+//!
+//! Runs every `Image` color adjustment on an RGBA8 image through the raylib C function and
+//! through the native `image_ops` kernels the `Image` methods now use, and prints the
+//! average time of both. No window is opened.
+//! `cargo run --release --bin image_ops_bench [size] [rounds]`.
+extern crate raylib;
+use raylib::ffi;
+use raylib::prelude::*;
+use std::time::Instant;
+
+fn bench(
+    name: &str,
+    source: &Image,
+    rounds: u32,
+    c: impl Fn(&mut ffi::Image),
+    rust: impl Fn(&mut Image),
+) {
+    let time = |f: &dyn Fn(&mut Image)| {
+        let mut elapsed = 0.0;
+        for _ in 0..rounds {
+            let mut image = source.clone();
+            let start = Instant::now();
+            f(&mut image);
+            elapsed += start.elapsed().as_secs_f64();
+        }
+        elapsed * 1000.0 / rounds as f64
+    };
+    let c_time = time(&|image| c(image.as_mut()));
+    let rust_time = time(&|image| rust(image));
+    println!(
+        "{:<18} {:>9.2} ms C {:>9.2} ms native {:>6.1}x",
+        name,
+        c_time,
+        rust_time,
+        c_time / rust_time
+    );
+}
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let size = arg(1).unwrap_or(8192) as i32;
+    let rounds = arg(2).unwrap_or(3) as u32;
+
+    let mut source =
+        Image::gen_image_gradient_radial(size, size, 0.2, Color::ORANGE, Color::DARKBLUE);
+    source.set_format(PixelFormat::PIXELFORMAT_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    println!("{}x{} RGBA8, average of {} rounds", size, size, rounds);
+
+    bench(
+        "color_tint",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageColorTint(i, Color::SKYBLUE.into()) },
+        |i| i.color_tint(Color::SKYBLUE),
+    );
+    bench(
+        "color_invert",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageColorInvert(i) },
+        |i| i.color_invert(),
+    );
+    bench(
+        "color_grayscale",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageColorGrayscale(i) },
+        |i| i.color_grayscale(),
+    );
+    bench(
+        "color_contrast",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageColorContrast(i, 40.0) },
+        |i| i.color_contrast(40.0),
+    );
+    bench(
+        "color_brightness",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageColorBrightness(i, -30) },
+        |i| i.color_brightness(-30),
+    );
+    bench(
+        "alpha_premultiply",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageAlphaPremultiply(i) },
+        |i| i.alpha_premultiply(),
+    );
+    bench(
+        "dither",
+        &source,
+        rounds,
+        |i| unsafe { ffi::ImageDither(i, 5, 6, 5, 0) },
+        |i| i.dither(5, 6, 5, 0),
+    );
+}
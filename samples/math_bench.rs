@@ -0,0 +1,180 @@
+//! Math operators benchmark.
+//!
+//! Runs every SIMD backed `Matrix`, `Vector3` and `Quaternion` operator over a working set of
+//! values, then the bulk kernels of `math_batch` over 100k points and the ray casts of
+//! `TriangleSoa` against 4096 triangles, and prints the average time per operation. Compare the implementations with
+//! `cargo run --release --bin math_bench [iterations]`,
+//! `cargo run --release --features raylib/scalar_math --bin math_bench` and
+//! `RUSTFLAGS="-C target-cpu=native" cargo run --release --bin math_bench`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::hint::black_box;
+use std::time::Instant;
+
+const VALUES: usize = 1024;
+const POINTS: usize = 100_000;
+const TRIANGLES: usize = 4096;
+const RAYS: usize = 256;
+
+fn bench<T>(name: &str, iterations: usize, mut op: impl FnMut(usize) -> T) {
+    let start = Instant::now();
+    for i in 0..iterations {
+        black_box(op(black_box(i % VALUES)));
+    }
+    let elapsed = start.elapsed().as_secs_f64() * 1e9 / iterations as f64;
+    println!("{:<24} {:>8.2} ns/op", name, elapsed);
+}
+
+/// Runs `op` `rounds` times and prints the average time per point.
+fn bench_bulk(name: &str, rounds: usize, mut op: impl FnMut()) {
+    let start = Instant::now();
+    for _ in 0..rounds {
+        op();
+    }
+    let elapsed = start.elapsed().as_secs_f64() * 1e9 / (rounds * POINTS) as f64;
+    println!("{:<24} {:>8.2} ns/point", name, elapsed);
+}
+
+/// Runs `op` `rounds` times and prints the average time per ray triangle test.
+fn bench_rays(name: &str, rounds: usize, mut op: impl FnMut()) {
+    let start = Instant::now();
+    for _ in 0..rounds {
+        op();
+    }
+    let elapsed = start.elapsed().as_secs_f64() * 1e9 / (rounds * RAYS * TRIANGLES) as f64;
+    println!("{:<24} {:>8.2} ns/test", name, elapsed);
+}
+
+fn main() {
+    let iterations = std::env::args()
+        .nth(1)
+        .and_then(|i| i.parse().ok())
+        .unwrap_or(10_000_000);
+
+    let matrices: Vec<Matrix> = (0..VALUES)
+        .map(|i| {
+            let f = i as f32;
+            Matrix::rotate(Vector3::new(1.0, f, 2.0).normalized(), f * 0.1)
+                * Matrix::scale(1.0 + f * 0.01, 2.0, 0.5)
+                * Matrix::translate(f, -f, f * 0.5)
+        })
+        .collect();
+    let vectors: Vec<Vector3> = (0..VALUES)
+        .map(|i| Vector3::new(i as f32, (i * 3) as f32, -(i as f32)))
+        .collect();
+    let quaternions: Vec<Quaternion> = (0..VALUES)
+        .map(|i| Quaternion::from_euler(i as f32 * 0.01, i as f32 * 0.02, i as f32 * 0.03))
+        .collect();
+    let next = |i: usize| (i + 1) % VALUES;
+
+    bench("Matrix + Matrix", iterations, |i| {
+        matrices[i] + matrices[next(i)]
+    });
+    bench("Matrix - Matrix", iterations, |i| {
+        matrices[i] - matrices[next(i)]
+    });
+    bench("Matrix * Matrix", iterations, |i| {
+        matrices[i] * matrices[next(i)]
+    });
+    bench("Matrix::transposed", iterations, |i| {
+        matrices[i].transposed()
+    });
+    bench("Matrix::inverted", iterations, |i| matrices[i].inverted());
+    bench("Vector3::transform_with", iterations, |i| {
+        vectors[i].transform_with(matrices[next(i)])
+    });
+    bench("Quaternion * Quaternion", iterations, |i| {
+        quaternions[i] * quaternions[next(i)]
+    });
+    bench("Quaternion::transform", iterations, |i| {
+        quaternions[i].transform(matrices[next(i)])
+    });
+    bench("Quaternion::lerp", iterations, |i| {
+        quaternions[i].lerp(quaternions[next(i)], 0.3)
+    });
+    bench("Quaternion::nlerp", iterations, |i| {
+        quaternions[i].nlerp(quaternions[next(i)], 0.3)
+    });
+    bench("Quaternion::slerp", iterations, |i| {
+        quaternions[i].slerp(quaternions[(i + 37) % VALUES], 0.3)
+    });
+
+    let rounds = (iterations / POINTS).max(10);
+    let mat = matrices[1];
+    let points: Vec<Vector3> = (0..POINTS).map(|i| vectors[i % VALUES]).collect();
+    let targets: Vec<Vector3> = points.iter().map(|p| *p * 2.0).collect();
+    let mut out = vec![Vector3::zero(); POINTS];
+    let mut soa = Vec3Soa::from_slice(&points);
+
+    bench_bulk("transform_with loop", rounds, || {
+        for (o, p) in out.iter_mut().zip(&points) {
+            *o = p.transform_with(mat);
+        }
+        black_box(&out);
+    });
+    bench_bulk("transform_points", rounds, || {
+        transform_points(&mat, &points, &mut out);
+        black_box(&out);
+    });
+    bench_bulk("par_transform_points", rounds, || {
+        par_transform_points(&mat, &points, &mut out);
+        black_box(&out);
+    });
+    bench_bulk("Vec3Soa::transform", rounds, || {
+        soa.transform(&mat);
+        black_box(&soa);
+    });
+    bench_bulk("Vec3Soa::par_transform", rounds, || {
+        soa.par_transform(&mat);
+        black_box(&soa);
+    });
+    bench_bulk("normalize_all", rounds, || {
+        normalize_all(&mut out);
+        black_box(&out);
+    });
+    bench_bulk("lerp_all", rounds, || {
+        lerp_all(&points, &targets, 0.3, &mut out);
+        black_box(&out);
+    });
+
+    let rounds = (iterations / (RAYS * TRIANGLES)).max(2);
+    let triangles: Vec<[Vector3; 3]> = (0..TRIANGLES)
+        .map(|i| {
+            let v = vectors[i % VALUES] * 10.0;
+            [
+                v,
+                v + vectors[(i + 1) % VALUES],
+                v + vectors[(i + 2) % VALUES],
+            ]
+        })
+        .collect();
+    let rays: Vec<Ray> = (0..RAYS)
+        .map(|i| Ray {
+            position: vectors[i % VALUES] * 20.0,
+            direction: vectors[(i + 3) % VALUES],
+        })
+        .collect();
+    let triangle_soa = TriangleSoa::from_triangles(&triangles);
+    let mut hits = vec![RayHitInfo::default(); RAYS];
+
+    bench_rays("get_collision_ray_triangle", rounds, || {
+        for (h, ray) in hits.iter_mut().zip(&rays) {
+            *h = RayHitInfo::default();
+            for [a, b, c] in triangles.iter() {
+                let hit = get_collision_ray_triangle(*ray, a, b, c);
+                if hit.hit && (!h.hit || hit.distance < h.distance) {
+                    *h = hit;
+                }
+            }
+        }
+        black_box(&hits);
+    });
+    bench_rays("TriangleSoa::raycast_all", rounds, || {
+        triangle_soa.raycast_all(&rays, &mut hits);
+        black_box(&hits);
+    });
+    bench_rays("par_raycast_all", rounds, || {
+        triangle_soa.par_raycast_all(&rays, &mut hits);
+        black_box(&hits);
+    });
+}
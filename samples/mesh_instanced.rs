@@ -0,0 +1,112 @@
+//! Instanced mesh drawing benchmark.
+//!
+//! Draws a grid of cubes once with one `draw_model` call per cube and once with a single
+//! `draw_mesh_instanced` call, and prints the average frame time of both.
+//! `cargo run --release --bin mesh_instanced [side] [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+const INSTANCING_VS: &str = r#"
+#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+out vec2 fragTexCoord;
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    gl_Position = mvp*instanceTransform*vec4(vertexPosition, 1.0);
+}
+"#;
+
+const INSTANCING_FS: &str = r#"
+#version 330
+in vec2 fragTexCoord;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = texture(texture0, fragTexCoord)*colDiffuse;
+}
+"#;
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let side = arg(1).unwrap_or(100) as i32;
+    let frames = arg(2).unwrap_or(120) as u32;
+
+    let (mut rl, thread) = raylib::init()
+        .size(1280, 720)
+        .title("Mesh instancing")
+        .build();
+
+    let camera = Camera3D::perspective(
+        Vector3::new(side as f32, side as f32 * 0.75, side as f32),
+        Vector3::new(side as f32 / 2.0, 0.0, side as f32 / 2.0),
+        Vector3::new(0.0, 1.0, 0.0),
+        45.0,
+    );
+
+    let cube = Mesh::gen_mesh_cube(&thread, 0.5, 0.5, 0.5);
+    let model = rl
+        .load_model_from_mesh(&thread, unsafe { cube.make_weak() })
+        .expect("could not load cube model");
+
+    let mut shader = rl.load_shader_from_memory(&thread, Some(INSTANCING_VS), Some(INSTANCING_FS));
+    let transform_loc = shader.get_shader_location_attribute("instanceTransform");
+    shader.locs_mut()[ShaderLocationIndex::SHADER_LOC_MATRIX_MODEL as usize] = transform_loc;
+
+    let mut material = rl.load_material_default(&thread);
+    *material.shader_mut() = unsafe { shader.make_weak() };
+    material.maps_mut()[MaterialMapIndex::MATERIAL_MAP_ALBEDO as usize].color =
+        Color::SKYBLUE.into();
+
+    let positions: Vec<Vector3> = (0..side * side)
+        .map(|i| Vector3::new((i % side) as f32, 0.0, (i / side) as f32))
+        .collect();
+    let mut transforms = vec![Matrix::identity(); positions.len()];
+
+    for instanced in [false, true].iter() {
+        let start = Instant::now();
+
+        for frame in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            let mut d = rl.begin_drawing(&thread);
+            d.clear_background(Color::RAYWHITE);
+            {
+                let mut d3 = d.begin_mode3D(camera);
+                let wave = |p: &Vector3| ((p.x + p.z) * 0.2 + frame as f32 * 0.1).sin() * 0.5;
+
+                if *instanced {
+                    for (t, p) in transforms.iter_mut().zip(positions.iter()) {
+                        *t = Matrix::translate(p.x, wave(p), p.z);
+                    }
+                    d3.draw_mesh_instanced(&model.meshes()[0], &material, &transforms);
+                } else {
+                    for p in positions.iter() {
+                        let position = Vector3::new(p.x, wave(p), p.z);
+                        d3.draw_model(&model, position, 1.0, Color::SKYBLUE);
+                    }
+                }
+            }
+            d.draw_fps(10, 10);
+        }
+
+        println!(
+            "{:<18} {:>6} cubes {:>8.2} ms/frame",
+            if *instanced {
+                "draw_mesh_instanced"
+            } else {
+                "draw_model"
+            },
+            positions.len(),
+            start.elapsed().as_secs_f64() * 1000.0 / frames as f64
+        );
+    }
+}
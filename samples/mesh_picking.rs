@@ -0,0 +1,88 @@
+//! Mesh picking benchmark.
+//!
+//! Picks a dense sphere under the mouse with `get_collision_ray_model` and with a `MeshBvh`,
+//! shows the hit and prints the BVH build time and the average time per ray of both.
+//! `cargo run --release --bin mesh_picking [rings] [rays]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let rings = arg(1).unwrap_or(500) as i32;
+    let rays = arg(2).unwrap_or(1000) as usize;
+
+    let (mut rl, thread) = raylib::init().size(1280, 720).title("Mesh picking").build();
+
+    let mut camera = Camera3D::perspective(
+        Vector3::new(3.0, 2.0, 3.0),
+        Vector3::zero(),
+        Vector3::up(),
+        45.0,
+    );
+    rl.set_camera_mode(&camera, CameraMode::CAMERA_ORBITAL);
+
+    let sphere = Mesh::gen_mesh_sphere(&thread, 1.0, rings, rings);
+    let model = rl
+        .load_model_from_mesh(&thread, unsafe { sphere.make_weak() })
+        .expect("could not load sphere model");
+
+    let start = Instant::now();
+    let bvh = MeshBvh::from_model(&model);
+    println!(
+        "MeshBvh build            {:>8.2} ms, {} triangles, {} nodes",
+        start.elapsed().as_secs_f64() * 1000.0,
+        bvh.triangle_count(),
+        bvh.node_count()
+    );
+
+    // Rays around the sphere, same set for both methods
+    let test_rays: Vec<Ray> = (0..rays)
+        .map(|i| {
+            let a = i as f32 * 0.37;
+            Ray {
+                position: Vector3::new(a.cos() * 3.0, (a * 0.5).sin(), a.sin() * 3.0),
+                direction: Vector3::new(-a.cos(), -(a * 0.5).sin() * 0.3, -a.sin()),
+            }
+        })
+        .collect();
+
+    let start = Instant::now();
+    let model_hits = test_rays
+        .iter()
+        .filter(|r| get_collision_ray_model(**r, &model).hit)
+        .count();
+    let model_time = start.elapsed().as_secs_f64() * 1e6 / rays as f64;
+
+    let start = Instant::now();
+    let bvh_hits = test_rays.iter().filter(|r| bvh.raycast(**r).hit).count();
+    let bvh_time = start.elapsed().as_secs_f64() * 1e6 / rays as f64;
+
+    println!(
+        "get_collision_ray_model  {:>8.2} us/ray, {} hits",
+        model_time, model_hits
+    );
+    println!(
+        "MeshBvh::raycast         {:>8.2} us/ray, {} hits",
+        bvh_time, bvh_hits
+    );
+
+    while !rl.window_should_close() {
+        rl.update_camera(&mut camera);
+        let ray = rl.get_mouse_ray(rl.get_mouse_position(), camera);
+        let hit = bvh.raycast(ray);
+
+        let mut d = rl.begin_drawing(&thread);
+        d.clear_background(Color::RAYWHITE);
+        {
+            let mut d3 = d.begin_mode3D(camera);
+            d3.draw_model(&model, Vector3::zero(), 1.0, Color::LIGHTGRAY);
+            d3.draw_model_wires(&model, Vector3::zero(), 1.0, Color::GRAY);
+            if hit.hit {
+                d3.draw_sphere(hit.position, 0.03, Color::RED);
+                d3.draw_line_3D(hit.position, hit.position + hit.normal * 0.3, Color::RED);
+            }
+        }
+        d.draw_fps(10, 10);
+    }
+}
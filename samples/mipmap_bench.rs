@@ -0,0 +1,44 @@
+//! Mipmap generation benchmark.
+//!
+//! Generates the full mip chain of an RGBA8 image with `Image::gen_mipmaps` (raylib C) and with
+//! `Image::gen_mipmaps_fast`, averaging in gamma space and in linear space, and prints the
+//! average time of each. No window is opened.
+//! `cargo run --release --bin mipmap_bench [size] [rounds]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let size = arg(1).unwrap_or(4096) as i32;
+    let rounds = arg(2).unwrap_or(5) as u32;
+
+    let mut source =
+        Image::gen_image_gradient_radial(size, size, 0.2, Color::ORANGE, Color::DARKBLUE);
+    source.set_format(PixelFormat::PIXELFORMAT_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    println!("{}x{} RGBA8, average of {} rounds", size, size, rounds);
+
+    let bench = |name: &str, gen: &dyn Fn(&mut Image)| {
+        let mut elapsed = 0.0;
+        let mut mipmaps = 0;
+        for _ in 0..rounds {
+            let mut image = source.clone();
+            let start = Instant::now();
+            gen(&mut image);
+            elapsed += start.elapsed().as_secs_f64();
+            mipmaps = image.mipmaps();
+        }
+        println!(
+            "{:<24} {:>9.2} ms {:>3} levels",
+            name,
+            elapsed * 1000.0 / rounds as f64,
+            mipmaps
+        );
+    };
+
+    bench("gen_mipmaps", &|image| image.gen_mipmaps());
+    bench("gen_mipmaps_fast", &|image| image.gen_mipmaps_fast(false));
+    bench("gen_mipmaps_fast (sRGB)", &|image| {
+        image.gen_mipmaps_fast(true)
+    });
+}
@@ -0,0 +1,112 @@
+//! Memory-mapped texture loading benchmark.
+//!
+//! Writes a pack of raw RGBA8 images (2 GB by default, kept for later runs), then uploads
+//! every image as a texture twice: read into a buffer and copied into an `Image` like
+//! `load_image_raw` does, then straight from a `MappedFile` through `ImageView`s. Prints the
+//! time and throughput of each. For cold cache numbers, drop the page cache before a run
+//! (`echo 3 > /proc/sys/vm/drop_caches`) and pass the method to run alone.
+//! `cargo run --release --bin mmap_bench [size MB] [read|mmap|both] [pack path]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::fs::File;
+use std::io::{Read, Seek, SeekFrom, Write};
+use std::time::Instant;
+
+const MAGIC: &[u8; 8] = b"RLRAWPK\0";
+const HEADER_SIZE: usize = 4096;
+const SIZE: i32 = 1024;
+const IMAGE_SIZE: usize = (SIZE * SIZE * 4) as usize;
+
+/// Pack layout: a header page (magic, image count), then page aligned RGBA8 images.
+fn write_pack(path: &str, count: usize) -> std::io::Result<()> {
+    let mut file = std::io::BufWriter::new(File::create(path)?);
+    let mut header = vec![0u8; HEADER_SIZE];
+    header[..8].copy_from_slice(MAGIC);
+    header[8..12].copy_from_slice(&(count as u32).to_le_bytes());
+    file.write_all(&header)?;
+    let mut pixels = vec![0u8; IMAGE_SIZE];
+    for i in 0..count {
+        for (j, p) in pixels.chunks_exact_mut(4).enumerate() {
+            p.copy_from_slice(&[(j + i) as u8, (j >> 10) as u8, i as u8, 255]);
+        }
+        file.write_all(&pixels)?;
+    }
+    file.flush()
+}
+
+fn pack_count(header: &[u8]) -> Option<usize> {
+    if header.len() < 12 || &header[..8] != MAGIC {
+        return None;
+    }
+    let mut count = [0; 4];
+    count.copy_from_slice(&header[8..12]);
+    Some(u32::from_le_bytes(count) as usize)
+}
+
+fn report(name: &str, count: usize, seconds: f64) {
+    let mb = (count * IMAGE_SIZE) as f64 / (1 << 20) as f64;
+    println!(
+        "{:<6} {:>5} textures {:>9.1} ms {:>8.1} MB/s",
+        name,
+        count,
+        seconds * 1000.0,
+        mb / seconds
+    );
+}
+
+fn main() {
+    let args: Vec<String> = std::env::args().collect();
+    let size_mb: usize = args.get(1).and_then(|a| a.parse().ok()).unwrap_or(2048);
+    let method = args.get(2).map(String::as_str).unwrap_or("both");
+    let path = args
+        .get(3)
+        .cloned()
+        .unwrap_or_else(|| "mmap_bench.pack".to_string());
+
+    let count = (size_mb << 20) / IMAGE_SIZE;
+    // The pack is only written before being mapped
+    let existing = unsafe { MappedFile::open(&path) }
+        .ok()
+        .and_then(|pack| pack_count(pack.as_bytes()));
+    if existing != Some(count) {
+        println!("writing {} MB pack to {}", size_mb, path);
+        write_pack(&path, count).expect("could not write pack");
+    }
+
+    let (mut rl, thread) = raylib::init()
+        .size(640, 360)
+        .title("Memory-mapped loading")
+        .build();
+    let rgba8 = PixelFormat::PIXELFORMAT_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    if method != "mmap" {
+        let mut file = File::open(&path).expect("could not open pack");
+        let start = Instant::now();
+        for i in 0..count {
+            let mut data = vec![0u8; IMAGE_SIZE];
+            file.seek(SeekFrom::Start((HEADER_SIZE + i * IMAGE_SIZE) as u64))
+                .and_then(|_| file.read_exact(&mut data))
+                .expect("could not read pack");
+            let image = ImageView::new(&data, SIZE, SIZE, 1, rgba8)
+                .and_then(|view| view.to_image())
+                .expect("could not copy image");
+            rl.load_texture_from_image(&thread, &image)
+                .expect("could not load texture");
+        }
+        report("read", count, start.elapsed().as_secs_f64());
+    }
+
+    if method != "read" {
+        let start = Instant::now();
+        let pack = unsafe { MappedFile::open(&path) }.expect("could not map pack");
+        for i in 0..count {
+            let offset = HEADER_SIZE + i * IMAGE_SIZE;
+            pack.prefetch(offset + IMAGE_SIZE..offset + 2 * IMAGE_SIZE);
+            let data = pack.bytes(offset..offset + IMAGE_SIZE).unwrap();
+            let view = ImageView::new(data, SIZE, SIZE, 1, rgba8).unwrap();
+            rl.load_texture_from_view(&thread, &view)
+                .expect("could not load texture");
+        }
+        report("mmap", count, start.elapsed().as_secs_f64());
+    }
+}
@@ -0,0 +1,54 @@
+//! Draw submission benchmark on the rlgl null backend.
+//!
+//! No window nor GPU is required: OpenGL calls are recorded instead of issued, so the frame time
+//! only measures `RaylibDraw` submission. Prints the recorded draw calls and uploads per frame.
+//! `cargo run --release --features null_backend --bin null_submission [sprites] [frames]`.
+extern crate raylib;
+use raylib::consts::NullCommandType::*;
+use raylib::prelude::*;
+use std::time::Instant;
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let count = arg(1).unwrap_or(100_000) as i32;
+    let frames = arg(2).unwrap_or(120) as u32;
+
+    let (mut rl, thread) = raylib::init().size(1280, 720).build();
+
+    let image = Image::gen_image_checked(16, 16, 4, 4, Color::WHITE, Color::GRAY);
+    let sprite = rl
+        .load_texture_from_image(&thread, &image)
+        .expect("could not load sprite texture");
+
+    for text in [false, true].iter() {
+        let start = Instant::now();
+        for frame in 0..frames {
+            let mut d = rl.begin_drawing(&thread);
+            d.clear_background(Color::BLACK);
+            for i in 0..count {
+                let x = (i * 37 + frame as i32) % 1280;
+                let y = (i * 91) % 720;
+                d.draw_texture(&sprite, x, y, Color::WHITE);
+                if *text && i % 100 == 0 {
+                    d.draw_text("label", x, y, 10, Color::BLACK);
+                }
+            }
+        }
+        let elapsed = start.elapsed().as_secs_f64() * 1000.0 / frames as f64;
+
+        // Commands of the last frame
+        let commands = rl.null_commands();
+        let uploaded: i32 = commands
+            .iter()
+            .filter(|c| c.type_ == RL_NULL_COMMAND_BUFFER_UPLOAD as i32)
+            .map(|c| c.size)
+            .sum();
+        println!(
+            "{:<12} {:>6} draw calls/frame {:>10} bytes uploaded/frame {:>8.2} ms/frame",
+            if *text { "with labels" } else { "sprites" },
+            rl.null_draw_calls_count(),
+            uploaded,
+            elapsed
+        );
+    }
+}
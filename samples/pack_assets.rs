@@ -0,0 +1,69 @@
+//! Asset archive builder.
+//!
+//! Packs every file under a directory into an asset archive that `Archive::install` makes raylib
+//! read instead of loose files. Entry paths are the file paths relative to the directory,
+//! prefixed with `--prefix` (the directory itself by default), so they match the paths the game
+//! loads. `--list` prints the entries of an existing archive.
+//! `cargo run --release --bin pack_assets <directory> <archive> [--compress] [--align N] [--prefix P]`.
+extern crate raylib;
+use raylib::prelude::*;
+
+fn usage() -> ! {
+    eprintln!("usage: pack_assets <directory> <archive> [--compress] [--align N] [--prefix P]");
+    eprintln!("       pack_assets --list <archive>");
+    std::process::exit(2)
+}
+
+fn main() {
+    let args: Vec<String> = std::env::args().skip(1).collect();
+    if args.first().map(String::as_str) == Some("--list") {
+        let path = args.get(1).unwrap_or_else(|| usage());
+        // Archives are only read here
+        let archive = unsafe { Archive::open(path) }.unwrap_or_else(|e| {
+            eprintln!("{}: {}", path, e);
+            std::process::exit(1)
+        });
+        for entry in archive.entries() {
+            println!(
+                "{:>10} {:>10} {}{}",
+                entry.size,
+                entry.stored_size,
+                entry.path,
+                if entry.compressed { " (deflate)" } else { "" }
+            );
+        }
+        return;
+    }
+
+    let (mut positional, mut compress, mut align, mut prefix) = (Vec::new(), false, 16, None);
+    let mut args = args.into_iter();
+    while let Some(arg) = args.next() {
+        match arg.as_str() {
+            "--compress" => compress = true,
+            "--align" => {
+                align = args
+                    .next()
+                    .and_then(|a| a.parse().ok())
+                    .unwrap_or_else(|| usage())
+            }
+            "--prefix" => prefix = Some(args.next().unwrap_or_else(|| usage())),
+            _ => positional.push(arg),
+        }
+    }
+    if positional.len() != 2 {
+        usage();
+    }
+    let (directory, output) = (&positional[0], &positional[1]);
+    let prefix = prefix.unwrap_or_else(|| directory.clone());
+
+    let mut builder = ArchiveBuilder::new().alignment(align);
+    let count = builder
+        .add_directory(&prefix, directory, compress)
+        .and_then(|count| builder.write_file(output).map(|_| count))
+        .unwrap_or_else(|e| {
+            eprintln!("{}: {}", output, e);
+            std::process::exit(1)
+        });
+    let size = std::fs::metadata(output).map_or(0, |m| m.len());
+    println!("{} files packed into {} ({} bytes)", count, output, size);
+}
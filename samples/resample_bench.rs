@@ -0,0 +1,67 @@
+//! Thumbnail generation benchmark.
+//!
+//! Downscales a batch of RGBA8 images to thumbnails with `Image::resize` (stb_image_resize)
+//! and with a `Resampler` of every filter through `Image::resize_with`, and prints the
+//! average time per thumbnail. No window is opened.
+//! `cargo run --release --bin resample_bench [count] [size] [thumbnail size]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let count = arg(1).unwrap_or(64) as usize;
+    let size = arg(2).unwrap_or(1024) as i32;
+    let thumbnail = arg(3).unwrap_or(128) as i32;
+
+    let images: Vec<Image> = (0..count)
+        .map(|i| {
+            let mut image = Image::gen_image_checked(
+                size,
+                size,
+                8 + i as i32 % 16,
+                8 + i as i32 % 16,
+                Color::ORANGE,
+                Color::DARKBLUE,
+            );
+            image.set_format(PixelFormat::PIXELFORMAT_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            image
+        })
+        .collect();
+    println!(
+        "{} images {}x{} to {}x{}",
+        count, size, size, thumbnail, thumbnail
+    );
+
+    let bench = |name: &str, resize: &mut dyn FnMut(&mut Image)| {
+        let mut elapsed = 0.0;
+        for source in images.iter() {
+            let mut image = source.clone();
+            let start = Instant::now();
+            resize(&mut image);
+            elapsed += start.elapsed().as_secs_f64();
+        }
+        println!(
+            "{:<22} {:>8.3} ms/thumbnail",
+            name,
+            elapsed * 1000.0 / count as f64
+        );
+    };
+
+    bench("Image::resize", &mut |image| {
+        image.resize(thumbnail, thumbnail)
+    });
+    for filter in [
+        ResampleFilter::Box,
+        ResampleFilter::Bilinear,
+        ResampleFilter::Bicubic,
+        ResampleFilter::Lanczos3,
+    ]
+    .iter()
+    {
+        let mut resampler = Resampler::new(*filter);
+        bench(&format!("{:?}", filter), &mut |image| {
+            image.resize_with(&mut resampler, thumbnail, thumbnail)
+        });
+    }
+}
@@ -0,0 +1,84 @@
+//! Screen capture benchmark.
+//!
+//! Draws an animated scene and captures it every few frames with `get_screen_data`, which
+//! waits for the GPU, then with `capture_screen_async`, collecting the images once ready a
+//! frame or two later. Prints the average time each capture costs the render thread. Run it
+//! with `cargo run --release --bin screen_capture [frames] [interval]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::collections::VecDeque;
+use std::time::{Duration, Instant};
+
+fn draw_scene(rl: &mut RaylibHandle, thread: &RaylibThread, frame: u32) {
+    let mut d = rl.begin_drawing(thread);
+    d.clear_background(Color::RAYWHITE);
+    for i in 0..2000 {
+        let x = (i * 37 + frame as i32 * 3) % 1280;
+        let y = (i * 91) % 720;
+        d.draw_rectangle(x, y, 24, 24, Color::new(i as u8, (i >> 3) as u8, 160, 255));
+    }
+    d.draw_text(&format!("frame {}", frame), 20, 20, 40, Color::BLACK);
+}
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let frames = arg(1).unwrap_or(600) as u32;
+    let interval = arg(2).unwrap_or(10).max(1) as u32;
+
+    let (mut rl, thread) = raylib::init()
+        .size(1280, 720)
+        .title("Screen capture")
+        .build();
+
+    let report = |name: &str, elapsed: Duration, captures: u32| {
+        println!(
+            "{:<22} {:>8.3} ms/capture ({} captures)",
+            name,
+            elapsed.as_secs_f64() * 1000.0 / captures.max(1) as f64,
+            captures
+        );
+    };
+
+    let (mut elapsed, mut captures) = (Duration::default(), 0);
+    for frame in 0..frames {
+        if rl.window_should_close() {
+            return;
+        }
+        draw_scene(&mut rl, &thread, frame);
+        if frame % interval == 0 {
+            let start = Instant::now();
+            let image = rl.get_screen_data(&thread);
+            elapsed += start.elapsed();
+            captures += (image.width() > 0) as u32;
+        }
+    }
+    report("get_screen_data", elapsed, captures);
+
+    let (mut elapsed, mut captures) = (Duration::default(), 0);
+    let mut pending = VecDeque::new();
+    for frame in 0..frames {
+        if rl.window_should_close() {
+            return;
+        }
+        draw_scene(&mut rl, &thread, frame);
+
+        let start = Instant::now();
+        if frame % interval == 0 {
+            pending.push_back(rl.capture_screen_async(&thread));
+        }
+        while let Some(capture) = pending.pop_front() {
+            match capture.try_into_image() {
+                Ok(image) => captures += image.is_some() as u32,
+                Err(capture) => {
+                    pending.push_front(capture);
+                    break;
+                }
+            }
+        }
+        elapsed += start.elapsed();
+    }
+    for capture in pending {
+        captures += capture.into_image().is_some() as u32;
+    }
+    report("capture_screen_async", elapsed, captures);
+}
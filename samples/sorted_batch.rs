@@ -0,0 +1,81 @@
+//! Sorted render batch benchmark.
+//!
+//! Draws labelled sprites, switching between the sprite texture and the font atlas on every
+//! call, first in submission order and then in sorted mode (labels on an upper layer).
+//! Prints draw calls, GL state calls issued/elided and frame time for both.
+//! `cargo run --release --bin sorted_batch [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::Instant;
+
+const COLUMNS: i32 = 40;
+const ROWS: i32 = 30;
+
+/// Sprite position and label of every grid cell.
+fn cells(frame: u32) -> impl Iterator<Item = (i32, i32, i32)> {
+    (0..ROWS).flat_map(move |y| {
+        (0..COLUMNS).map(move |x| (x * 32, y * 24, (x + y + frame as i32) % 100))
+    })
+}
+
+fn main() {
+    let frames: u32 = std::env::args()
+        .nth(1)
+        .and_then(|f| f.parse().ok())
+        .unwrap_or(120);
+
+    let (mut rl, thread) = raylib::init().size(1280, 720).title("Sorted batch").build();
+
+    let image = Image::gen_image_checked(16, 16, 4, 4, Color::WHITE, Color::GRAY);
+    let sprite = rl
+        .load_texture_from_image(&thread, &image)
+        .expect("could not load sprite texture");
+
+    for sorted in [false, true].iter() {
+        let mut draw_calls = 0;
+        let (mut issued, mut elided) = (0, 0);
+        let start = Instant::now();
+
+        for frame in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            let before = rl.get_draw_calls_count();
+            let state_before = rl.get_state_calls_count();
+            {
+                let mut d = rl.begin_drawing(&thread);
+                d.clear_background(Color::BLACK);
+
+                if *sorted {
+                    let mut s = d.begin_sorted_mode();
+                    for (x, y, n) in cells(frame) {
+                        s.set_draw_layer(0);
+                        s.draw_texture(&sprite, x, y, Color::SKYBLUE);
+                        s.set_draw_layer(1);
+                        s.draw_text(&n.to_string(), x + 2, y + 4, 10, Color::BLACK);
+                    }
+                } else {
+                    for (x, y, n) in cells(frame) {
+                        d.draw_texture(&sprite, x, y, Color::SKYBLUE);
+                        d.draw_text(&n.to_string(), x + 2, y + 4, 10, Color::BLACK);
+                    }
+                }
+            }
+            draw_calls += rl.get_draw_calls_count() - before;
+            let state_after = rl.get_state_calls_count();
+            issued += state_after.0 - state_before.0;
+            elided += state_after.1 - state_before.1;
+        }
+        let elapsed = start.elapsed().as_secs_f64() * 1000.0 / frames as f64;
+
+        println!(
+            "{:<8} {:>6} draw calls/frame {:>6} state calls/frame ({} elided) {:>8.2} ms/frame",
+            if *sorted { "sorted" } else { "unsorted" },
+            draw_calls / frames,
+            issued / frames,
+            elided / frames,
+            elapsed
+        );
+    }
+}
@@ -0,0 +1,75 @@
+//! Sprite batch submission benchmark.
+//!
+//! Submits the same particles every frame with one `draw_texture_pro` call per sprite, with a
+//! single `draw_sprite_batch` call and with a single `draw_sprites_instanced` call, and prints the
+//! CPU time spent submitting them.
+//! `cargo run --release --bin sprite_batch [sprites] [frames]`.
+extern crate raylib;
+use raylib::prelude::*;
+use std::time::{Duration, Instant};
+
+fn main() {
+    let arg = |n: usize| std::env::args().nth(n).and_then(|a| a.parse().ok());
+    let count = arg(1).unwrap_or(100_000) as usize;
+    let frames = arg(2).unwrap_or(120) as u32;
+
+    let (mut rl, thread) = raylib::init().size(1280, 720).title("Sprite batch").build();
+
+    let image = Image::gen_image_checked(32, 32, 8, 8, Color::WHITE, Color::GRAY);
+    let sheet = rl
+        .load_texture_from_image(&thread, &image)
+        .expect("could not load sprite texture");
+
+    let mut sprites: Vec<SpriteInstance> = (0..count)
+        .map(|i| SpriteInstance {
+            dest: Rectangle::new((i * 37 % 1280) as f32, (i * 91 % 720) as f32, 8.0, 8.0),
+            source: Rectangle::new((i % 4 * 8) as f32, (i / 4 % 4 * 8) as f32, 8.0, 8.0),
+            origin: Vector2::new(4.0, 4.0),
+            rotation: (i % 360) as f32,
+            tint: Color::new(i as u8, (i >> 3) as u8, 128, 255),
+        })
+        .collect();
+
+    let methods = [
+        "draw_texture_pro",
+        "draw_sprite_batch",
+        "draw_sprites_instanced",
+    ];
+    for method in methods.iter() {
+        let mut submit = Duration::default();
+
+        for _ in 0..frames {
+            if rl.window_should_close() {
+                return;
+            }
+
+            for s in sprites.iter_mut() {
+                s.rotation += 1.0;
+            }
+
+            let mut d = rl.begin_drawing(&thread);
+            d.clear_background(Color::BLACK);
+
+            let start = Instant::now();
+            match *method {
+                "draw_sprite_batch" => d.draw_sprite_batch(&sheet, &sprites),
+                "draw_sprites_instanced" => d.draw_sprites_instanced(&sheet, &sprites),
+                _ => {
+                    for s in sprites.iter() {
+                        d.draw_texture_pro(&sheet, s.source, s.dest, s.origin, s.rotation, s.tint);
+                    }
+                }
+            }
+            submit += start.elapsed();
+
+            d.draw_fps(10, 10);
+            d.draw_render_stats(10, 40);
+        }
+
+        println!(
+            "{:<22} {:>8.3} ms/frame submission",
+            method,
+            submit.as_secs_f64() * 1000.0 / frames as f64
+        );
+    }
+}